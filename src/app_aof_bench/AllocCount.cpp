@@ -0,0 +1,149 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AllocCount.cpp                                  */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Global heap allocation counter. Every replaceable form   */
+/* of operator new (scalar and array, nothrow, and aligned  */
+/* where the compiler has it) is counted, so the bench can  */
+/* confirm the evalBox() hot path makes no heap allocations */
+/* once the AOF has been initialized. Every form of delete  */
+/* is replaced to match. The operators live in their own    */
+/* translation unit so the deletes are never inlined into a */
+/* caller, where the compiler would see free() paired with  */
+/* operator new.                                            */
+/************************************************************/
+
+#include <cstdlib>
+#include <new>
+#include "AllocCount.h"
+
+namespace {
+
+unsigned long g_alloc_count = 0;
+
+//------------------------------------------------------------
+// Procedure: countedAlloc()
+//   Purpose: malloc() that counts, null on failure
+
+void *countedAlloc(std::size_t size)
+{
+  g_alloc_count++;
+  return(std::malloc(size ? size : 1));
+}
+
+#ifdef __cpp_aligned_new
+void *countedAlignedAlloc(std::size_t size, std::align_val_t al)
+{
+  g_alloc_count++;
+  std::size_t align = (std::size_t)al;
+  if(align < sizeof(void*))
+    align = sizeof(void*);
+  void *ptr = 0;
+  if(posix_memalign(&ptr, align, size ? size : 1) != 0)
+    return(0);
+  return(ptr);
+}
+#endif
+
+}
+
+//------------------------------------------------------------
+// Procedure: benchAllocCount()
+
+unsigned long benchAllocCount()
+{
+  return(g_alloc_count);
+}
+
+//------------------------------------------------------------
+// Operators new and new[]
+
+void *operator new(std::size_t size)
+{
+  void *ptr = countedAlloc(size);
+  if(!ptr)
+    throw std::bad_alloc();
+  return(ptr);
+}
+
+void *operator new[](std::size_t size)
+{
+  void *ptr = countedAlloc(size);
+  if(!ptr)
+    throw std::bad_alloc();
+  return(ptr);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return(countedAlloc(size));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return(countedAlloc(size));
+}
+
+//------------------------------------------------------------
+// Operators delete and delete[]
+
+void operator delete(void *ptr) noexcept                 { std::free(ptr); }
+void operator delete[](void *ptr) noexcept               { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept    { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept  { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t&) noexcept
+{ std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept
+{ std::free(ptr); }
+
+#ifdef __cpp_aligned_new
+
+//------------------------------------------------------------
+// Aligned forms (C++17)
+
+void *operator new(std::size_t size, std::align_val_t al)
+{
+  void *ptr = countedAlignedAlloc(size, al);
+  if(!ptr)
+    throw std::bad_alloc();
+  return(ptr);
+}
+
+void *operator new[](std::size_t size, std::align_val_t al)
+{
+  void *ptr = countedAlignedAlloc(size, al);
+  if(!ptr)
+    throw std::bad_alloc();
+  return(ptr);
+}
+
+void *operator new(std::size_t size, std::align_val_t al,
+                   const std::nothrow_t&) noexcept
+{
+  return(countedAlignedAlloc(size, al));
+}
+
+void *operator new[](std::size_t size, std::align_val_t al,
+                     const std::nothrow_t&) noexcept
+{
+  return(countedAlignedAlloc(size, al));
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{ std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{ std::free(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept
+{ std::free(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept
+{ std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t,
+                     const std::nothrow_t&) noexcept
+{ std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t,
+                       const std::nothrow_t&) noexcept
+{ std::free(ptr); }
+
+#endif
@@ -0,0 +1,15 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AllocCount.h                                    */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef ALLOC_COUNT_HEADER
+#define ALLOC_COUNT_HEADER
+
+// Heap allocations made through any form of the global operator
+// new since the program started (see AllocCount.cpp)
+unsigned long benchAllocCount();
+
+#endif
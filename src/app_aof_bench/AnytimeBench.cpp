@@ -0,0 +1,92 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AnytimeBench.cpp                                */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Evaluates the whole domain through evalBox() at each     */
+/* fidelity level of the behavior's anytime build (see      */
+/* TowFidelity.h) and reports the time taken and the        */
+/* utility error against the full level (max, mean, and     */
+/* candidates whose contact prediction differs). Then       */
+/* repeats the full level with deadlines at fractions of    */
+/* its time and reports whether the deadline tripped and by */
+/* how much the sweep overran it.                           */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include "TowFidelity.h"
+#include "BenchScenario.h"
+#include "AnytimeBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: runAnytimeBench()
+
+int runAnytimeBench(const AOF_TowObstacleAvoid& base,
+                    const IvPDomain& domain, double sim_dt,
+                    double sim_hz, double turn_rate, bool cable_dyn,
+                    TowIntegrator integ, double k_spring, double c_tan)
+{
+  unsigned int n = domain.getVarPoints(domain.getIndex("course")) *
+    domain.getVarPoints(domain.getIndex("speed"));
+
+  double contact_util = benchContactUtil(base);
+
+  cout << "Anytime bench: " << n << " candidates" << endl;
+  cout << "level   dt     horizon  cable    ms       max_du   mean_du"
+       << "  contact_diff" << endl;
+
+  vector<double> utils[3];
+  double level_ms[3];
+  for(int i = TOW_FID_FULL; i >= TOW_FID_COARSE; i--) {
+    TowFidelity level = (TowFidelity)i;
+    TowFidelityParams fp = towFidelityParams(level, sim_dt, sim_hz,
+                                             cable_dyn, integ, k_spring,
+                                             c_tan);
+    AOF_TowObstacleAvoid aof = base;
+    aof.setSimParams(fp.sim_dt, fp.horizon, turn_rate);
+    aof.setUseCableDynamics(fp.cable_dynamics);
+    level_ms[i] = benchSweep(aof, domain, 1, true, utils[i]);
+
+    double max_du = 0, sum_du = 0;
+    unsigned int contact_diff = 0;
+    for(unsigned int j = 0; j < n; j++) {
+      double du = fabs(utils[i][j] - utils[TOW_FID_FULL][j]);
+      max_du = max(max_du, du);
+      sum_du += du;
+      if((utils[i][j] <= contact_util) !=
+         (utils[TOW_FID_FULL][j] <= contact_util))
+        contact_diff++;
+    }
+
+    string name = towFidelityName(level);
+    name.resize(7, ' ');
+    cout << name << " " << fp.sim_dt << "\t" << fp.horizon << "\t "
+         << (fp.cable_dynamics ? "full   " : "relaxed") << "  "
+         << level_ms[i] << "\t" << max_du << "\t" << sum_du / n << "\t "
+         << contact_diff << endl;
+  }
+
+  cout << "deadline_frac  deadline_ms  expired  overrun_ms" << endl;
+  double fracs[3] = {0.25, 0.5, 2.0};
+  for(unsigned int k = 0; k < 3; k++) {
+    AOF_TowObstacleAvoid aof = base;
+    aof.setSimParams(sim_dt, sim_hz, turn_rate);
+    aof.setUseCableDynamics(cable_dyn);
+    double deadline_ms = fracs[k] * level_ms[TOW_FID_FULL];
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    aof.setDeadline(t0 + chrono::duration_cast<chrono::steady_clock::duration>(
+                      chrono::duration<double, milli>(deadline_ms)));
+    vector<double> tmp;
+    double ms = benchSweep(aof, domain, 1, true, tmp);
+    cout << fracs[k] << "\t       " << deadline_ms << "\t    "
+         << (aof.deadlineExpired() ? "yes" : "no ") << "\t     "
+         << max(0.0, ms - deadline_ms) << endl;
+  }
+  return(0);
+}
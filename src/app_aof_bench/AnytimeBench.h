@@ -0,0 +1,21 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AnytimeBench.h                                  */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef ANYTIME_BENCH_HEADER
+#define ANYTIME_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Cost and utility error of each anytime fidelity level, and the
+// overrun of a build cut off by a deadline
+int runAnytimeBench(const AOF_TowObstacleAvoid& base,
+                    const IvPDomain& domain, double sim_dt,
+                    double sim_hz, double turn_rate, bool cable_dyn,
+                    TowIntegrator integ, double k_spring, double c_tan);
+
+#endif
@@ -0,0 +1,83 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: BenchScenario.cpp                               */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <chrono>
+#include "IvPBox.h"
+#include "BenchScenario.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: benchBox()
+
+XYPolygon benchBox(double x, double y, double w, double h)
+{
+  XYPolygon poly;
+  poly.add_vertex(x,     y);
+  poly.add_vertex(x + w, y);
+  poly.add_vertex(x + w, y + h);
+  poly.add_vertex(x,     y + h);
+  return(poly);
+}
+
+//------------------------------------------------------------
+// Procedure: benchField()
+
+vector<XYPolygon> benchField()
+{
+  vector<XYPolygon> field;
+  field.push_back(benchBox(20, 15, 5, 5));
+  field.push_back(benchBox(5, 30, 5, 5));
+  field.push_back(benchBox(35, 5, 5, 5));
+  field.push_back(benchBox(-15, 20, 5, 5));
+  field.push_back(benchBox(25, 40, 5, 5));
+  return(field);
+}
+
+//------------------------------------------------------------
+// Procedure: benchContactUtil()
+//   Purpose: With contact predicted, utility is at most the ttc
+//            ceiling (40% of the range), otherwise it is above it
+//            (see utilityFromSim()).
+
+double benchContactUtil(const AOF_TowObstacleAvoid& aof)
+{
+  double umin = aof.getKnownMin();
+  double umax = aof.getKnownMax();
+  return(umin + 0.40 * (umax - umin));
+}
+
+//------------------------------------------------------------
+// Procedure: benchSweep()
+
+double benchSweep(AOF_TowObstacleAvoid& aof, const IvPDomain& domain,
+                  unsigned int reps, bool init, vector<double>& utils)
+{
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_crs = domain.getVarPoints(crs_ix);
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+  if(reps == 0)
+    reps = 1;
+
+  utils.assign(num_crs * num_spd, 0);
+  IvPBox box(2);
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for(unsigned int r = 0; r < reps; r++) {
+    if(init)
+      aof.initialize();
+    for(unsigned int ci = 0; ci < num_crs; ci++) {
+      for(unsigned int si = 0; si < num_spd; si++) {
+        box.setPTS(crs_ix, ci, ci);
+        box.setPTS(spd_ix, si, si);
+        utils[ci*num_spd + si] = aof.evalBox(&box);
+      }
+    }
+  }
+  chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+  return(ms.count() / reps);
+}
@@ -0,0 +1,46 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: BenchScenario.h                                 */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Scenario pieces shared by the aof_bench modes: the tow   */
+/* state set up in main.cpp, box obstacles, the field used  */
+/* by the multi-obstacle modes, the contact threshold on    */
+/* utilities, and the sweep of the whole domain through     */
+/* evalBox() that most modes time.                          */
+/************************************************************/
+
+#ifndef BENCH_SCENARIO_HEADER
+#define BENCH_SCENARIO_HEADER
+
+#include <vector>
+#include "IvPDomain.h"
+#include "XYPolygon.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Tow body astern of ownship (at the origin heading 045), drifting
+// slowly north-east
+const double BENCH_TOW_X  = -25;
+const double BENCH_TOW_Y  = -10;
+const double BENCH_TOW_VX = 0.5;
+const double BENCH_TOW_VY = 0.3;
+
+// A w x h box with its lower left corner at (x, y)
+XYPolygon benchBox(double x, double y, double w, double h);
+
+// Five 5 m boxes spread ahead of ownship
+std::vector<XYPolygon> benchField();
+
+// Utility at or below which a candidate counts as in contact
+double benchContactUtil(const AOF_TowObstacleAvoid& aof);
+
+// Evaluate every domain point with evalBox(), reps times (at
+// least once), calling initialize() before each pass if init.
+// Utilities of the last pass go in utils, course-major. Returns
+// the mean wall time per pass in ms.
+double benchSweep(AOF_TowObstacleAvoid& aof, const IvPDomain& domain,
+                  unsigned int reps, bool init,
+                  std::vector<double>& utils);
+
+#endif
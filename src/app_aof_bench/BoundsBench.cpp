@@ -0,0 +1,145 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: BoundsBench.cpp                                 */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* For the bench's tow state, the same without the tow      */
+/* speed penalty, and a tow trailing taut astern at speed,  */
+/* finds the flat regions of the domain by interval         */
+/* evaluation (AOF_TowObstacleAvoid::findFlatBoxes()) at    */
+/* several minimum box sizes, and reports the boxes found,  */
+/* the fraction of the domain they cover, their cost        */
+/* against a full evalBox() sweep, and the piece count of   */
+/* the default 3x3 uniform pieces with each flat box as one */
+/* piece. Every candidate in a flat box, and every 3x3 tile */
+/* through evalBoxBounds(), is checked against the sweep.   */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include "IvPBox.h"
+#include "BenchScenario.h"
+#include "BoundsBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: boundsBenchCase()
+//   Purpose: Report one tow state at each minimum box size.
+
+static void boundsBenchCase(const string& label, AOF_TowObstacleAvoid aof,
+                            const IvPDomain& domain, unsigned int reps)
+{
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_crs = domain.getVarPoints(crs_ix);
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+  if(reps == 0)
+    reps = 1;
+
+  vector<double> utils;
+  double full_ms = benchSweep(aof, domain, reps, true, utils);
+  double umin = aof.getKnownMin();
+  double umax = aof.getKnownMax();
+
+  // Every 3x3 tile's bounds must hold its utilities
+  unsigned int tile_viol = 0;
+  IvPBox tile(2);
+  for(unsigned int c0 = 0; c0 < num_crs; c0 += 3) {
+    for(unsigned int s0 = 0; s0 < num_spd; s0 += 3) {
+      unsigned int c1 = min(c0 + 2, num_crs - 1);
+      unsigned int s1 = min(s0 + 2, num_spd - 1);
+      tile.setPTS(crs_ix, c0, c1);
+      tile.setPTS(spd_ix, s0, s1);
+      double lo = 0, hi = 0;
+      aof.evalBoxBounds(&tile, lo, hi);
+      for(unsigned int ci = c0; ci <= c1; ci++)
+        for(unsigned int si = s0; si <= s1; si++) {
+          double u = utils[ci*num_spd + si];
+          if((u < lo) || (u > hi))
+            tile_viol++;
+        }
+    }
+  }
+  unsigned int tiles = ((num_crs + 2) / 3) * ((num_spd + 2) / 3);
+
+  unsigned int min_boxes[3] = {3, 9, 15};
+  for(unsigned int m = 0; m < 3; m++) {
+    vector<IvPBox> plateaus, basins;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for(unsigned int r = 0; r < reps; r++) {
+      plateaus.clear();
+      basins.clear();
+      aof.initialize();
+      aof.findFlatBoxes(min_boxes[m], 3, plateaus, basins);
+    }
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+    double bound_ms = ms.count() / reps;
+
+    // Coverage, soundness, and 3x3 tiles left to sample
+    vector<bool> flat(num_crs * num_spd, false);
+    unsigned int covered = 0, viol = 0;
+    for(unsigned int i = 0; i < plateaus.size() + basins.size(); i++) {
+      bool is_plat = (i < plateaus.size());
+      const IvPBox& b = is_plat ? plateaus[i] : basins[i - plateaus.size()];
+      for(int ci = b.pt(crs_ix, 0); ci <= b.pt(crs_ix, 1); ci++)
+        for(int si = b.pt(spd_ix, 0); si <= b.pt(spd_ix, 1); si++) {
+          double u = utils[ci*num_spd + si];
+          if(u != (is_plat ? umax : umin))
+            viol++;
+          flat[ci*num_spd + si] = true;
+          covered++;
+        }
+    }
+    unsigned int pieces = plateaus.size() + basins.size();
+    for(unsigned int c0 = 0; c0 < num_crs; c0 += 3)
+      for(unsigned int s0 = 0; s0 < num_spd; s0 += 3) {
+        bool all_flat = true;
+        for(unsigned int ci = c0; ci < min(c0 + 3, num_crs); ci++)
+          for(unsigned int si = s0; si < min(s0 + 3, num_spd); si++)
+            all_flat = all_flat && flat[ci*num_spd + si];
+        if(!all_flat)
+          pieces++;
+      }
+
+    cout << label << "\t" << min_boxes[m] << "x3\t" << plateaus.size()
+         << "/" << basins.size() << "\t" << aof.getBoundBoxes() << "\t"
+         << (double)covered / (num_crs * num_spd) << "\t  " << bound_ms
+         << "\t  " << full_ms << "\t  " << tiles << " -> " << pieces
+         << "\t" << viol << "\t" << tile_viol << endl;
+  }
+}
+
+//------------------------------------------------------------
+// Procedure: runBoundsBench()
+
+int runBoundsBench(const AOF_TowObstacleAvoid& base,
+                   const ObShipModelV24& obm, const IvPDomain& domain,
+                   double cable_len, double attach_offset,
+                   unsigned int reps)
+{
+  cout << "Bounds bench: flat boxes found down to min course x speed"
+       << " points" << endl;
+  cout << "state\t\tmin\tplat/bas\tbounded\tcovered\t  bound_ms"
+       << "\t  full_ms\t  pieces\tviol\ttile_viol" << endl;
+
+  boundsBenchCase("bench\t", base, domain, reps);
+
+  AOF_TowObstacleAvoid no_pen = base;
+  no_pen.setTowSpeedPenalty(false);
+  boundsBenchCase("no_penalty", no_pen, domain, reps);
+
+  // Trailing taut astern at 2 m/s
+  double hdg_rad = (90.0 - obm.getOSH()) * M_PI / 180.0;
+  double hc = cos(hdg_rad);
+  double hs = sin(hdg_rad);
+  double back = attach_offset + cable_len;
+  AOF_TowObstacleAvoid taut = base;
+  taut.setTowState(obm.getOSX() - back * hc, obm.getOSY() - back * hs,
+                   2 * hc, 2 * hs);
+  boundsBenchCase("taut_2mps", taut, domain, reps);
+  return(0);
+}
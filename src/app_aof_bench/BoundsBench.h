@@ -0,0 +1,23 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: BoundsBench.h                                   */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef BOUNDS_BENCH_HEADER
+#define BOUNDS_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+#include "ObShipModelV24.h"
+
+// Flat regions found by interval evaluation: domain covered, time
+// against a full sweep, estimated piece count, and a check of every
+// bound against the evaluated utilities
+int runBoundsBench(const AOF_TowObstacleAvoid& base,
+                   const ObShipModelV24& obm, const IvPDomain& domain,
+                   double cable_len, double attach_offset,
+                   unsigned int reps);
+
+#endif
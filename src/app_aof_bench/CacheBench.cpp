@@ -0,0 +1,99 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: CacheBench.cpp                                  */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Replays helm iterations at 4 Hz with ownship and the tow */
+/* moving along ownship's heading at 1.5 m/s. Each          */
+/* iteration builds a fresh AOF, as the behavior's buildOF()*/
+/* does, and evaluates the whole domain through evalBox()   */
+/* once without the cache and once with it, for several     */
+/* position tolerances. Reports the hit rate, the time the  */
+/* cache reports saved, the measured wall time against the */
+/* uncached run, and the utility error against it (max,     */
+/* mean).                                                   */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+#include "BenchScenario.h"
+#include "CacheBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: runCacheBench()
+
+int runCacheBench(const AOF_TowObstacleAvoid& base,
+                  const ObShipModelV24& obm, const IvPDomain& domain,
+                  int iters)
+{
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_crs = domain.getVarPoints(crs_ix);
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+  unsigned int n = num_crs * num_spd;
+  if(iters < 1)
+    iters = 1;
+
+  const double helm_dt = 0.25;
+  const double speed   = 1.5;
+  double hdg_rad = (90.0 - obm.getOSH()) * M_PI / 180.0;
+  double step_x  = speed * helm_dt * cos(hdg_rad);
+  double step_y  = speed * helm_dt * sin(hdg_rad);
+
+  cout << "Cache bench: " << iters << " helm iterations at "
+       << 1 / helm_dt << " Hz, " << speed << " m/s, " << n
+       << " candidates" << endl;
+  cout << "pos_tol  hit_rate  resets  saved_ms  wall_ms  uncached_ms"
+       << "  max_du    mean_du" << endl;
+
+  double pos_tols[5] = {0, 0.1, 0.25, 0.5, 1.0};
+  for(unsigned int ti = 0; ti < 5; ti++) {
+    TowEvalCache cache;
+    cache.setTolerances(pos_tols[ti], -1, -1);
+
+    double wall = 0, wall_ref = 0, max_du = 0, sum_du = 0;
+    for(int it = 0; it < iters; it++) {
+      ObShipModelV24 model = obm;
+      model.setPose(obm.getOSX() + it * step_x, obm.getOSY() + it * step_y,
+                    obm.getOSH());
+      model.setCachedVals(true);
+
+      AOF_TowObstacleAvoid aof = base;
+      aof.setObShipModel(model);
+      aof.setTowState(BENCH_TOW_X + it * step_x, BENCH_TOW_Y + it * step_y,
+                      BENCH_TOW_VX, BENCH_TOW_VY);
+
+      TowEvalState state;
+      state.osx = model.getOSX();
+      state.osy = model.getOSY();
+      state.osh = model.getOSH();
+      state.tow_x  = BENCH_TOW_X + it * step_x;
+      state.tow_y  = BENCH_TOW_Y + it * step_y;
+      state.tow_vx = BENCH_TOW_VX;
+      state.tow_vy = BENCH_TOW_VY;
+      cache.beginBuild(state, num_crs, num_spd);
+
+      vector<double> utils_ref, utils;
+      AOF_TowObstacleAvoid aof_ref = aof;
+      wall_ref += benchSweep(aof_ref, domain, 1, true, utils_ref);
+      aof.setEvalCache(&cache);
+      wall += benchSweep(aof, domain, 1, true, utils);
+      for(unsigned int j = 0; j < n; j++) {
+        double du = fabs(utils[j] - utils_ref[j]);
+        max_du = max(max_du, du);
+        sum_du += du;
+      }
+    }
+
+    cout << pos_tols[ti] << "\t " << cache.hitRate() << "\t   "
+         << cache.resets() << "\t   " << cache.savedMS() << "\t    "
+         << wall << "\t     " << wall_ref << "\t  "
+         << max_du << "\t" << sum_du / (n * iters) << endl;
+  }
+  return(0);
+}
@@ -0,0 +1,21 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: CacheBench.h                                    */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef CACHE_BENCH_HEADER
+#define CACHE_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "ObShipModelV24.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Hit rate, time saved and utility error of the cross-iteration
+// eval cache over a run of simulated helm iterations
+int runCacheBench(const AOF_TowObstacleAvoid& base,
+                  const ObShipModelV24& obm, const IvPDomain& domain,
+                  int iters);
+
+#endif
@@ -0,0 +1,82 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: CascadeBench.cpp                                */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Evaluates the whole domain through evalBox() with full   */
+/* cable dynamics, then with relaxed-cable screening (see   */
+/* AOF_TowObstacleAvoid::evalCascade()) at several bands,   */
+/* and reports for each band the fraction of candidates     */
+/* escalated to full dynamics, the time against the full    */
+/* sweep, and the utility error (max, mean, and candidates  */
+/* whose contact prediction differs).                       */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "BenchScenario.h"
+#include "CascadeBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: runCascadeBench()
+
+int runCascadeBench(const AOF_TowObstacleAvoid& base,
+                    const IvPDomain& domain, unsigned int reps)
+{
+  unsigned int n = domain.getVarPoints(domain.getIndex("course")) *
+    domain.getVarPoints(domain.getIndex("speed"));
+
+  double contact_util = benchContactUtil(base);
+
+  AOF_TowObstacleAvoid full = base;
+  full.setCascade(false);
+  vector<double> ref;
+  double full_ms = benchSweep(full, domain, reps, true, ref);
+
+  cout << "Cascade bench: " << n << " candidates, full dynamics "
+       << full_ms << " ms" << endl;
+
+  AOF_TowObstacleAvoid probe = base;
+  probe.setCascade(true, 0);
+  probe.initialize();
+  if(!probe.usingCascade()) {
+    cout << "Cascade unavailable for this configuration (needs fixed-step"
+         << " double sim with cable dynamics)" << endl;
+    return(0);
+  }
+
+  cout << "Measured relaxed vs full cable gap: "
+       << probe.getCascadeBand() << " m (plus band_m)" << endl;
+  cout << "band_m  escalated  ms       speedup  max_du   mean_du"
+       << "  contact_diff" << endl;
+
+  double bands[5] = {0, 0.5, 1.0, 2.0, 5.0};
+  for(unsigned int b = 0; b < 5; b++) {
+    AOF_TowObstacleAvoid aof = base;
+    aof.setCascade(true, bands[b]);
+    vector<double> utils;
+    double ms = benchSweep(aof, domain, reps, true, utils);
+
+    double max_du = 0, sum_du = 0;
+    unsigned int contact_diff = 0;
+    for(unsigned int j = 0; j < n; j++) {
+      double du = fabs(utils[j] - ref[j]);
+      max_du = max(max_du, du);
+      sum_du += du;
+      if((utils[j] <= contact_util) != (ref[j] <= contact_util))
+        contact_diff++;
+    }
+
+    double frac = 0;
+    if(aof.getCascadeScreened() > 0)
+      frac = (double)aof.getCascadeEscalated() / aof.getCascadeScreened();
+    cout << bands[b] << "\t" << frac << "\t   " << ms << "\t"
+         << full_ms / ms << "\t " << max_du << "\t" << sum_du / n
+         << "\t " << contact_diff << endl;
+  }
+  return(0);
+}
@@ -0,0 +1,19 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: CascadeBench.h                                  */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef CASCADE_BENCH_HEADER
+#define CASCADE_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Fraction escalated, speedup and utility error of relaxed-cable
+// screening against full cable dynamics, over a range of bands
+int runCascadeBench(const AOF_TowObstacleAvoid& base,
+                    const IvPDomain& domain, unsigned int reps);
+
+#endif
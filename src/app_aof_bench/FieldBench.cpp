@@ -0,0 +1,123 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: FieldBench.cpp                                  */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Grows a field from the bench obstacle to six boxes near  */
+/* the tracks ownship can reach, and for each size sweeps   */
+/* the domain once with a joint AOF (the bench obstacle in  */
+/* the obship model, the rest through addObstacle()) and    */
+/* once with an AOF per obstacle, taking the least of their */
+/* utilities per candidate as a field of spawned behaviors  */
+/* would. Reports both sweep times and how the utilities    */
+/* differ: the joint sim checks the whole cable whenever    */
+/* any obstacle is within 5 m, so it can only come out the  */
+/* lower of the two.                                        */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include "IvPBox.h"
+#include "BenchScenario.h"
+#include "FieldBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: fieldBenchSweep()
+//   Purpose: Evaluate every domain point with each AOF, reps
+//            times, keeping the least utility per point. Returns
+//            the mean wall time per sweep in ms.
+
+static double fieldBenchSweep(vector<AOF_TowObstacleAvoid>& aofs,
+                              const IvPDomain& domain, unsigned int reps,
+                              vector<double>& utils)
+{
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_crs = domain.getVarPoints(crs_ix);
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+  if(reps == 0)
+    reps = 1;
+
+  utils.assign(num_crs * num_spd, 1e9);
+  IvPBox box(2);
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for(unsigned int r = 0; r < reps; r++) {
+    for(unsigned int a = 0; a < aofs.size(); a++) {
+      aofs[a].initialize();
+      for(unsigned int ci = 0; ci < num_crs; ci++) {
+        for(unsigned int si = 0; si < num_spd; si++) {
+          box.setPTS(crs_ix, ci, ci);
+          box.setPTS(spd_ix, si, si);
+          double u = aofs[a].evalBox(&box);
+          double& best = utils[ci*num_spd + si];
+          best = min(best, u);
+        }
+      }
+    }
+  }
+  chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+  return(ms.count() / reps);
+}
+
+//------------------------------------------------------------
+// Procedure: runFieldBench()
+
+int runFieldBench(const AOF_TowObstacleAvoid& base,
+                  const ObShipModelV24& obm, const IvPDomain& domain,
+                  unsigned int reps)
+{
+  vector<XYPolygon> field;
+  field.push_back(obm.getGutPoly());
+  field.push_back(benchBox(30, 10, 6, 6));
+  field.push_back(benchBox(10, 35, 5, 5));
+  field.push_back(benchBox(60, 20, 8, 4));
+  field.push_back(benchBox(-20, 40, 6, 6));
+  field.push_back(benchBox(40, 70, 5, 8));
+
+  cout << "Field bench: one joint sim vs one sim per obstacle" << endl;
+  cout << "obstacles\tjoint_ms\tper_ob_ms\tspeedup\tdiffer"
+       << "\tjoint_lower\tmax_du" << endl;
+
+  unsigned int sizes[4] = {1, 2, 4, 6};
+  for(unsigned int s = 0; s < 4; s++) {
+    unsigned int n = sizes[s];
+
+    vector<AOF_TowObstacleAvoid> joint(1, base);
+    for(unsigned int i = 1; i < n; i++)
+      joint[0].addObstacle(field[i], shared_ptr<const PolySDFGrid>());
+
+    vector<AOF_TowObstacleAvoid> per_ob;
+    for(unsigned int i = 0; i < n; i++) {
+      ObShipModelV24 obm_i = obm;
+      obm_i.setGutPoly(field[i]);
+      obm_i.setCachedVals(true);
+      per_ob.push_back(base);
+      per_ob.back().setObShipModel(obm_i);
+    }
+
+    vector<double> u_joint, u_per;
+    double joint_ms = fieldBenchSweep(joint, domain, reps, u_joint);
+    double per_ms   = fieldBenchSweep(per_ob, domain, reps, u_per);
+
+    unsigned int differ = 0, lower = 0;
+    double max_du = 0;
+    for(unsigned int k = 0; k < u_joint.size(); k++) {
+      double du = u_joint[k] - u_per[k];
+      if(du != 0)
+        differ++;
+      if(du < 0)
+        lower++;
+      max_du = max(max_du, fabs(du));
+    }
+
+    cout << n << "\t\t" << joint_ms << "\t\t" << per_ms << "\t\t"
+         << per_ms / max(joint_ms, 1e-9) << "\t" << differ << "\t"
+         << lower << "\t\t" << max_du << endl;
+  }
+  return(0);
+}
@@ -0,0 +1,22 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: FieldBench.h                                    */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef FIELD_BENCH_HEADER
+#define FIELD_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+#include "ObShipModelV24.h"
+
+// One forward sim against a field of obstacles (addObstacle())
+// against one AOF per obstacle combined by the least utility:
+// sweep time and utility differences for growing fields
+int runFieldBench(const AOF_TowObstacleAvoid& base,
+                  const ObShipModelV24& obm, const IvPDomain& domain,
+                  unsigned int reps);
+
+#endif
@@ -0,0 +1,97 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: IntegratorBench.cpp                             */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Evaluates the whole domain with RK4 at a fine time step  */
+/* as the reference, then with each integrator (euler,      */
+/* semi_implicit, rk2, rk4) at time steps from 0.1 to 1 s.  */
+/* For each it reports evals/sec and the utility error      */
+/* against the reference (max, mean, and the number of      */
+/* candidates whose contact prediction differs).            */
+/*                                                          */
+/* Every step is checked (check interval 1) so the error    */
+/* reflects the integration, not the check spacing. As in   */
+/* the step bench the tow speed penalty and reach pruning   */
+/* are off and candidates go through evalBox().             */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "BenchScenario.h"
+#include "IntegratorBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: integratorBenchEval()
+//   Purpose: Evaluate every domain point with a copy of base.
+//            Returns the wall time.
+
+static double integratorBenchEval(const AOF_TowObstacleAvoid& base,
+                                  const IvPDomain& domain,
+                                  TowIntegrator method, double dt,
+                                  double sim_hz, double turn_rate,
+                                  vector<double>& utils)
+{
+  AOF_TowObstacleAvoid aof = base;
+  aof.setIntegrator(method);
+  aof.setSimParams(dt, sim_hz, turn_rate);
+  aof.setTowSpeedPenalty(false);
+  aof.setReachPrune(false);
+  aof.setAdaptiveStep(0);
+  aof.setCableCheckInterval(1);
+  aof.initialize();
+  return(benchSweep(aof, domain, 1, false, utils) / 1000);
+}
+
+//------------------------------------------------------------
+// Procedure: runIntegratorBench()
+
+int runIntegratorBench(const AOF_TowObstacleAvoid& base,
+                       const IvPDomain& domain, double sim_hz,
+                       double turn_rate, double ref_dt)
+{
+  unsigned int n = domain.getVarPoints(domain.getIndex("course")) *
+    domain.getVarPoints(domain.getIndex("speed"));
+
+  double contact_util = benchContactUtil(base);
+
+  vector<double> ref_utils;
+  double ref_time = integratorBenchEval(base, domain, TOW_INT_RK4, ref_dt,
+                                        sim_hz, turn_rate, ref_utils);
+
+  cout << "Integrator bench: " << n << " candidates, reference rk4 dt "
+       << ref_dt << " s, " << ref_time * 1000 << " ms" << endl;
+  cout << "method         dt     evals/sec  max_err  mean_err  contact_diff"
+       << endl;
+
+  TowIntegrator methods[4] = {TOW_INT_EULER, TOW_INT_SEMI_IMPLICIT,
+                              TOW_INT_RK2, TOW_INT_RK4};
+  double steps[4] = {0.1, 0.25, 0.5, 1.0};
+
+  for(unsigned int mi = 0; mi < 4; mi++) {
+    for(unsigned int di = 0; di < 4; di++) {
+      vector<double> utils;
+      double t = integratorBenchEval(base, domain, methods[mi], steps[di],
+                                     sim_hz, turn_rate, utils);
+      double max_err = 0, sum_err = 0;
+      unsigned int contact_diff = 0;
+      for(unsigned int j = 0; j < n; j++) {
+        double err = fabs(utils[j] - ref_utils[j]);
+        max_err = max(max_err, err);
+        sum_err += err;
+        if((utils[j] <= contact_util) != (ref_utils[j] <= contact_util))
+          contact_diff++;
+      }
+      string name = towIntegratorName(methods[mi]);
+      name.resize(14, ' ');
+      cout << name << " " << steps[di] << "\t" << (t > 0 ? n / t : 0)
+           << "\t" << max_err << "\t " << sum_err / n << "\t  "
+           << contact_diff << endl;
+    }
+  }
+  return(0);
+}
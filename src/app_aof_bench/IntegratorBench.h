@@ -0,0 +1,20 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: IntegratorBench.h                               */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef INTEGRATOR_BENCH_HEADER
+#define INTEGRATOR_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Evals/sec and utility error of each tow/cable integrator over a
+// range of time steps, against a fine-step RK4 reference
+int runIntegratorBench(const AOF_TowObstacleAvoid& base,
+                       const IvPDomain& domain, double sim_hz,
+                       double turn_rate, double ref_dt);
+
+#endif
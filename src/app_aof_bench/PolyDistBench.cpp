@@ -0,0 +1,267 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PolyDistBench.cpp                               */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Times point-to-polygon distance queries through          */
+/* XYPolygon::dist_to_poly() and through the prepared       */
+/* ConvexPolyDist kernel (one point at a time and batched), */
+/* and checks that all three agree. With a grid cell size   */
+/* it also times PolySDFGrid lookups and compares their     */
+/* worst observed error with the documented bound.          */
+/*                                                          */
+/* Segment distances from ConvexPolyDist::segDist() are     */
+/* checked against dense sampling (1 cm) along each         */
+/* segment: never above it, and below it by no more than    */
+/* half the sample spacing. The 1 m sampling the cable      */
+/* range checks used before is timed alongside, with its    */
+/* worst overestimate. A concave polygon covers the         */
+/* dist_to_poly() fallback.                                 */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "XYPolygon.h"
+#include "ConvexPolyDist.h"
+#include "PolySDFGrid.h"
+#include "MBTimer.h"
+#include "PolyDistBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: sampledSegDist()
+//   Purpose: Minimum distance over samples at most step apart
+//            along a segment, end points included.
+
+static double sampledSegDist(const ConvexPolyDist& pdist,
+                             double x0, double y0, double x1, double y1,
+                             double step)
+{
+  double len = hypot(x1 - x0, y1 - y0);
+  unsigned int samples = (unsigned int)ceil(len / step);
+  if(samples < 1)
+    samples = 1;
+  double d = 1e300;
+  for(unsigned int s = 0; s <= samples; s++) {
+    double t = (double)s / (double)samples;
+    d = min(d, pdist.exactDist(x0 + t * (x1 - x0), y0 + t * (y1 - y0)));
+  }
+  return(d);
+}
+
+//------------------------------------------------------------
+// Procedure: checkSegDist()
+//   Purpose: segDist() against dense sampling over segments
+//            between consecutive query points, shortened to cable
+//            length (at most 60 m). Prints one line, returns the
+//            number of segments outside the sampling bound.
+
+static unsigned int checkSegDist(const XYPolygon& poly,
+                                 const vector<double>& px,
+                                 const vector<double>& py,
+                                 unsigned int num_segs)
+{
+  ConvexPolyDist pdist(poly);
+
+  vector<double> x0(num_segs), y0(num_segs), x1(num_segs), y1(num_segs);
+  for(unsigned int i = 0; i < num_segs; i++) {
+    x0[i] = px[i];
+    y0[i] = py[i];
+    double dx = px[i+1] - px[i];
+    double dy = py[i+1] - py[i];
+    double len = hypot(dx, dy);
+    double sc = (len > 60) ? 60 / len : 1;
+    x1[i] = px[i] + sc * dx;
+    y1[i] = py[i] + sc * dy;
+  }
+
+  const double fine = 0.01;
+  unsigned int bad = 0;
+  unsigned int touching = 0;
+  double max_below = 0;
+  double max_miss  = 0;
+  double sink = 0;
+  for(unsigned int i = 0; i < num_segs; i++) {
+    double d     = pdist.segDist(x0[i], y0[i], x1[i], y1[i]);
+    double dense = sampledSegDist(pdist, x0[i], y0[i], x1[i], y1[i], fine);
+    double metre = sampledSegDist(pdist, x0[i], y0[i], x1[i], y1[i], 1.0);
+    if((d > dense + 1e-9) || (dense - d > fine / 2 + 1e-9))
+      bad++;
+    if(d == 0)
+      touching++;
+    max_below = max(max_below, dense - d);
+    max_miss  = max(max_miss, metre - d);
+  }
+
+  MBTimer t_seg;
+  t_seg.start();
+  for(unsigned int i = 0; i < num_segs; i++)
+    sink += pdist.segDist(x0[i], y0[i], x1[i], y1[i]);
+  t_seg.stop();
+
+  MBTimer t_metre;
+  t_metre.start();
+  for(unsigned int i = 0; i < num_segs; i++)
+    sink += sampledSegDist(pdist, x0[i], y0[i], x1[i], y1[i], 1.0);
+  t_metre.stop();
+
+  double ns_seg   = t_seg.get_float_wall_time() / num_segs * 1e9;
+  double ns_metre = t_metre.get_float_wall_time() / num_segs * 1e9;
+  cout << "   seg: " << num_segs << " segs (" << touching << " touching), "
+       << ns_seg << " ns exact vs " << ns_metre << " ns 1 m sampled, "
+       << "1 m miss up to " << max_miss << " m, dense-exact "
+       << max_below << " m, " << bad << " outside bound"
+       << ((sink < 0) ? " " : "") << endl;
+  return(bad);
+}
+
+//------------------------------------------------------------
+// Procedure: runPolyDistBench()
+
+int runPolyDistBench(int reps, double sdf_cell, double sdf_range)
+{
+  // Query points: fixed pseudo-random scatter over a 100x100 m
+  // box, so most fall outside the obstacle and some inside
+  const unsigned int num_pts = 4096;
+  vector<double> px(num_pts), py(num_pts), out(num_pts);
+  unsigned long seed = 12345;
+  for(unsigned int i = 0; i < num_pts; i++) {
+    seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+    px[i] = (double)((seed >> 11) % 100000) / 1000.0;
+    seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+    py[i] = (double)((seed >> 11) % 100000) / 1000.0;
+  }
+
+  cout << "Poly distance microbench: " << num_pts << " points x "
+       << reps << " reps" << endl;
+  cout << "verts  dist_to_poly(ns)  prepared(ns)  batched(ns)"
+       << "  speedup  max_diff" << endl;
+
+  unsigned int vert_counts[] = {4, 8, 16, 32};
+  const unsigned int num_segs = 1024;
+  unsigned int seg_bad = 0;
+  double sink = 0;
+  for(unsigned int v = 0; v < 4; v++) {
+    // Regular polygon, radius 10 m, centered in the box. Odd rows
+    // are wound clockwise to exercise the orientation handling.
+    unsigned int nv = vert_counts[v];
+    XYPolygon poly;
+    for(unsigned int i = 0; i < nv; i++) {
+      double a = 2 * M_PI * (double)i / (double)nv;
+      if(v % 2)
+        a = -a;
+      poly.add_vertex(50 + 10 * cos(a), 50 + 10 * sin(a));
+    }
+    ConvexPolyDist pdist(poly);
+
+    MBTimer t_ref;
+    t_ref.start();
+    for(int r = 0; r < reps; r++)
+      for(unsigned int i = 0; i < num_pts; i++)
+        sink += poly.dist_to_poly(px[i], py[i]);
+    t_ref.stop();
+
+    MBTimer t_one;
+    t_one.start();
+    for(int r = 0; r < reps; r++)
+      for(unsigned int i = 0; i < num_pts; i++)
+        sink += pdist.dist(px[i], py[i]);
+    t_one.stop();
+
+    MBTimer t_batch;
+    t_batch.start();
+    for(int r = 0; r < reps; r++) {
+      pdist.dist(&px[0], &py[0], num_pts, &out[0]);
+      sink += out[r % num_pts];
+    }
+    t_batch.stop();
+
+    // Agreement with dist_to_poly over every point
+    double max_diff = 0;
+    for(unsigned int i = 0; i < num_pts; i++) {
+      double ref = poly.dist_to_poly(px[i], py[i]);
+      max_diff = max(max_diff, fabs(ref - out[i]));
+      max_diff = max(max_diff, fabs(ref - pdist.dist(px[i], py[i])));
+    }
+
+    double queries = (double)reps * num_pts;
+    double ns_ref   = t_ref.get_float_wall_time() / queries * 1e9;
+    double ns_one   = t_one.get_float_wall_time() / queries * 1e9;
+    double ns_batch = t_batch.get_float_wall_time() / queries * 1e9;
+    cout << nv << "\t" << ns_ref << "\t\t" << ns_one << "\t\t" << ns_batch
+         << "\t" << ((ns_batch > 0) ? ns_ref / ns_batch : 0) << "x\t"
+         << max_diff << endl;
+    seg_bad += checkSegDist(poly, px, py, num_segs);
+
+    if(!(sdf_cell > 0))
+      continue;
+
+    // Distance raster: build time, lookup time, observed error
+    MBTimer t_build;
+    t_build.start();
+    shared_ptr<const PolySDFGrid> grid = PolySDFGrid::get(poly, sdf_cell, sdf_range);
+    t_build.stop();
+    if(!grid) {
+      cout << "   sdf: grid not built" << endl;
+      continue;
+    }
+    // Same polygon again, as a respawned behavior would ask for it
+    shared_ptr<const PolySDFGrid> again = PolySDFGrid::get(poly, sdf_cell, sdf_range);
+
+    ConvexPolyDist gdist(poly);
+    gdist.setGrid(grid);
+
+    MBTimer t_grid;
+    t_grid.start();
+    for(int r = 0; r < reps; r++)
+      for(unsigned int i = 0; i < num_pts; i++)
+        sink += gdist.dist(px[i], py[i]);
+    t_grid.stop();
+
+    double grid_err = 0;
+    unsigned int covered = 0;
+    for(unsigned int i = 0; i < num_pts; i++) {
+      double d;
+      if(!grid->lookup(px[i], py[i], d))
+        continue;
+      covered++;
+      grid_err = max(grid_err, fabs(d - poly.dist_to_poly(px[i], py[i])));
+    }
+
+    double ns_grid = t_grid.get_float_wall_time() / queries * 1e9;
+    cout << "   sdf: " << grid->cols() << "x" << grid->rows() << " cells of "
+         << sdf_cell << " m, build " << t_build.get_float_wall_time() * 1000
+         << " ms, reused " << ((again == grid) ? "yes" : "no")
+         << ", " << ns_grid << " ns/query (" << covered << " pts covered), "
+         << "max err " << grid_err << " (bound " << grid->maxError() << ")"
+         << endl;
+  }
+  // Concave: a 20 m square with a 10 m notch cut into its top
+  XYPolygon notch;
+  notch.add_vertex(40, 40);
+  notch.add_vertex(60, 40);
+  notch.add_vertex(60, 60);
+  notch.add_vertex(55, 60);
+  notch.add_vertex(50, 50);
+  notch.add_vertex(45, 60);
+  notch.add_vertex(40, 60);
+  cout << "concave (dist_to_poly fallback)" << endl;
+  seg_bad += checkSegDist(notch, px, py, num_segs);
+  cout << "segment distances outside the sampling bound: " << seg_bad
+       << endl;
+
+  if(sdf_cell > 0)
+    cout << "sdf cache: " << PolySDFGrid::cacheHits() << " hits, "
+         << PolySDFGrid::cacheMisses() << " misses, "
+         << PolySDFGrid::cacheSize() << " grids" << endl;
+  cout << "(checksum " << sink << ")" << endl;
+
+  // An exact distance outside the sampling bound is an error
+  if(seg_bad > 0)
+    return(1);
+  return(0);
+}
@@ -0,0 +1,17 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PolyDistBench.h                                 */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef POLY_DIST_BENCH_HEADER
+#define POLY_DIST_BENCH_HEADER
+
+// Microbenchmark: ConvexPolyDist (and optionally a PolySDFGrid
+// with the given cell size and range) vs XYPolygon::dist_to_poly.
+// Returns non-zero if an exact segment distance falls outside the
+// bound of the densely sampled one.
+int runPolyDistBench(int reps, double sdf_cell, double sdf_range);
+
+#endif
@@ -0,0 +1,90 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PrecisionBench.cpp                              */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Evaluates every domain point with the double and the     */
+/* float eval paths, for full and relaxed cable dynamics,   */
+/* and reports evals/sec of each and the deviation of float */
+/* from double: max and mean |du|, the candidates that      */
+/* differ, those whose contact prediction differs, and the  */
+/* (course, speed) of the worst case. Reach pruning is off  */
+/* so every candidate is simulated.                         */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "BenchScenario.h"
+#include "PrecisionBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: runPrecisionBench()
+
+int runPrecisionBench(const AOF_TowObstacleAvoid& base,
+                      const IvPDomain& domain, int reps)
+{
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+  unsigned int n = domain.getVarPoints(crs_ix) * num_spd;
+  if(reps < 1)
+    reps = 1;
+
+  double contact_util = benchContactUtil(base);
+
+  cout << "Precision bench: " << n << " candidates x " << reps
+       << " reps" << endl;
+  cout << "cable     path    evals/sec  max_du    mean_du   differ"
+       << "  contact_diff  worst(crs,spd)" << endl;
+
+  for(int cd = 0; cd < 2; cd++) {
+    AOF_TowObstacleAvoid aof_d = base;
+    aof_d.setUseCableDynamics(cd == 0);
+    aof_d.setReachPrune(false);
+    aof_d.setFloatEval(false);
+    aof_d.initialize();
+
+    AOF_TowObstacleAvoid aof_f = aof_d;
+    aof_f.setFloatEval(true);
+    aof_f.initialize();
+
+    vector<double> utils_d, utils_f;
+    double ms_d = benchSweep(aof_d, domain, reps, false, utils_d);
+    double ms_f = benchSweep(aof_f, domain, reps, false, utils_f);
+
+    double max_du = 0, sum_du = 0;
+    unsigned int differ = 0, contact_diff = 0, worst = 0;
+    for(unsigned int j = 0; j < n; j++) {
+      double du = fabs(utils_f[j] - utils_d[j]);
+      if(du > max_du) {
+        max_du = du;
+        worst = j;
+      }
+      sum_du += du;
+      if(du != 0)
+        differ++;
+      if((utils_f[j] <= contact_util) != (utils_d[j] <= contact_util))
+        contact_diff++;
+    }
+
+    double worst_crs = 0, worst_spd = 0;
+    domain.getVal(crs_ix, worst / num_spd, worst_crs);
+    domain.getVal(spd_ix, worst % num_spd, worst_spd);
+
+    const char *cable = (cd == 0) ? "full   " : "relaxed";
+    cout << cable << "   double  " << (ms_d > 0 ? n * 1000 / ms_d : 0)
+         << endl;
+    cout << cable << "   float   " << (ms_f > 0 ? n * 1000 / ms_f : 0)
+         << "\t" << max_du << "\t" << sum_du / n << "\t" << differ
+         << "\t" << contact_diff << "\t(" << worst_crs << ","
+         << worst_spd << ")";
+    if(!aof_f.usingFloatEval())
+      cout << "  [float path unavailable, ran double]";
+    cout << endl;
+  }
+  return(0);
+}
@@ -0,0 +1,19 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PrecisionBench.h                                */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef PRECISION_BENCH_HEADER
+#define PRECISION_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Evals/sec of the double and float eval paths and the worst
+// utility deviation of float from double over the whole domain
+int runPrecisionBench(const AOF_TowObstacleAvoid& base,
+                      const IvPDomain& domain, int reps);
+
+#endif
@@ -0,0 +1,115 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: StepBench.cpp                                   */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Evaluates the whole domain with a fine fixed-step        */
+/* reference (every step checked), then with fixed steps at */
+/* the configured sim_dt and coarser, and with adaptive     */
+/* steps at several step caps. For each it reports the sim  */
+/* steps per candidate, the evaluation time, and the        */
+/* utility error against the reference (max, mean, and the  */
+/* number of candidates whose contact prediction differs).  */
+/*                                                          */
+/* The tow speed penalty and reach pruning are turned off   */
+/* so every candidate is simulated and utility reflects the */
+/* predicted CPA alone (in the ramp band between the min    */
+/* and max util CPA, 50 utility points span that band).     */
+/* Candidates are timed through evalBox(), the path the     */
+/* helm's reflector uses.                                   */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "BenchScenario.h"
+#include "StepBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: stepBenchEval()
+//   Purpose: Evaluate every domain point with a copy of base.
+//            Returns the wall time; steps is set to the number
+//            of cable sim steps taken.
+
+static double stepBenchEval(const AOF_TowObstacleAvoid& base,
+                            const IvPDomain& domain,
+                            double dt, double sim_hz, double turn_rate,
+                            double adapt_max_dt, int check_interval,
+                            vector<double>& utils, unsigned long& steps)
+{
+  AOF_TowObstacleAvoid aof = base;
+  aof.setSimParams(dt, sim_hz, turn_rate);
+  aof.setTowSpeedPenalty(false);
+  aof.setReachPrune(false);
+  aof.setAdaptiveStep(adapt_max_dt);
+  if(check_interval > 0)
+    aof.setCableCheckInterval(check_interval);
+  aof.initialize();
+  double ms = benchSweep(aof, domain, 1, false, utils);
+  steps = aof.getSimSteps();
+  return(ms / 1000);
+}
+
+//------------------------------------------------------------
+// Procedure: runStepBench()
+
+int runStepBench(const AOF_TowObstacleAvoid& base, const IvPDomain& domain,
+                 double sim_dt, double sim_hz, double turn_rate,
+                 double ref_dt)
+{
+  unsigned int n = domain.getVarPoints(domain.getIndex("course")) *
+    domain.getVarPoints(domain.getIndex("speed"));
+
+  double contact_util = benchContactUtil(base);
+
+  vector<double> ref_utils;
+  unsigned long ref_steps = 0;
+  double ref_time = stepBenchEval(base, domain, ref_dt, sim_hz, turn_rate,
+                                  0, 1, ref_utils, ref_steps);
+
+  cout << "Time step bench: " << n << " candidates, reference dt "
+       << ref_dt << " s, " << (double)ref_steps / n << " steps/cand, "
+       << ref_time * 1000 << " ms" << endl;
+  cout << "dt     max_dt  steps/cand  time(ms)  max_err  mean_err  contact_diff"
+       << endl;
+
+  // Fixed steps at sim_dt and coarser, then adaptive from sim_dt
+  struct StepCase {double dt; double max_dt;};
+  vector<StepCase> cases;
+  StepCase c;
+  c.max_dt = 0;
+  c.dt = sim_dt;      cases.push_back(c);
+  c.dt = 2.5*sim_dt;  cases.push_back(c);
+  c.dt = 5*sim_dt;    cases.push_back(c);
+  c.dt = sim_dt;
+  c.max_dt = 0.25;    cases.push_back(c);
+  c.max_dt = 0.5;     cases.push_back(c);
+  c.max_dt = 1.0;     cases.push_back(c);
+
+  for(unsigned int i = 0; i < cases.size(); i++) {
+    vector<double> utils;
+    unsigned long steps = 0;
+    double t = stepBenchEval(base, domain, cases[i].dt, sim_hz, turn_rate,
+                             cases[i].max_dt, 0, utils, steps);
+    double max_err = 0, sum_err = 0;
+    unsigned int contact_diff = 0;
+    for(unsigned int j = 0; j < n; j++) {
+      double err = fabs(utils[j] - ref_utils[j]);
+      max_err = max(max_err, err);
+      sum_err += err;
+      if((utils[j] <= contact_util) != (ref_utils[j] <= contact_util))
+        contact_diff++;
+    }
+    cout << cases[i].dt << "\t";
+    if(cases[i].max_dt > 0)
+      cout << cases[i].max_dt;
+    else
+      cout << "fixed";
+    cout << "\t" << (double)steps / n << "\t    " << t * 1000 << "\t      "
+         << max_err << "\t" << sum_err / n << "\t  " << contact_diff << endl;
+  }
+  return(0);
+}
@@ -0,0 +1,20 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: StepBench.h                                     */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef STEP_BENCH_HEADER
+#define STEP_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Sim steps and utility error of fixed and adaptive time steps
+// against a fine fixed-step reference, over the whole domain
+int runStepBench(const AOF_TowObstacleAvoid& base, const IvPDomain& domain,
+                 double sim_dt, double sim_hz, double turn_rate,
+                 double ref_dt);
+
+#endif
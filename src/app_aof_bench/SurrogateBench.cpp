@@ -0,0 +1,113 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: SurrogateBench.cpp                              */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Generates a surrogate table for the bench config (see    */
+/* TowSurrogate.h), writes it, and maps it back as the      */
+/* behavior would. Then, for a tow trailing taut astern at  */
+/* several speeds (on and between the table's v0 points),   */
+/* evaluates the whole domain live and from the table and   */
+/* reports the fraction served, the time per sweep, and the */
+/* utility error (max, mean, and candidates whose contact   */
+/* prediction differs). Last, checks that the bench's own   */
+/* off-trail tow state falls back to the live sim.          */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include "TowSurrogateGen.h"
+#include "BenchScenario.h"
+#include "SurrogateBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: runSurrogateBench()
+
+int runSurrogateBench(const AOF_TowObstacleAvoid& base,
+                      const ObShipModelV24& obm, const IvPDomain& domain,
+                      TowSurrogateConfig cfg, double horizon,
+                      const string& path, unsigned int reps)
+{
+  string err;
+  string table_path = path;
+  if(table_path.empty()) {
+    table_path = "/tmp/aof_bench_surrogate.tsg";
+    TowSurrogateGrid grid;
+    vector<float> data;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    if(!towSurrogateGenerate(cfg, horizon, grid, data, err) ||
+       !TowSurrogate::write(table_path, cfg, grid, data, err)) {
+      cout << "Surrogate generation failed: " << err << endl;
+      return(1);
+    }
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+    cout << "Generated " << table_path << " in " << ms.count() << " ms"
+         << endl;
+  }
+
+  shared_ptr<const TowSurrogate> table = TowSurrogate::open(table_path, err);
+  if(!table) {
+    cout << "Surrogate table: " << err << endl;
+    return(1);
+  }
+  const TowSurrogateHeader& hdr = table->header();
+  cout << "Surrogate table: " << hdr.n_off << " offsets x " << hdr.n_spd
+       << " speeds x " << hdr.n_v0 << " tow speeds x " << hdr.steps
+       << " steps, " << table->bytes() / (1024.0 * 1024.0) << " MB mapped"
+       << endl;
+
+  unsigned int n = domain.getVarPoints(domain.getIndex("course")) *
+    domain.getVarPoints(domain.getIndex("speed"));
+  double contact_util = benchContactUtil(base);
+
+  // Trailing taut astern of the attach point along ownship heading
+  double hdg_rad = (90.0 - obm.getOSH()) * M_PI / 180.0;
+  double fx = cos(hdg_rad);
+  double fy = sin(hdg_rad);
+  double back = cfg.attach_offset + cfg.cable_length;
+
+  cout << "v0     served   live_ms  surr_ms  speedup  max_du   mean_du"
+       << "  contact_diff" << endl;
+  double v0s[4] = {0.5, 1.0, 1.25, 2.0};
+  for(unsigned int i = 0; i < 4; i++) {
+    AOF_TowObstacleAvoid live = base;
+    live.setTowState(obm.getOSX() - back * fx, obm.getOSY() - back * fy,
+                     v0s[i] * fx, v0s[i] * fy);
+    AOF_TowObstacleAvoid surr = live;
+    surr.setSurrogate(table);
+
+    vector<double> ref, utils;
+    double live_ms = benchSweep(live, domain, reps, true, ref);
+    double surr_ms = benchSweep(surr, domain, reps, true, utils);
+
+    double max_du = 0, sum_du = 0;
+    unsigned int contact_diff = 0;
+    for(unsigned int j = 0; j < n; j++) {
+      double du = fabs(utils[j] - ref[j]);
+      max_du = max(max_du, du);
+      sum_du += du;
+      if((utils[j] <= contact_util) != (ref[j] <= contact_util))
+        contact_diff++;
+    }
+
+    unsigned long served = surr.getSurrogateServed();
+    unsigned long total  = served + surr.getSurrogateFallbacks();
+    double frac = (total > 0) ? (double)served / total : 0;
+    cout << v0s[i] << "\t" << frac << "\t " << live_ms << "\t  " << surr_ms
+         << "\t   " << live_ms / surr_ms << "\t" << max_du << "\t"
+         << sum_du / n << "\t " << contact_diff << endl;
+  }
+
+  AOF_TowObstacleAvoid off_trail = base;
+  off_trail.setSurrogate(table);
+  off_trail.initialize();
+  cout << "Bench tow state: "
+       << (off_trail.usingSurrogate() ? "served by the table"
+           : "outside the table, simulated live") << endl;
+  return(0);
+}
@@ -0,0 +1,25 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: SurrogateBench.h                                */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef SURROGATE_BENCH_HEADER
+#define SURROGATE_BENCH_HEADER
+
+#include <string>
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+#include "ObShipModelV24.h"
+#include "TowSurrogate.h"
+
+// Generates a surrogate table for cfg (or maps path if given) and
+// compares surrogate against live evaluation: time, fraction
+// served, and utility error, for several trailing tow speeds
+int runSurrogateBench(const AOF_TowObstacleAvoid& base,
+                      const ObShipModelV24& obm, const IvPDomain& domain,
+                      TowSurrogateConfig cfg, double horizon,
+                      const std::string& path, unsigned int reps);
+
+#endif
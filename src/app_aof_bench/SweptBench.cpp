@@ -0,0 +1,130 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: SweptBench.cpp                                  */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Evaluates the whole domain with a fine-dt reference      */
+/* (discrete checks every step) and then, for a range of    */
+/* coarser sim_dt values, with the usual discrete checks    */
+/* and with swept checks. For each it reports how many      */
+/* candidates the reference sees in contact that the coarse */
+/* run misses (tunneling), how many extra contacts it       */
+/* reports, and the evaluation time. "lost" counts contacts */
+/* the discrete check finds at the same dt that the swept   */
+/* check does not; it should always be 0.                   */
+/*                                                          */
+/* The tow speed penalty is turned off so a contact can be  */
+/* read off the utility: with contact predicted, utility is */
+/* at most the ttc ceiling (40% of the range), otherwise it */
+/* is above it (see utilityFromSim()).                      */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "MBTimer.h"
+#include "BenchScenario.h"
+#include "SweptBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: sweptBenchEval()
+//   Purpose: Evaluate every domain point with a copy of base at
+//            the given dt. Returns the wall time in seconds.
+
+static double sweptBenchEval(const AOF_TowObstacleAvoid& base,
+                             const vector<double>& crs,
+                             const vector<double>& spd,
+                             double dt, double sim_hz, double turn_rate,
+                             int check_interval, bool swept,
+                             vector<double>& utils)
+{
+  AOF_TowObstacleAvoid aof = base;
+  aof.setSimParams(dt, sim_hz, turn_rate);
+  aof.setTowSpeedPenalty(false);
+  aof.setSweptCheck(swept);
+  if(check_interval > 0)
+    aof.setCableCheckInterval(check_interval);
+  aof.initialize();
+
+  utils.assign(crs.size(), 0);
+  MBTimer timer;
+  timer.start();
+  aof.evalBatch(&crs[0], &spd[0], crs.size(), &utils[0]);
+  timer.stop();
+  return(timer.get_float_wall_time());
+}
+
+//------------------------------------------------------------
+// Procedure: runSweptBench()
+
+int runSweptBench(const AOF_TowObstacleAvoid& base, const IvPDomain& domain,
+                  double sim_hz, double turn_rate, double ref_dt)
+{
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_crs = domain.getVarPoints(crs_ix);
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+
+  vector<double> crs, spd;
+  for(unsigned int ci = 0; ci < num_crs; ci++) {
+    for(unsigned int si = 0; si < num_spd; si++) {
+      double c = 0, s = 0;
+      domain.getVal(crs_ix, ci, c);
+      domain.getVal(spd_ix, si, s);
+      crs.push_back(c);
+      spd.push_back(s);
+    }
+  }
+  unsigned int n = crs.size();
+
+  double contact_util = benchContactUtil(base);
+
+  vector<double> ref_utils;
+  double ref_time = sweptBenchEval(base, crs, spd, ref_dt, sim_hz,
+                                   turn_rate, 1, false, ref_utils);
+  unsigned int ref_contacts = 0;
+  for(unsigned int i = 0; i < n; i++)
+    if(ref_utils[i] <= contact_util)
+      ref_contacts++;
+
+  cout << "Swept check bench: " << n << " candidates, reference dt "
+       << ref_dt << " s (every step checked)" << endl;
+  cout << "Reference: " << ref_contacts << " in contact, "
+       << ref_time * 1000 << " ms" << endl;
+  cout << "dt     check    steps  contacts  missed  extra  lost  time(ms)  speedup"
+       << endl;
+
+  const double dts[] = {0.1, 0.25, 0.5, 1.0};
+  for(unsigned int d = 0; d < sizeof(dts) / sizeof(dts[0]); d++) {
+    vector<double> disc_utils;
+    for(int swept = 0; swept <= 1; swept++) {
+      vector<double> utils;
+      double t = sweptBenchEval(base, crs, spd, dts[d], sim_hz, turn_rate,
+                                0, (swept == 1), utils);
+      unsigned int contacts = 0, missed = 0, extra = 0, lost = 0;
+      for(unsigned int i = 0; i < n; i++) {
+        bool ref_hit = (ref_utils[i] <= contact_util);
+        bool hit     = (utils[i] <= contact_util);
+        if(hit)
+          contacts++;
+        if(ref_hit && !hit)
+          missed++;
+        if(hit && !ref_hit)
+          extra++;
+        if(swept && !hit && (disc_utils[i] <= contact_util))
+          lost++;
+      }
+      if(!swept)
+        disc_utils = utils;
+      cout << dts[d] << "\t" << (swept ? "swept   " : "discrete") << " "
+           << (int)ceil(sim_hz / dts[d]) << "\t" << contacts << "\t  "
+           << missed << "\t  " << extra << "\t " << (swept ? lost : 0)
+           << "\t" << t * 1000 << "\t   "
+           << ((t > 0) ? ref_time / t : 0) << "x" << endl;
+    }
+  }
+  return(0);
+}
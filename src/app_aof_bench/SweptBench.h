@@ -0,0 +1,19 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: SweptBench.h                                    */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef SWEPT_BENCH_HEADER
+#define SWEPT_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Contact agreement of discrete and swept checks at coarse sim_dt
+// against a fine-dt discrete reference, over the whole domain
+int runSweptBench(const AOF_TowObstacleAvoid& base, const IvPDomain& domain,
+                  double sim_hz, double turn_rate, double ref_dt);
+
+#endif
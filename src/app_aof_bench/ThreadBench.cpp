@@ -0,0 +1,140 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: ThreadBench.cpp                                 */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Builds as the parallel BHV_TowObstacleAvoid does, with   */
+/* the whole domain standing in for the reflector's points: */
+/* a recording pass, evalRecordedPoints() on a pool, and a  */
+/* pass served from the table. Thread counts double from 1  */
+/* up to max_threads, for the bench obstacle alone and for  */
+/* a joint field of six (full and relaxed cable), and with  */
+/* a shared trajectory set that overflows. Each count is    */
+/* checked against a plain serial sweep, which it must      */
+/* match exactly.                                           */
+/************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include "IvPBox.h"
+#include "BenchScenario.h"
+#include "ThreadBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: threadBenchSweep()
+//   Purpose: reps builds of the domain on a pool of the given
+//            size (0: plain serial evalBox()). Returns the mean
+//            wall time per build in ms; utilities of the last
+//            build go in utils.
+
+static double threadBenchSweep(const AOF_TowObstacleAvoid& base,
+                               const IvPDomain& domain,
+                               unsigned int threads, unsigned int reps,
+                               vector<double>& utils,
+                               unsigned long& steals)
+{
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_crs = domain.getVarPoints(crs_ix);
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+  if(reps == 0)
+    reps = 1;
+
+  TowWorkPool pool(threads ? threads : 1);
+  utils.assign(num_crs * num_spd, 0);
+  IvPBox box(2);
+  double total_ms = 0;
+  for(unsigned int r = 0; r < reps; r++) {
+    AOF_TowObstacleAvoid aof = base;
+    aof.initialize();
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for(int pass = (threads ? 0 : 1); pass < 2; pass++) {
+      if(pass == 0)
+        aof.setPointRecording(true);
+      for(unsigned int ci = 0; ci < num_crs; ci++) {
+        for(unsigned int si = 0; si < num_spd; si++) {
+          box.setPTS(crs_ix, ci, ci);
+          box.setPTS(spd_ix, si, si);
+          utils[ci*num_spd + si] = aof.evalBox(&box);
+        }
+      }
+      if(pass == 0)
+        aof.evalRecordedPoints(pool);
+    }
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+    total_ms += ms.count();
+  }
+  steals = pool.steals() / reps;
+  return(total_ms / reps);
+}
+
+//------------------------------------------------------------
+// Procedure: threadBenchCase()
+
+static void threadBenchCase(const string& label,
+                            const AOF_TowObstacleAvoid& base,
+                            const IvPDomain& domain, unsigned int reps,
+                            unsigned int max_threads)
+{
+  vector<double> u_serial, u_par;
+  unsigned long steals = 0;
+  double serial_ms = threadBenchSweep(base, domain, 0, reps, u_serial,
+                                      steals);
+  cout << label << "\tserial\t" << serial_ms << "\t\t1\t-\t-" << endl;
+
+  double one_ms = 0;
+  for(unsigned int t = 1; t <= max_threads; t *= 2) {
+    double ms = threadBenchSweep(base, domain, t, reps, u_par, steals);
+    if(t == 1)
+      one_ms = ms;
+    unsigned int differ = 0;
+    for(unsigned int k = 0; k < u_par.size(); k++)
+      if(u_par[k] != u_serial[k])
+        differ++;
+    cout << label << "\t" << t << "\t" << ms << "\t\t"
+         << one_ms / max(ms, 1e-9) << "\t" << steals << "\t" << differ
+         << endl;
+  }
+}
+
+//------------------------------------------------------------
+// Procedure: runThreadBench()
+
+int runThreadBench(const AOF_TowObstacleAvoid& base,
+                   const IvPDomain& domain, unsigned int reps,
+                   unsigned int max_threads)
+{
+  if(max_threads == 0)
+    max_threads = max(1u, thread::hardware_concurrency());
+
+  cout << "Thread bench: up to " << max_threads << " threads, "
+       << thread::hardware_concurrency() << " hardware threads" << endl;
+  cout << "case\tthreads\tms\t\tspeedup\tsteals\tdiffer" << endl;
+
+  threadBenchCase("single", base, domain, reps, max_threads);
+
+  shared_ptr<const PolySDFGrid> none;
+  vector<XYPolygon> boxes = benchField();
+  AOF_TowObstacleAvoid field = base;
+  for(unsigned int i = 0; i < boxes.size(); i++)
+    field.addObstacle(boxes[i], none);
+
+  field.setUseCableDynamics(true);
+  threadBenchCase("field6", field, domain, reps, max_threads);
+  field.setUseCableDynamics(false);
+  threadBenchCase("field6r", field, domain, reps, max_threads);
+
+  // Shared trajectories recorded by whichever worker comes first,
+  // with a budget too small for the domain
+  AOF_TowObstacleAvoid traj = base;
+  traj.setUseCableDynamics(true);
+  traj.setTrajectoryCache(true, -1, 4);
+  threadBenchCase("traj4mb", traj, domain, reps, max_threads);
+  return(0);
+}
@@ -0,0 +1,21 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: ThreadBench.h                                   */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef THREAD_BENCH_HEADER
+#define THREAD_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+
+// Parallel domain evaluation (evalRecordedPoints()) over a thread
+// count sweep: wall time, speedup on one thread, steals, and
+// utilities differing from the serial sweep
+int runThreadBench(const AOF_TowObstacleAvoid& base,
+                   const IvPDomain& domain, unsigned int reps,
+                   unsigned int max_threads);
+
+#endif
@@ -0,0 +1,294 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowDynBench.cpp                                 */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Checks of the shared lib_towdyn model, then timings:     */
+/*   - towCableNodes() against the node rule that pTowing,  */
+/*     pCable and the AOF each used to carry;               */
+/*   - the fixed-N kernels against the runtime-n steps and  */
+/*     relaxations, value for value, N = 3..16 in double    */
+/*     and float (steps where a fixed step exists), over a  */
+/*     tow swinging through a turn;                         */
+/*   - |tow - anchor| <= cable length after every body step */
+/*     of every integrator, the tow started going outward;  */
+/*   - every integrator's cable step stays finite.          */
+/* Timings are ns per body step, and per cable step and     */
+/* relaxation, fixed-N and runtime-n.                       */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "MBTimer.h"
+#include "TowDynamics.h"
+#include "TowDynBench.h"
+
+using namespace std;
+
+namespace {
+
+const double BENCH_DT = 0.02;
+
+//------------------------------------------------------------
+// Procedure: benchParams()
+//   Purpose: The pCable/pTowing defaults for an N-node cable
+
+template<typename T>
+TowCableParamsT<T> benchParams(int n)
+{
+  TowCableParamsT<T> p;
+  p.k_spring     = 5.0;
+  p.cd           = 0.7;
+  p.c_tan        = 2.0;
+  p.cable_length = 10.0 * n;
+  p.rest_length  = p.cable_length / (n - 1);
+  return(p);
+}
+
+//------------------------------------------------------------
+// Procedure: benchTow()
+//   Purpose: Tow position at step k: the anchor runs along x at
+//            2 m/s and the tow swings through a half turn behind.
+
+template<typename T>
+void benchTow(const TowCableParamsT<T>& p, int k, T& ax, T& ay,
+              T& tx, T& ty)
+{
+  double t   = k * BENCH_DT;
+  double ang = M_PI * min(1.0, t / 20.0);
+  ax = (T)(2.0 * t);
+  ay = 0;
+  tx = (T)(ax - 0.95 * p.cable_length * cos(ang));
+  ty = (T)(ay - 0.95 * p.cable_length * sin(ang));
+}
+
+//------------------------------------------------------------
+// Procedure: checkKernels()
+//   Purpose: Values that differ between the fixed-N kernels and
+//            the runtime-n steps, summed over N = 3..16.
+
+template<typename T>
+unsigned long checkKernels(int steps)
+{
+  unsigned long bad = 0;
+  for(int n = 3; n <= 16; n++) {
+    typename TowCableFns<T>::Step  step  = 0;
+    typename TowCableFns<T>::Relax relax = 0;
+    if(!towCableKernels(n, step, relax)) {
+      bad++;
+      continue;
+    }
+    TowCableParamsT<T> p = benchParams<T>(n);
+
+    vector<T> fx(n), fy(n), fvx(n, 0), fvy(n, 0);
+    vector<T> rx(n), ry(n), rvx(n, 0), rvy(n, 0);
+    T ax, ay, tx, ty;
+    benchTow(p, 0, ax, ay, tx, ty);
+    relax(p.rest_length, ax, ay, tx, ty, &fx[0], &fy[0]);
+    towCableRelaxN(p.rest_length, n, ax, ay, tx, ty, &rx[0], &ry[0]);
+
+    for(int k = 0; k <= steps; k++) {
+      for(int i = 0; i < n; i++) {
+        if((fx[i] != rx[i]) || (fy[i] != ry[i]) ||
+           (fvx[i] != rvx[i]) || (fvy[i] != rvy[i]))
+          bad++;
+      }
+      benchTow(p, k + 1, ax, ay, tx, ty);
+      if(step) {
+        step(p, ax, ay, tx, ty, (T)BENCH_DT,
+             &fx[0], &fy[0], &fvx[0], &fvy[0]);
+        towCableStepN(p, n, ax, ay, tx, ty, (T)BENCH_DT,
+                      &rx[0], &ry[0], &rvx[0], &rvy[0]);
+      }
+      else {
+        relax(p.rest_length, ax, ay, tx, ty, &fx[0], &fy[0]);
+        towCableRelaxN(p.rest_length, n, ax, ay, tx, ty, &rx[0], &ry[0]);
+      }
+    }
+  }
+  return(bad);
+}
+
+//------------------------------------------------------------
+// Procedure: checkClamp()
+//   Purpose: Largest overshoot of the cable length by the tow
+//            body under method m, the anchor pulling away.
+
+double checkClamp(TowIntegrator m, int steps)
+{
+  TowCableParams p = benchParams<double>(6);
+  double tx = -p.cable_length, ty = 0;
+  double tvx = -3.0, tvy = 1.0;
+
+  double worst = 0;
+  for(int k = 1; k <= steps; k++) {
+    double t  = k * BENCH_DT;
+    double ax = 3.0 * t;
+    double ay = 5.0 * sin(0.2 * t);
+    towAdvanceBody(m, p, ax, ay, BENCH_DT, tx, ty, tvx, tvy);
+    double over = hypot(tx - ax, ty - ay) - p.cable_length;
+    worst = max(worst, over);
+  }
+  return(worst);
+}
+
+//------------------------------------------------------------
+// Procedure: checkFinite()
+//   Purpose: True if an n-node cable stepped by method m stays
+//            finite through the swing.
+
+bool checkFinite(TowIntegrator m, int n, int steps)
+{
+  TowCableParams p = benchParams<double>(n);
+  vector<double> x(n), y(n), vx(n, 0), vy(n, 0);
+  double ax, ay, tx, ty;
+  benchTow(p, 0, ax, ay, tx, ty);
+  towRelaxCable(p.rest_length, n, ax, ay, tx, ty, &x[0], &y[0]);
+
+  for(int k = 1; k <= steps; k++) {
+    benchTow(p, k, ax, ay, tx, ty);
+    towAdvanceCable(m, p, n, ax, ay, tx, ty, BENCH_DT,
+                    &x[0], &y[0], &vx[0], &vy[0]);
+  }
+  for(int i = 0; i < n; i++) {
+    if(!isfinite(x[i]) || !isfinite(y[i]) ||
+       !isfinite(vx[i]) || !isfinite(vy[i]))
+      return(false);
+  }
+  return(true);
+}
+
+//------------------------------------------------------------
+// Procedure: timeCable()
+//   Purpose: ns per cable step and per relaxation, n nodes,
+//            fixed-N (fixed true) or runtime-n. The step is timed
+//            runtime-n where there is no fixed step.
+
+void timeCable(int n, bool fixed, int steps, double& ns_step,
+               double& ns_relax, double& sink)
+{
+  TowCableParams p = benchParams<double>(n);
+  TowCableStepFn  step  = 0;
+  TowCableRelaxFn relax = 0;
+  towCableKernels(n, step, relax);
+  vector<double> x(n), y(n), vx(n, 0), vy(n, 0);
+  double ax, ay, tx, ty;
+  benchTow(p, 0, ax, ay, tx, ty);
+  towCableRelaxN(p.rest_length, n, ax, ay, tx, ty, &x[0], &y[0]);
+
+  MBTimer timer;
+  timer.start();
+  for(int k = 1; k <= steps; k++) {
+    double dx = 1e-4 * (k & 7);
+    if(fixed && step)
+      step(p, ax, ay, tx + dx, ty, BENCH_DT, &x[0], &y[0], &vx[0], &vy[0]);
+    else
+      towCableStepN(p, n, ax, ay, tx + dx, ty, BENCH_DT,
+                    &x[0], &y[0], &vx[0], &vy[0]);
+  }
+  timer.stop();
+  ns_step = timer.get_float_wall_time() * 1e9 / steps;
+  sink += x[n/2];
+
+  timer.start();
+  for(int k = 1; k <= steps; k++) {
+    double dx = 1e-4 * (k & 7);
+    if(fixed)
+      relax(p.rest_length, ax, ay, tx + dx, ty, &x[0], &y[0]);
+    else
+      towCableRelaxN(p.rest_length, n, ax, ay, tx + dx, ty, &x[0], &y[0]);
+    sink += x[n/2];
+  }
+  timer.stop();
+  ns_relax = timer.get_float_wall_time() * 1e9 / steps;
+}
+
+}
+
+//------------------------------------------------------------
+// Procedure: runTowDynBench()
+
+int runTowDynBench(int reps)
+{
+  if(reps < 1)
+    reps = 1;
+  int steps = 2000;
+  int timed = 200000 * reps;
+  int bad   = 0;
+
+  cout << "Tow dynamics (lib_towdyn): " << steps << " check steps, "
+       << timed << " timed steps, dt " << BENCH_DT << endl;
+
+  // 1) Node rule
+  const double lens[] = {0, 10, 29.9, 30, 35, 59.9, 60, 100, 160, 250};
+  int node_bad = 0;
+  for(unsigned int i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+    double l  = lens[i];
+    int    nn = (l < 30) ? 3 : max(3, (int)(l / 10.0));
+    if(towCableNodes(l) != nn)
+      node_bad++;
+  }
+  cout << "node rule mismatches:          " << node_bad << endl;
+  bad += node_bad;
+
+  // 2) Fixed-N kernels vs runtime-n
+  unsigned long kern_d = checkKernels<double>(steps);
+  unsigned long kern_f = checkKernels<float>(steps);
+  cout << "fixed-N vs runtime-n (double): " << kern_d << " values differ"
+       << endl;
+  cout << "fixed-N vs runtime-n (float):  " << kern_f << " values differ"
+       << endl;
+  bad += (kern_d > 0) + (kern_f > 0);
+
+  // 3) Clamp and finiteness per integrator
+  const TowIntegrator methods[] = {TOW_INT_EULER, TOW_INT_SEMI_IMPLICIT,
+                                   TOW_INT_RK2, TOW_INT_RK4};
+  cout << "integrator      clamp overshoot(m)  cable finite" << endl;
+  for(unsigned int i = 0; i < 4; i++) {
+    double over   = checkClamp(methods[i], steps);
+    bool   finite = checkFinite(methods[i], 6, steps) &&
+      checkFinite(methods[i], 16, steps) && checkFinite(methods[i], 20, steps);
+    cout << "  " << towIntegratorName(methods[i]) << "\t\t" << over
+         << "\t\t" << (finite ? "yes" : "NO") << endl;
+    if((over > 1e-9) || !finite)
+      bad++;
+  }
+
+  // 4) Timings
+  double sink = 0;
+  cout << "integrator      body step(ns)" << endl;
+  for(unsigned int i = 0; i < 4; i++) {
+    TowCableParams p = benchParams<double>(6);
+    double tx = -p.cable_length, ty = 0, tvx = 0, tvy = 0;
+    MBTimer timer;
+    timer.start();
+    for(int k = 1; k <= timed; k++)
+      towAdvanceBody(methods[i], p, 1e-5 * k, 0, BENCH_DT, tx, ty, tvx, tvy);
+    timer.stop();
+    sink += tx;
+    cout << "  " << towIntegratorName(methods[i]) << "\t\t"
+         << timer.get_float_wall_time() * 1e9 / timed << endl;
+  }
+
+  cout << "nodes  step fixed(ns)  step runtime(ns)  relax fixed(ns)"
+       << "  relax runtime(ns)" << endl;
+  const int ns[] = {3, 6, 10, 16};
+  for(unsigned int i = 0; i < 4; i++) {
+    double fs, fr, rs, rr;
+    timeCable(ns[i], true,  timed, fs, fr, sink);
+    timeCable(ns[i], false, timed, rs, rr, sink);
+    cout << ns[i] << "\t";
+    if(ns[i] <= TOW_CABLE_STEP_MAX_N)
+      cout << fs;
+    else
+      cout << "-";
+    cout << "\t\t" << rs << "\t\t" << fr << "\t\t" << rr << endl;
+  }
+
+  cout << (bad ? "FAILED: " : "passed: ") << bad << " checks failed"
+       << endl;
+  cout << "(checksum " << sink << ")" << endl;
+  return(bad ? 1 : 0);
+}
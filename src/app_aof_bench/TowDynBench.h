@@ -0,0 +1,15 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowDynBench.h                                   */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef TOW_DYN_BENCH_HEADER
+#define TOW_DYN_BENCH_HEADER
+
+// Checks and timings of the shared lib_towdyn model: node rule,
+// fixed-N vs runtime-n kernels, the cable clamp per integrator
+int runTowDynBench(int reps);
+
+#endif
@@ -0,0 +1,92 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TractrixBench.cpp                               */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* For a taut tow, trailing astern or swung off to port, at */
+/* several speeds along the cable, evaluates the whole      */
+/* domain with the numerical (Euler) sim and again with the */
+/* tractrix model (see AOF_TowObstacleAvoid::evalTractrix)  */
+/* and reports the fraction of candidates the model served, */
+/* the time per sweep, and the utility error (max, mean,    */
+/* and candidates whose contact prediction differs). Last,  */
+/* checks that the bench's own slack tow state falls back   */
+/* to the numerical sim.                                    */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "BenchScenario.h"
+#include "TractrixBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: runTractrixBench()
+
+int runTractrixBench(const AOF_TowObstacleAvoid& base,
+                     const ObShipModelV24& obm, const IvPDomain& domain,
+                     double cable_len, double attach_offset,
+                     unsigned int reps)
+{
+  unsigned int n = domain.getVarPoints(domain.getIndex("course")) *
+    domain.getVarPoints(domain.getIndex("speed"));
+
+  double contact_util = benchContactUtil(base);
+
+  double hdg_rad = (90.0 - obm.getOSH()) * M_PI / 180.0;
+  double ax = obm.getOSX() - attach_offset * cos(hdg_rad);
+  double ay = obm.getOSY() - attach_offset * sin(hdg_rad);
+
+  cout << "Tractrix bench: " << n << " candidates" << endl;
+  cout << "swing  v0     served   euler_ms  trx_ms   speedup  max_du"
+       << "   mean_du  contact_diff" << endl;
+
+  // Cable swung this far to port of dead astern (deg)
+  double swings[2] = {0, 30};
+  double v0s[3] = {0.5, 1.0, 2.0};
+  for(unsigned int w = 0; w < 2; w++) {
+    double cable_rad = hdg_rad + M_PI + swings[w] * M_PI / 180.0;
+    double cx = cos(cable_rad);
+    double cy = sin(cable_rad);
+    for(unsigned int i = 0; i < 3; i++) {
+      AOF_TowObstacleAvoid euler = base;
+      euler.setTowState(ax + cable_len * cx, ay + cable_len * cy,
+                        -v0s[i] * cx, -v0s[i] * cy);
+      AOF_TowObstacleAvoid trx = euler;
+      trx.setTractrix(true);
+
+      vector<double> ref, utils;
+      double euler_ms = benchSweep(euler, domain, reps, true, ref);
+      double trx_ms = benchSweep(trx, domain, reps, true, utils);
+
+      double max_du = 0, sum_du = 0;
+      unsigned int contact_diff = 0;
+      for(unsigned int j = 0; j < n; j++) {
+        double du = fabs(utils[j] - ref[j]);
+        max_du = max(max_du, du);
+        sum_du += du;
+        if((utils[j] <= contact_util) != (ref[j] <= contact_util))
+          contact_diff++;
+      }
+
+      unsigned long served = trx.getTractrixServed();
+      unsigned long total  = served + trx.getTractrixFallbacks();
+      double frac = (total > 0) ? (double)served / total : 0;
+      cout << swings[w] << "\t" << v0s[i] << "\t" << frac << "\t "
+           << euler_ms << "\t  " << trx_ms << "\t   " << euler_ms / trx_ms
+           << "\t" << max_du << "\t" << sum_du / n << "\t " << contact_diff
+           << endl;
+    }
+  }
+
+  AOF_TowObstacleAvoid slack = base;
+  slack.setTractrix(true);
+  slack.initialize();
+  cout << "Bench tow state: "
+       << (slack.usingTractrix() ? "taut, tractrix model"
+           : "not taut, numerical sim") << endl;
+  return(0);
+}
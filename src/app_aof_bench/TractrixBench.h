@@ -0,0 +1,23 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TractrixBench.h                                 */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef TRACTRIX_BENCH_HEADER
+#define TRACTRIX_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+#include "ObShipModelV24.h"
+
+// Compares the tractrix model against the numerical sim: fraction
+// served, time, and utility error, for taut tow states trailing
+// astern and swung off to one side
+int runTractrixBench(const AOF_TowObstacleAvoid& base,
+                     const ObShipModelV24& obm, const IvPDomain& domain,
+                     double cable_len, double attach_offset,
+                     unsigned int reps);
+
+#endif
@@ -0,0 +1,145 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TrajCacheBench.cpp                              */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Six obstacles within reach of ownship's tracks, each     */
+/* with its own AOF as a spawned behavior would build it,   */
+/* swept over the whole domain without and then with the    */
+/* shared trajectory cache (a fresh helm time per rep, so   */
+/* each rep records once and replays five times). Full and  */
+/* relaxed cable, and a budget too small for the domain so  */
+/* part of it is simulated live. Utilities are compared per */
+/* obstacle against the uncached sweep.                     */
+/************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include "IvPBox.h"
+#include "BenchScenario.h"
+#include "TrajCacheBench.h"
+
+using namespace std;
+
+//------------------------------------------------------------
+// Procedure: trajBenchSweep()
+//   Purpose: Sweep the domain with one AOF per obstacle, reps
+//            times, the cache (if on) stamped per rep. Returns
+//            the mean wall time per rep in ms; utilities of the
+//            last rep go in utils, per obstacle.
+
+static double trajBenchSweep(const AOF_TowObstacleAvoid& base,
+                             const ObShipModelV24& obm,
+                             const vector<XYPolygon>& field,
+                             const IvPDomain& domain, bool cached,
+                             double max_mb, unsigned int reps,
+                             vector<vector<double> >& utils,
+                             unsigned long& hits, unsigned long& misses,
+                             unsigned long& live)
+{
+  static double stamp = 0;
+
+  int crs_ix = domain.getIndex("course");
+  int spd_ix = domain.getIndex("speed");
+  unsigned int num_crs = domain.getVarPoints(crs_ix);
+  unsigned int num_spd = domain.getVarPoints(spd_ix);
+  if(reps == 0)
+    reps = 1;
+
+  utils.assign(field.size(), vector<double>(num_crs * num_spd, 0));
+  hits = misses = live = 0;
+  IvPBox box(2);
+  chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+  for(unsigned int r = 0; r < reps; r++) {
+    stamp += 1;
+    for(unsigned int i = 0; i < field.size(); i++) {
+      ObShipModelV24 obm_i = obm;
+      obm_i.setGutPoly(field[i]);
+      obm_i.setCachedVals(true);
+      AOF_TowObstacleAvoid aof = base;
+      aof.setObShipModel(obm_i);
+      aof.setTrajectoryCache(cached, stamp, max_mb);
+      aof.initialize();
+      for(unsigned int ci = 0; ci < num_crs; ci++) {
+        for(unsigned int si = 0; si < num_spd; si++) {
+          box.setPTS(crs_ix, ci, ci);
+          box.setPTS(spd_ix, si, si);
+          utils[i][ci*num_spd + si] = aof.evalBox(&box);
+        }
+      }
+      hits   += aof.getTrajectoryHits();
+      misses += aof.getTrajectoryMisses();
+      live   += aof.getTrajectoryLive();
+    }
+  }
+  chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+  hits   /= reps;
+  misses /= reps;
+  live   /= reps;
+  return(ms.count() / reps);
+}
+
+//------------------------------------------------------------
+// Procedure: trajBenchCase()
+
+static void trajBenchCase(const string& label,
+                          const AOF_TowObstacleAvoid& base,
+                          const ObShipModelV24& obm,
+                          const vector<XYPolygon>& field,
+                          const IvPDomain& domain, double max_mb,
+                          unsigned int reps)
+{
+  vector<vector<double> > u_live, u_cached;
+  unsigned long hits = 0, misses = 0, live = 0;
+  double live_ms = trajBenchSweep(base, obm, field, domain, false, max_mb,
+                                  reps, u_live, hits, misses, live);
+  double cached_ms = trajBenchSweep(base, obm, field, domain, true, max_mb,
+                                    reps, u_cached, hits, misses, live);
+  double mb = TowTrajectoryCache::cacheBytes() / (1024.0 * 1024.0);
+
+  unsigned int differ = 0, big = 0;
+  double max_du = 0;
+  for(unsigned int i = 0; i < field.size(); i++)
+    for(unsigned int k = 0; k < u_live[i].size(); k++) {
+      double du = fabs(u_cached[i][k] - u_live[i][k]);
+      if(du != 0)
+        differ++;
+      if(du > 1e-3)
+        big++;
+      max_du = max(max_du, du);
+    }
+
+  cout << label << "\t" << max_mb << "\t" << live_ms << "\t\t"
+       << cached_ms << "\t\t" << live_ms / max(cached_ms, 1e-9) << "\t"
+       << hits << "\t" << misses << "\t" << live << "\t" << mb << "\t"
+       << differ << "\t" << big << "\t" << max_du << endl;
+}
+
+//------------------------------------------------------------
+// Procedure: runTrajCacheBench()
+
+int runTrajCacheBench(const AOF_TowObstacleAvoid& base,
+                      const ObShipModelV24& obm, const IvPDomain& domain,
+                      unsigned int reps)
+{
+  vector<XYPolygon> field = benchField();
+  field.insert(field.begin(), obm.getGutPoly());
+
+  cout << "Trajectory cache bench: " << field.size() << " obstacles, one"
+       << " AOF each" << endl;
+  cout << "cable\tmax_mb\tuncached_ms\tcached_ms\tspeedup\thits\tmisses"
+       << "\tlive\tmb\tdiffer\tover_1e-3\tmax_du" << endl;
+
+  AOF_TowObstacleAvoid full = base;
+  full.setUseCableDynamics(true);
+  trajBenchCase("full", full, obm, field, domain, 32, reps);
+  trajBenchCase("full", full, obm, field, domain, 4, reps);
+
+  AOF_TowObstacleAvoid relaxed = base;
+  relaxed.setUseCableDynamics(false);
+  trajBenchCase("relaxed", relaxed, obm, field, domain, 32, reps);
+  return(0);
+}
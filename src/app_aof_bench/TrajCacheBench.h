@@ -0,0 +1,22 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TrajCacheBench.h                                */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#ifndef TRAJ_CACHE_BENCH_HEADER
+#define TRAJ_CACHE_BENCH_HEADER
+
+#include "IvPDomain.h"
+#include "AOF_TowObstacleAvoid.h"
+#include "ObShipModelV24.h"
+
+// One AOF per obstacle, as spawned behaviors build them, with and
+// without the shared trajectory cache: sweep times, cache counts
+// and memory, and utility differences
+int runTrajCacheBench(const AOF_TowObstacleAvoid& base,
+                      const ObShipModelV24& obm, const IvPDomain& domain,
+                      unsigned int reps);
+
+#endif
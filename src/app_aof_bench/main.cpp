@@ -14,12 +14,31 @@
 #include <cmath>
 #include <cstdlib>
 #include <string>
+#include <vector>
 #include "IvPDomain.h"
 #include "IvPBox.h"
 #include "AOF_TowObstacleAvoid.h"
 #include "ObShipModelV24.h"
 #include "XYPolygon.h"
 #include "MBTimer.h"
+#include "BenchScenario.h"
+#include "PolyDistBench.h"
+#include "SweptBench.h"
+#include "StepBench.h"
+#include "IntegratorBench.h"
+#include "PrecisionBench.h"
+#include "CacheBench.h"
+#include "AnytimeBench.h"
+#include "CascadeBench.h"
+#include "SurrogateBench.h"
+#include "TractrixBench.h"
+#include "BoundsBench.h"
+#include "FieldBench.h"
+#include "TrajCacheBench.h"
+#include "ThreadBench.h"
+#include "TowDynBench.h"
+#include "PolySDFGrid.h"
+#include "AllocCount.h"
 
 using namespace std;
 
@@ -40,6 +59,22 @@ int main(int argc, char *argv[])
   double       turn_rate    = 15.0; // turn rate max (deg/s)
   bool         cable_dyn    = true; // full cable dynamics vs relaxed
   string       side_lock    = "";   // "" = off, "port" or "star"
+  bool         reach_prune  = true; // reachability pruning
+  double       obs_x        = 50;   // obstacle lower-left corner x
+  double       obs_y        = 50;   // obstacle lower-left corner y
+  double       obs_w        = 5;    // obstacle width (m)
+  double       obs_h        = 5;    // obstacle height (m)
+  string       mode         = "aof"; // aof, polydist, swept, step, integrator, precision, cache, anytime, cascade, surrogate, tractrix, bounds, field, trajcache, threads, towdyn
+  double       ref_dt       = 0.02; // swept mode reference time step
+  bool         swept        = false; // swept contact checks
+  double       adapt_max_dt = 0;    // adaptive step cap (0 = fixed dt)
+  string       integrator   = "euler"; // tow and cable integrator
+  bool         fixed_kernels = true; // node-count specialized cable kernels
+  string       precision    = "double"; // eval path: double or float
+  double       sdf_cell     = 0;    // distance grid cell size (0 = off)
+  double       sdf_range    = 50;   // distance grid range beyond the poly
+  string       surrogate    = "";   // surrogate table file ("" = generate)
+  unsigned int threads      = 8;    // threads mode: largest thread count
 
   // Simple arg parsing: --key=value
   for(int i = 1; i < argc; i++) {
@@ -68,6 +103,38 @@ int main(int argc, char *argv[])
       cable_dyn = (string(arg.substr(12)) != "false" && string(arg.substr(12)) != "0");
     else if(arg.find("--side_lock=") == 0)
       side_lock = arg.substr(12);
+    else if(arg.find("--reach_prune=") == 0)
+      reach_prune = (string(arg.substr(14)) != "false" && string(arg.substr(14)) != "0");
+    else if(arg.find("--obs_x=") == 0)
+      obs_x = atof(arg.substr(8).c_str());
+    else if(arg.find("--obs_y=") == 0)
+      obs_y = atof(arg.substr(8).c_str());
+    else if(arg.find("--obs_w=") == 0)
+      obs_w = atof(arg.substr(8).c_str());
+    else if(arg.find("--obs_h=") == 0)
+      obs_h = atof(arg.substr(8).c_str());
+    else if(arg.find("--mode=") == 0)
+      mode = arg.substr(7);
+    else if(arg.find("--ref_dt=") == 0)
+      ref_dt = atof(arg.substr(9).c_str());
+    else if(arg.find("--swept=") == 0)
+      swept = (string(arg.substr(8)) != "false" && string(arg.substr(8)) != "0");
+    else if(arg.find("--adapt_max_dt=") == 0)
+      adapt_max_dt = atof(arg.substr(15).c_str());
+    else if(arg.find("--integrator=") == 0)
+      integrator = arg.substr(13);
+    else if(arg.find("--fixed_kernels=") == 0)
+      fixed_kernels = (string(arg.substr(16)) != "false" && string(arg.substr(16)) != "0");
+    else if(arg.find("--precision=") == 0)
+      precision = arg.substr(12);
+    else if(arg.find("--sdf_cell=") == 0)
+      sdf_cell = atof(arg.substr(11).c_str());
+    else if(arg.find("--sdf_range=") == 0)
+      sdf_range = atof(arg.substr(12).c_str());
+    else if(arg.find("--surrogate=") == 0)
+      surrogate = arg.substr(12);
+    else if(arg.find("--threads=") == 0)
+      threads = atoi(arg.substr(10).c_str());
     else {
       cout << "Usage: aof_bench [options]" << endl;
       cout << "  --crs_pts=N       course domain points  (default 360)" << endl;
@@ -82,10 +149,49 @@ int main(int argc, char *argv[])
       cout << "  --turn_rate=D     turn rate max deg/s    (default 15)" << endl;
       cout << "  --cable_dyn=B     full cable dynamics    (default true)" << endl;
       cout << "  --side_lock=S     side lock (port/star)  (default off)" << endl;
+      cout << "  --reach_prune=B   reachability pruning   (default true)" << endl;
+      cout << "  --obs_x=X         obstacle corner x      (default 50)" << endl;
+      cout << "  --obs_y=Y         obstacle corner y      (default 50)" << endl;
+      cout << "  --obs_w=W         obstacle width m       (default 5)"  << endl;
+      cout << "  --obs_h=H         obstacle height m      (default 5)"  << endl;
+      cout << "  --mode=M          aof, polydist, swept, step, integrator," << endl;
+      cout << "                    precision, cache, anytime, cascade," << endl;
+      cout << "                    surrogate, tractrix, bounds, field," << endl;
+      cout << "                    trajcache, threads, towdyn" << endl;
+      cout << "                    (default aof)" << endl;
+      cout << "  --ref_dt=T        reference dt of the swept, step and" << endl;
+      cout << "                    integrator modes (default 0.02)" << endl;
+      cout << "  --swept=B         swept contact checks   (default false)" << endl;
+      cout << "  --adapt_max_dt=T  adaptive step cap s    (default 0=off)" << endl;
+      cout << "  --integrator=S    euler, semi_implicit, rk2, rk4" << endl;
+      cout << "                    (default euler)" << endl;
+      cout << "  --fixed_kernels=B fixed node-count cable kernels (default true)" << endl;
+      cout << "  --precision=S     double or float eval   (default double)" << endl;
+      cout << "  --sdf_cell=H      distance grid cell m   (default 0=off)" << endl;
+      cout << "  --sdf_range=R     distance grid range m  (default 50)" << endl;
+      cout << "  --surrogate=FILE  surrogate table for --mode=surrogate" << endl;
+      cout << "                    (default: generate one)" << endl;
+      cout << "  --threads=N       largest thread count of --mode=threads" << endl;
+      cout << "                    (default 8, 0=hardware threads)" << endl;
       return 0;
     }
   }
 
+  if(mode == "polydist")
+    return(runPolyDistBench(reps, sdf_cell, sdf_range));
+  if(mode == "towdyn")
+    return(runTowDynBench(reps));
+
+  TowIntegrator integ_method;
+  if(!towIntegratorFromString(integrator, integ_method)) {
+    cout << "Unknown integrator: " << integrator << endl;
+    return 1;
+  }
+  if((precision != "double") && (precision != "float")) {
+    cout << "Unknown precision: " << precision << endl;
+    return 1;
+  }
+
   // -----------------------------------------------------------
   // 1) Build the IvP domain
   // -----------------------------------------------------------
@@ -104,10 +210,20 @@ int main(int argc, char *argv[])
        << "steps/eval: " << (int)ceil(sim_hz / sim_dt) << endl;
   cout << "Cable: len=" << cable_len << " m, check_interval=" << cable_check
        << ", start_node=" << cable_start
-       << ", nodes=" << (cable_len < 30 ? 3 : max(3, (int)(cable_len / 10.0))) << endl;
+       << ", nodes=" << towCableNodes(cable_len) << endl;
   cout << "Turn rate max: " << turn_rate << " deg/s" << endl;
   cout << "Cable dynamics: " << (cable_dyn ? "full" : "relaxed") << endl;
   cout << "Side lock: " << (side_lock.empty() ? "off" : side_lock) << endl;
+  cout << "Reach prune: " << (reach_prune ? "on" : "off") << endl;
+  cout << "Swept checks: " << (swept ? "on" : "off") << endl;
+  cout << "Adaptive step: ";
+  if(adapt_max_dt > 0)
+    cout << "up to " << adapt_max_dt << " s" << endl;
+  else
+    cout << "off" << endl;
+  cout << "Integrator: " << towIntegratorName(integ_method) << endl;
+  cout << "Obstacle: " << obs_w << "x" << obs_h << " m box at ("
+       << obs_x << "," << obs_y << ")" << endl;
   cout << "Reps: " << reps << endl;
 
   // -----------------------------------------------------------
@@ -119,12 +235,8 @@ int main(int argc, char *argv[])
   obm.setMaxUtilCPA(5.0);
   obm.setAllowableTTC(15.0);
 
-  // Simple square obstacle ahead of ownship
-  XYPolygon obs;
-  obs.add_vertex(50, 50);
-  obs.add_vertex(55, 50);
-  obs.add_vertex(55, 55);
-  obs.add_vertex(50, 55);
+  // Simple box obstacle ahead of ownship
+  XYPolygon obs = benchBox(obs_x, obs_y, obs_w, obs_h);
   obm.setGutPoly(obs);
   obm.setCachedVals(true);
 
@@ -136,7 +248,7 @@ int main(int argc, char *argv[])
 
   aof.setTowEval(true);
   aof.setTowOnly(true);
-  aof.setTowState(-25, -10, 0.5, 0.3);
+  aof.setTowState(BENCH_TOW_X, BENCH_TOW_Y, BENCH_TOW_VX, BENCH_TOW_VY);
   aof.setTowDynParams(cable_len, 5, 5.0, 0.7, 2.0);
   aof.setSimParams(sim_dt, sim_hz, turn_rate);
   aof.setCableCheckInterval(cable_check);
@@ -144,6 +256,19 @@ int main(int argc, char *argv[])
   aof.setUseCableDynamics(cable_dyn);
   if(!side_lock.empty())
     aof.setSideLock(side_lock);
+  aof.setReachPrune(reach_prune);
+  aof.setSweptCheck(swept);
+  aof.setAdaptiveStep(adapt_max_dt);
+  aof.setIntegrator(integ_method);
+  aof.setFixedCableKernels(fixed_kernels);
+  aof.setFloatEval(precision == "float");
+  if(sdf_cell > 0) {
+    shared_ptr<const PolySDFGrid> grid = PolySDFGrid::get(obs, sdf_cell, sdf_range);
+    aof.setDistanceGrid(grid);
+    if(grid)
+      cout << "Distance grid: " << grid->cols() << "x" << grid->rows()
+           << " cells, max error " << grid->maxError() << " m" << endl;
+  }
 
   bool ok = aof.initialize();
   if(!ok) {
@@ -151,6 +276,54 @@ int main(int argc, char *argv[])
     return 1;
   }
   cout << "AOF initialized successfully." << endl;
+  cout << "Cable kernels: "
+       << (aof.usingFixedCableKernels() ? "fixed node count" : "generic")
+       << endl;
+  cout << "Precision: " << (aof.usingFloatEval() ? "float" : "double");
+  if((precision == "float") && !aof.usingFloatEval())
+    cout << " (float path unavailable for this configuration)";
+  cout << endl;
+  if(aof.getModeConflicts() != "")
+    cout << "Mode conflicts: " << aof.getModeConflicts() << endl;
+
+  if(mode == "swept")
+    return(runSweptBench(aof, domain, sim_hz, turn_rate, ref_dt));
+  if(mode == "step")
+    return(runStepBench(aof, domain, sim_dt, sim_hz, turn_rate, ref_dt));
+  if(mode == "integrator")
+    return(runIntegratorBench(aof, domain, sim_hz, turn_rate, ref_dt));
+  if(mode == "precision")
+    return(runPrecisionBench(aof, domain, reps));
+  if(mode == "cache")
+    return(runCacheBench(aof, obm, domain, reps));
+  if(mode == "anytime")
+    return(runAnytimeBench(aof, domain, sim_dt, sim_hz, turn_rate, cable_dyn,
+                           integ_method, 5.0, 2.0));
+  if(mode == "cascade")
+    return(runCascadeBench(aof, domain, reps));
+  if(mode == "surrogate") {
+    TowSurrogateConfig cfg;
+    cfg.integrator    = integ_method;
+    cfg.sim_dt        = sim_dt;
+    cfg.turn_rate     = turn_rate;
+    cfg.cable_length  = cable_len;
+    cfg.attach_offset = 5;
+    cfg.k_spring      = 5.0;
+    cfg.cd            = 0.7;
+    cfg.c_tan         = 2.0;
+    return(runSurrogateBench(aof, obm, domain, cfg, sim_hz, surrogate,
+                             reps));
+  }
+  if(mode == "tractrix")
+    return(runTractrixBench(aof, obm, domain, cable_len, 5, reps));
+  if(mode == "bounds")
+    return(runBoundsBench(aof, obm, domain, cable_len, 5, reps));
+  if(mode == "field")
+    return(runFieldBench(aof, obm, domain, reps));
+  if(mode == "trajcache")
+    return(runTrajCacheBench(aof, obm, domain, reps));
+  if(mode == "threads")
+    return(runThreadBench(aof, domain, reps, threads));
 
   // -----------------------------------------------------------
   // 4) Time the full-domain sweep
@@ -166,6 +339,10 @@ int main(int argc, char *argv[])
   cout << flush;
 
   MBTimer timer;
+  unsigned long allocs_before = benchAllocCount();
+  unsigned int  pruned_before = aof.getReachPruned();
+  unsigned long steps_before  = aof.getSimSteps();
+  unsigned long dists_before  = aof.getDistQueries();
   timer.start();
 
   for(int r = 0; r < reps; r++) {
@@ -179,20 +356,157 @@ int main(int argc, char *argv[])
   }
 
   timer.stop();
+  unsigned long sweep_allocs = benchAllocCount() - allocs_before;
+  unsigned int  sweep_pruned = aof.getReachPruned() - pruned_before;
+  unsigned long sweep_steps  = aof.getSimSteps() - steps_before;
+  unsigned long sweep_dists  = aof.getDistQueries() - dists_before;
   delete box;
 
+  float elapsed = timer.get_float_wall_time();
+
   // -----------------------------------------------------------
-  // 5) Report results
+  // 5) Time the sweep through evalBox() and the batched (SIMD)
+  //    path with reach pruning off, so both run the forward sim
+  //    for every candidate. Candidates are laid out course-major
+  //    with speed varying fastest, so neighbouring speeds share a
+  //    batch.
+  // -----------------------------------------------------------
+  unsigned int dom_pts = num_crs * num_spd;
+  vector<double> crs_vals(dom_pts), spd_vals(dom_pts);
+  vector<double> box_utils(dom_pts), full_utils(dom_pts);
+  vector<double> batch_utils(dom_pts);
+  for(unsigned int ci = 0; ci < num_crs; ci++) {
+    for(unsigned int si = 0; si < num_spd; si++) {
+      domain.getVal(crs_ix, ci, crs_vals[ci*num_spd + si]);
+      domain.getVal(spd_ix, si, spd_vals[ci*num_spd + si]);
+    }
+  }
+
+  AOF_TowObstacleAvoid aof_full = aof;
+  aof_full.setReachPrune(false);
+  aof_full.initialize();
+
+  MBTimer full_timer;
+  box = new IvPBox(2);
+  full_timer.start();
+  for(int r = 0; r < reps; r++) {
+    for(unsigned int ci = 0; ci < num_crs; ci++) {
+      for(unsigned int si = 0; si < num_spd; si++) {
+        box->setPTS(crs_ix, ci, ci);
+        box->setPTS(spd_ix, si, si);
+        full_utils[ci*num_spd + si] = aof_full.evalBox(box);
+      }
+    }
+  }
+  full_timer.stop();
+  delete box;
+  float full_elapsed = full_timer.get_float_wall_time();
+
+  MBTimer batch_timer;
+  batch_timer.start();
+  for(int r = 0; r < reps; r++)
+    aof_full.evalBatch(&crs_vals[0], &spd_vals[0], dom_pts, &batch_utils[0]);
+  batch_timer.stop();
+  float batch_elapsed = batch_timer.get_float_wall_time();
+
+  // Utilities of the pruning AOF over the domain
+  box = new IvPBox(2);
+  for(unsigned int ci = 0; ci < num_crs; ci++) {
+    for(unsigned int si = 0; si < num_spd; si++) {
+      box->setPTS(crs_ix, ci, ci);
+      box->setPTS(spd_ix, si, si);
+      box_utils[ci*num_spd + si] = aof.evalBox(box);
+    }
+  }
+  delete box;
+
+  // Pruning must be exact: compare against the full simulation.
+  // Pruned candidates keep double utilities in float mode, so
+  // there they may differ from the float sim by its rounding.
+  double prune_tol = aof.usingFloatEval() ? 1e-3 : 0;
+  unsigned int prune_mismatch = 0, prune_bad = 0;
+  double prune_max_diff = 0;
+  for(unsigned int i = 0; i < dom_pts; i++) {
+    double diff = fabs(full_utils[i] - box_utils[i]);
+    if(diff != 0)
+      prune_mismatch++;
+    if(diff > prune_tol)
+      prune_bad++;
+    prune_max_diff = max(prune_max_diff, diff);
+  }
+
+  // With a distance grid, compare against exact edge distances
+  unsigned int grid_mismatch = 0;
+  double grid_max_diff = 0;
+  if(sdf_cell > 0) {
+    AOF_TowObstacleAvoid aof_exact = aof;
+    aof_exact.setDistanceGrid(shared_ptr<const PolySDFGrid>());
+    aof_exact.initialize();
+    box = new IvPBox(2);
+    for(unsigned int ci = 0; ci < num_crs; ci++) {
+      for(unsigned int si = 0; si < num_spd; si++) {
+        box->setPTS(crs_ix, ci, ci);
+        box->setPTS(spd_ix, si, si);
+        double diff = fabs(aof_exact.evalBox(box) - box_utils[ci*num_spd + si]);
+        if(diff != 0)
+          grid_mismatch++;
+        grid_max_diff = max(grid_max_diff, diff);
+      }
+    }
+    delete box;
+  }
+
+  unsigned int batch_mismatch = 0;
+  double batch_max_diff = 0;
+  for(unsigned int i = 0; i < dom_pts; i++) {
+    double diff = fabs(full_utils[i] - batch_utils[i]);
+    if(diff != 0)
+      batch_mismatch++;
+    batch_max_diff = max(batch_max_diff, diff);
+  }
+
+  // -----------------------------------------------------------
+  // 6) Report results
   // -----------------------------------------------------------
-  float elapsed = timer.get_float_wall_time();
   double evals_per_sec = (elapsed > 0) ? total_evals / (double)elapsed : 0;
+  double batch_per_sec = (batch_elapsed > 0) ? total_evals / (double)batch_elapsed : 0;
 
   cout << "---------------------------------------" << endl;
   cout << "Total evals:   " << total_evals << endl;
   cout << "Wall time:     " << elapsed << " sec" << endl;
   cout << "Evals/sec:     " << (long)evals_per_sec << endl;
   cout << "Time per eval: " << (elapsed / total_evals) * 1e6 << " us" << endl;
+  cout << "Heap allocs:   " << sweep_allocs << " ("
+       << ((double)sweep_allocs / total_evals) << " per eval)" << endl;
+  cout << "Reach pruned:  " << sweep_pruned << " ("
+       << (100.0 * sweep_pruned / total_evals) << "%)" << endl;
+  cout << "Sim steps:     " << sweep_steps << " ("
+       << ((double)sweep_steps / total_evals) << " per eval)" << endl;
+  cout << "Dist queries:  " << sweep_dists << " ("
+       << ((double)sweep_dists / total_evals) << " per eval)" << endl;
+  cout << "Prune vs full: " << prune_mismatch << " of " << dom_pts
+       << " differ, max diff " << prune_max_diff;
+  if(prune_tol > 0)
+    cout << " (" << prune_bad << " over " << prune_tol << ")";
+  cout << endl;
+  if(sdf_cell > 0) {
+    cout << "Grid vs exact: " << grid_mismatch << " of " << dom_pts
+         << " differ, max diff " << grid_max_diff << endl;
+    cout << "Grid cache:    " << PolySDFGrid::cacheHits() << " hits, "
+         << PolySDFGrid::cacheMisses() << " misses" << endl;
+  }
+  cout << "---------------------------------------" << endl;
+  cout << "Batch path:    " << AOF_TowObstacleAvoid::batchSimdPath() << endl;
+  cout << "Unpruned time: " << full_elapsed << " sec (evalBox)" << endl;
+  cout << "Batch time:    " << batch_elapsed << " sec" << endl;
+  cout << "Batch evals/s: " << (long)batch_per_sec << endl;
+  cout << "Batch speedup: " << ((batch_elapsed > 0) ? full_elapsed / batch_elapsed : 0) << "x" << endl;
+  cout << "Batch vs box:  " << batch_mismatch << " of " << dom_pts
+       << " differ, max diff " << batch_max_diff << endl;
   cout << "---------------------------------------" << endl;
 
-  return 0;
+  // Neither pruning nor batching may change a utility
+  if((prune_bad > 0) || (batch_mismatch > 0))
+    return(1);
+  return(0);
 }
@@ -0,0 +1,121 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: main.cpp (tow surrogate table generator)        */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Writes a TowSurrogate table for BHV_TowObstacleAvoid's   */
+/* surrogate_table parameter. The tow params, sim step,     */
+/* horizon, turn rate and integrator must match the ones    */
+/* the behavior runs with (pTowing's TOW_* postings and the */
+/* behavior's sim params), or the behavior simulates live.  */
+/************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "MBTimer.h"
+#include "TowSurrogateGen.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  string out = "tow_surrogate.tsg";
+  double horizon = 25.0;
+  string integrator = "euler";
+
+  TowSurrogateConfig cfg;
+  cfg.sim_dt        = 0.1;
+  cfg.turn_rate     = 15.0;
+  cfg.cable_length  = 30;
+  cfg.attach_offset = 0;
+  cfg.k_spring      = 5;
+  cfg.cd            = 0.7;
+  cfg.c_tan         = 2.0;
+
+  TowSurrogateGrid grid;
+  double crs_step = 360.0 / grid.n_off;
+
+  for(int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    if(arg.find("--out=") == 0)
+      out = arg.substr(6);
+    else if(arg.find("--sim_dt=") == 0)
+      cfg.sim_dt = atof(arg.substr(9).c_str());
+    else if(arg.find("--sim_horizon=") == 0)
+      horizon = atof(arg.substr(14).c_str());
+    else if(arg.find("--turn_rate=") == 0)
+      cfg.turn_rate = atof(arg.substr(12).c_str());
+    else if(arg.find("--cable_len=") == 0)
+      cfg.cable_length = atof(arg.substr(12).c_str());
+    else if(arg.find("--attach=") == 0)
+      cfg.attach_offset = atof(arg.substr(9).c_str());
+    else if(arg.find("--k_spring=") == 0)
+      cfg.k_spring = atof(arg.substr(11).c_str());
+    else if(arg.find("--cd=") == 0)
+      cfg.cd = atof(arg.substr(5).c_str());
+    else if(arg.find("--c_tan=") == 0)
+      cfg.c_tan = atof(arg.substr(8).c_str());
+    else if(arg.find("--integrator=") == 0)
+      integrator = arg.substr(13);
+    else if(arg.find("--crs_step=") == 0)
+      crs_step = atof(arg.substr(11).c_str());
+    else if(arg.find("--spd_pts=") == 0)
+      grid.n_spd = atoi(arg.substr(10).c_str());
+    else if(arg.find("--spd_max=") == 0)
+      grid.spd_max = atof(arg.substr(10).c_str());
+    else if(arg.find("--v0_pts=") == 0)
+      grid.n_v0 = atoi(arg.substr(9).c_str());
+    else if(arg.find("--v0_max=") == 0)
+      grid.v0_max = atof(arg.substr(9).c_str());
+    else {
+      cout << "Usage: tow_surrogate [options]" << endl;
+      cout << "  --out=FILE        table file   (default tow_surrogate.tsg)" << endl;
+      cout << "  --sim_dt=T        sim time step          (default 0.1)" << endl;
+      cout << "  --sim_horizon=T   sim horizon seconds    (default 25)" << endl;
+      cout << "  --turn_rate=D     turn rate max deg/s    (default 15)" << endl;
+      cout << "  --cable_len=L     cable length meters    (default 30)" << endl;
+      cout << "  --attach=A        attach offset meters   (default 0)" << endl;
+      cout << "  --k_spring=K      spring stiffness       (default 5)" << endl;
+      cout << "  --cd=C            drag coefficient       (default 0.7)" << endl;
+      cout << "  --c_tan=C         tangential damping     (default 2)" << endl;
+      cout << "  --integrator=S    euler, semi_implicit, rk2, rk4" << endl;
+      cout << "  --crs_step=D      course offset step deg (default 5)" << endl;
+      cout << "  --spd_pts=N       speed points           (default 13)" << endl;
+      cout << "  --spd_max=V       max speed m/s          (default 3)" << endl;
+      cout << "  --v0_pts=N        initial tow speeds     (default 7)" << endl;
+      cout << "  --v0_max=V        max initial tow speed  (default 3)" << endl;
+      return(0);
+    }
+  }
+
+  if(!towIntegratorFromString(integrator, cfg.integrator)) {
+    cout << "Unknown integrator: " << integrator << endl;
+    return(1);
+  }
+  if(!(crs_step > 0) || (crs_step > 180)) {
+    cout << "crs_step must be in (0,180]" << endl;
+    return(1);
+  }
+  grid.n_off = (unsigned int)(360.0 / crs_step + 0.5);
+
+  MBTimer timer;
+  timer.start();
+  vector<float> data;
+  string err;
+  if(!towSurrogateGenerate(cfg, horizon, grid, data, err) ||
+     !TowSurrogate::write(out, cfg, grid, data, err)) {
+    cout << "Failed: " << err << endl;
+    return(1);
+  }
+  timer.stop();
+
+  cout << "Wrote " << out << ": " << grid.n_off << " course offsets x "
+       << grid.n_spd << " speeds x " << grid.n_v0 << " tow speeds, "
+       << cfg.steps << " steps, " << cfg.num_nodes << " cable nodes, "
+       << (data.size() * sizeof(float)) / (1024.0 * 1024.0) << " MB in "
+       << timer.get_float_wall_time() << " s" << endl;
+  return(0);
+}
@@ -15,8 +15,10 @@
 #include <cmath>
 #include <string>
 #include <algorithm>
+#include <chrono>
 #include "AOF_TowObstacleAvoid.h"
 #include "AngleUtils.h"
+#include "TowSimd.h"
 
 using namespace std;
 
@@ -55,16 +57,118 @@ AOF_TowObstacleAvoid::AOF_TowObstacleAvoid(IvPDomain gdomain) :
 
   // Cable avoidance
   m_use_cable_dynamics = true;
-  m_cable_sample_step = 1.0;
   m_cable_check_interval = 5;
   m_cable_start_node = 0;
 
+  // Reachability pruning (exact, on by default)
+  m_reach_prune = true;
+
+  // Swept contact checks (off by default)
+  m_swept_check = false;
+
+  // Adaptive time step (off by default)
+  m_adapt_max_dt = 0;
+
+  // Tow and cable integrator (pTowing's explicit Euler by default)
+  m_integrator = TOW_INT_EULER;
+
+  // Node-count specialized cable kernels (on by default)
+  m_fixed_kernels  = true;
+  m_cable_step_fn  = 0;
+  m_cable_relax_fn = 0;
+
+  m_eval_cache = 0;
+
+  m_has_deadline = false;
+  m_expired      = false;
+
+  // Relaxed-cable screening off by default
+  m_cascade           = false;
+  m_cascade_band      = 1.0;
+  m_cascade_gap       = 0;
+  m_cascade_ok        = false;
+  m_init_relaxed_dist = 1e9;
+  m_cascade_screened  = 0;
+  m_cascade_escalated = 0;
+
+  // No surrogate table by default
+  m_surr_pos_tol   = 1.0;
+  m_surr_vel_tol   = 0.2;
+  m_surr_ok        = false;
+  m_surr_v0        = 0;
+  m_surr_fc        = 1;
+  m_surr_fs        = 0;
+  m_surr_served    = 0;
+  m_surr_fallbacks = 0;
+
+  m_tractrix      = false;
+  m_trx_pos_tol   = 0.5;
+  m_trx_vel_tol   = 0.3;
+  m_trx_min_v0    = 1.0;
+  m_trx_cpa_margin = 1.0;
+  m_trx_spd_margin = 0.25;
+  m_trx_ok        = false;
+  m_trx_ex        = 1;
+  m_trx_ey        = 0;
+  m_trx_v0        = 0;
+  m_trx_served    = 0;
+  m_trx_fallbacks = 0;
+  m_bound_boxes   = 0;
+
+  m_traj_cache    = false;
+  m_traj_stamp    = 0;
+  m_traj_max_mb   = 32;
+  m_traj_ok       = false;
+  m_traj_pts      = 0;
+  m_traj_ox       = 0;
+  m_traj_oy       = 0;
+  m_traj_hits     = 0;
+  m_traj_misses   = 0;
+  m_traj_live     = 0;
+
+  m_recording     = false;
+  m_build_memo    = false;
+  m_pt_calls      = 0;
+  m_pt_served     = 0;
+  m_pt_dups       = 0;
+  m_dist_merged   = 0;
+
+  // Double precision evaluation by default
+  m_float_eval      = false;
+  m_float_ok        = false;
+  m_float_ox        = 0;
+  m_float_oy        = 0;
+  m_fcable_step_fn  = 0;
+  m_fcable_relax_fn = 0;
+
   // Tow speed penalty (disabled by default)
   m_penalize_low_tow_spd = true;
   m_tow_spd_min          = 1.0;
   m_tow_spd_hard_min     = 0.0;
   m_tow_spd_power        = 2.0;
   m_tow_spd_floor        = 0.25;
+
+  // Prepared eval context (built in initialize())
+  m_prepared      = false;
+  m_static_only   = false;
+  m_steps         = 0;
+  m_num_nodes     = 3;
+  m_rest_length   = 0;
+  m_start_node    = 0;
+  m_ax0           = 0;
+  m_ay0           = 0;
+  m_bng_to_ob     = 0;
+  m_init_min_dist = 1e9;
+  m_prof_stride   = 0;
+  m_reach_ok      = false;
+  m_reach_thresh  = 0;
+  m_reach_margin  = 0;
+  m_init_tow_dist = 0;
+  m_reach_checks  = 0;
+  m_reach_pruned  = 0;
+  m_adapt_ok      = false;
+  m_adapt_cap     = 0;
+  m_sim_steps     = 0;
 }
 
 //----------------------------------------------------------------
@@ -107,6 +211,9 @@ bool AOF_TowObstacleAvoid::initialize()
 
   if(!m_obship_model.getGutPoly().is_convex())
     return(postMsgAOF("m_obstacle is not convex"));
+  for(unsigned int i = 0; i < m_extra_guts.size(); i++)
+    if(!m_extra_guts[i].is_convex())
+      return(postMsgAOF("field obstacle is not convex"));
 
   // --- Tow state validation ---
   if(m_tow_eval) 
@@ -117,6 +224,607 @@ bool AOF_TowObstacleAvoid::initialize()
       return(postMsgAOF("tow_eval enabled but dyn params not set"));
   }
 
+  prepareEvalContext();
+  noteModeConflicts();
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: prepareEvalContext()
+//   Purpose: Build everything evalBox() needs that does not depend
+//            on the candidate (course, speed): the gut poly edges,
+//            horizon/step count, cable node layout, initial anchor,
+//            the initial straight-line cable and its obstacle range,
+//            and the scratch buffers reused by every evaluation.
+//      Note: Any setter called after initialize() requires another
+//            call to initialize() to take effect.
+
+void AOF_TowObstacleAvoid::prepareEvalContext()
+{
+  m_prepared = false;
+  m_expired  = false;
+  if(!m_tow_eval || !m_tow_pose_set || !m_dyn_params_set)
+    return;
+
+  m_gut.set(m_obship_model.getGutPoly());
+  m_gut.setGrid(m_dist_grid);
+  for(unsigned int i = 0; i < m_extra_guts.size(); i++)
+    m_gut.add(m_extra_guts[i], m_extra_grids[i]);
+  m_gut.clearQueries();
+  m_dist_merged = 0;
+
+  // Simulation horizon: use configured value or fall back to allowable_ttc.
+  // A value of -2 signals "static cable check only, no forward sim."
+  m_static_only = (m_sim_horizon < -1.5);
+  double T = 0;
+  if(!m_static_only)
+    T = (m_sim_horizon > 0) ? m_sim_horizon : m_obship_model.getAllowableTTC();
+  m_steps = (m_sim_dt > 1e-6) ? (int)ceil(T / m_sim_dt) : 0;
+
+  // Cable node layout, as in pCable
+  m_num_nodes = towCableNodes(m_cable_length);
+  m_rest_length = m_cable_length / (double)(m_num_nodes - 1);
+
+  // Cable kernels for this node count, std::vector path otherwise.
+  // The specialized step is the Euler update only, and only for the
+  // node counts where it is faster (see TowCableKernel.h).
+  m_cable_step_fn  = 0;
+  m_cable_relax_fn = 0;
+  if(m_fixed_kernels)
+    towCableKernels(m_num_nodes, m_cable_step_fn, m_cable_relax_fn);
+  if(m_integrator != TOW_INT_EULER)
+    m_cable_step_fn = 0;
+  m_cable_params.k_spring    = m_k_spring;
+  m_cable_params.cd          = m_cd;
+  m_cable_params.c_tan       = m_c_tan;
+  m_cable_params.rest_length = m_rest_length;
+  m_cable_params.cable_length = m_cable_length;
+
+  // Skip shallow cable nodes near surface when cable_start_node is set
+  m_start_node = std::min(m_cable_start_node, m_num_nodes - 1);
+
+  // Initial anchor point (stern attachment offset from vessel CG)
+  double osh = m_obship_model.getOSH();
+  double hdg_rad0 = (90.0 - osh) * M_PI / 180.0;
+  m_ax0 = m_obship_model.getOSX() - m_attach_offset * cos(hdg_rad0);
+  m_ay0 = m_obship_model.getOSY() - m_attach_offset * sin(hdg_rad0);
+
+  // Bearing from tow to obstacle centroid, used by the side lock
+  double cx = m_obship_model.getObcentX();
+  double cy = m_obship_model.getObcentY();
+  m_bng_to_ob = relAng(m_tow_x, m_tow_y, cx, cy);
+  m_extra_bng.clear();
+  for(unsigned int i = 0; i < m_extra_guts.size(); i++) {
+    double ecx = m_extra_guts[i].get_centroid_x();
+    double ecy = m_extra_guts[i].get_centroid_y();
+    m_extra_bng.push_back(relAng(m_tow_x, m_tow_y, ecx, ecy));
+  }
+
+  // Scratch buffers, sized once and reused by every evaluation
+  m_nx.assign(m_num_nodes, 0.0);
+  m_ny.assign(m_num_nodes, 0.0);
+  m_nvx.assign(m_num_nodes, 0.0);
+  m_nvy.assign(m_num_nodes, 0.0);
+  m_rx.assign(m_num_nodes, 0.0);
+  m_ry.assign(m_num_nodes, 0.0);
+  m_sx.assign(m_num_nodes, 0.0);
+  m_sy.assign(m_num_nodes, 0.0);
+  m_bnx.assign(m_num_nodes * 4, 0.0);
+  m_bny.assign(m_num_nodes * 4, 0.0);
+  m_bnvx.assign(m_num_nodes * 4, 0.0);
+  m_bnvy.assign(m_num_nodes * 4, 0.0);
+
+  // Initial straight-line cable from anchor to tow
+  m_init_nx.resize(m_num_nodes);
+  m_init_ny.resize(m_num_nodes);
+  for(int i = 0; i < m_num_nodes; i++) {
+    double t = (double)i / (double)(m_num_nodes - 1);
+    m_init_nx[i] = m_ax0 + t * (m_tow_x - m_ax0);
+    m_init_ny[i] = m_ay0 + t * (m_tow_y - m_ay0);
+  }
+
+  buildHeadingProfiles();
+
+  m_prepared = true;
+
+  // Range of the initial cable shape to the obstacle. Identical for
+  // every candidate, so the step-0 contact check is done only once.
+  // Swept checks measure the cable segments rather than the nodes.
+  m_init_min_dist = 1e9;
+  if(m_swept_check) {
+    if(m_use_cable_dynamics)
+      m_init_min_dist = cableSegMinDist(m_init_nx, m_init_ny);
+    else {
+      relaxCable(m_ax0, m_ay0, m_tow_x, m_tow_y, m_rx, m_ry);
+      m_init_min_dist = cableSegMinDist(m_rx, m_ry);
+    }
+  }
+  else if(m_use_cable_dynamics) {
+    for(int i = m_start_node; i < m_num_nodes; i++) {
+      double ds = m_gut.dist(m_init_nx[i], m_init_ny[i]);
+      if(ds < 0) ds = 0;
+      m_init_min_dist = std::min(m_init_min_dist, ds);
+      if(m_init_min_dist <= 0)
+        break;
+    }
+  }
+  else {
+    double d = cableRelaxedMinDist(m_ax0, m_ay0, m_tow_x, m_tow_y);
+    m_init_min_dist = std::min(m_init_min_dist, d);
+  }
+
+  // Reachability pruning needs a tethered tow, a forward sim, and
+  // an initial cable already beyond the max utility range
+  double maxu = m_obship_model.getMaxUtilCPA();
+  m_reach_thresh  = std::max(maxu, 1e-6);
+  m_reach_margin  = m_gut.gridError();
+  m_init_tow_dist = std::max(0.0, m_gut.exactDist(m_tow_x, m_tow_y));
+  m_reach_ok = (m_cable_length > 0) && (m_steps > 0) && (m_prof_stride > 0)
+    && (m_init_min_dist >= m_reach_thresh);
+  m_reach_checks = 0;
+  m_reach_pruned = 0;
+
+  // Adaptive steps need a tethered tow and the heading profile
+  // (steps only grow once the heading has settled). The cap keeps
+  // the integrator stable: for Euler, an interior cable node between
+  // two stretched springs needs h < 2/sqrt(2k) (taken at 3/4 of
+  // that), and tangential damping stays monotone for c_tan*h <= 1
+  // (see towStableStep()). The drag limit depends on speed and is
+  // applied per step.
+  m_adapt_cap = m_adapt_max_dt;
+  double h_stable = towStableStep(m_integrator, m_k_spring, m_c_tan);
+  if(h_stable > 0)
+    m_adapt_cap = std::min(m_adapt_cap, h_stable);
+  m_adapt_ok = (m_adapt_cap >= 2 * m_sim_dt) && (m_cable_length > 0)
+    && (m_steps > 0) && (m_prof_stride > 0);
+
+  // The float path covers the fixed-step Euler sim with the heading
+  // profile, a convex gut poly and a node count with fixed kernels
+  // (at most TOW_CABLE_MAX_N, as its nodes live on the stack).
+  // Its frame is centered on the initial ownship position so float
+  // coordinates stay small over the horizon.
+  m_float_ok = false;
+  if(m_float_eval && !m_adapt_ok && !m_swept_check && (m_cable_length > 0)
+     && (m_steps > 0) && (m_prof_stride > 0)
+     && (m_integrator == TOW_INT_EULER)
+     && towCableKernels(m_num_nodes, m_fcable_step_fn, m_fcable_relax_fn)) {
+    m_float_ox = m_obship_model.getOSX();
+    m_float_oy = m_obship_model.getOSY();
+    m_float_ok = m_gut.setLocalFrame(m_float_ox, m_float_oy);
+    m_fcable_params.k_spring     = (float)m_k_spring;
+    m_fcable_params.cd           = (float)m_cd;
+    m_fcable_params.c_tan        = (float)m_c_tan;
+    m_fcable_params.rest_length  = (float)m_rest_length;
+    m_fcable_params.cable_length = (float)m_cable_length;
+  }
+
+  // Relaxed-cable screening applies to full cable dynamics with the
+  // fixed-step sim; it needs the relaxed model's initial range and
+  // the gap between the two cable models for this state
+  m_cascade_ok = m_cascade && m_use_cable_dynamics && !m_adapt_ok &&
+    !m_float_ok && !m_swept_check && (m_steps > 0);
+  m_init_relaxed_dist = 1e9;
+  m_cascade_gap = 0;
+  if(m_cascade_ok) {
+    double d = cableRelaxedMinDist(m_ax0, m_ay0, m_tow_x, m_tow_y);
+    m_init_relaxed_dist = std::min(m_init_relaxed_dist, d);
+    m_cascade_gap = cascadeGap();
+  }
+  m_cascade_screened  = 0;
+  m_cascade_escalated = 0;
+
+  // The surrogate table serves this context if it was generated for
+  // the same config and the tow starts close to the table's initial
+  // state: taut astern of the attach point, moving along ownship
+  // heading. Checked in the frame of the initial ownship pose.
+  m_surr_ok = false;
+  m_surr_fc = cos(hdg_rad0);
+  m_surr_fs = sin(hdg_rad0);
+  m_surr_v0 = 0;
+  if(m_surrogate && !m_swept_check && (m_steps > 0) &&
+     (m_prof_stride > 0) && (m_cable_length > 0)) {
+    TowSurrogateConfig cfg;
+    cfg.num_nodes     = m_num_nodes;
+    cfg.steps         = m_steps;
+    cfg.integrator    = m_integrator;
+    cfg.sim_dt        = m_sim_dt;
+    cfg.turn_rate     = std::max(m_turn_rate_max, 0.0);
+    cfg.cable_length  = m_cable_length;
+    cfg.attach_offset = m_attach_offset;
+    cfg.k_spring      = m_k_spring;
+    cfg.cd            = m_cd;
+    cfg.c_tan         = m_c_tan;
+
+    double rx = m_tow_x - m_obship_model.getOSX();
+    double ry = m_tow_y - m_obship_model.getOSY();
+    double fx  =  rx * m_surr_fc + ry * m_surr_fs;
+    double fy  = -rx * m_surr_fs + ry * m_surr_fc;
+    double fvx =  m_tow_vx * m_surr_fc + m_tow_vy * m_surr_fs;
+    double fvy = -m_tow_vx * m_surr_fs + m_tow_vy * m_surr_fc;
+    double ref_x = -m_attach_offset - m_cable_length;
+    double v0_max = m_surrogate->v0Max();
+
+    m_surr_v0 = std::min(std::max(fvx, 0.0), v0_max);
+    m_surr_ok = m_surrogate->matches(cfg) &&
+      (towHypot(fx - ref_x, fy) <= m_surr_pos_tol) &&
+      (towHypot(fvx - m_surr_v0, fvy) <= m_surr_vel_tol);
+  }
+  m_surr_served    = 0;
+  m_surr_fallbacks = 0;
+
+  // The tractrix model needs the tow taut at the start, neither
+  // slack (pulled in by the spring) nor stretched past the cable,
+  // and moving along the cable rather than swinging across it or
+  // closing on the anchor. A slow tow is still being pulled up to
+  // speed, which the closed-form tow speed follows poorly.
+  m_trx_ok = false;
+  m_trx_ex = 1;
+  m_trx_ey = 0;
+  m_trx_v0 = 0;
+  if(m_tractrix && !m_swept_check && (m_steps > 0) &&
+     (m_prof_stride > 0) && (m_cable_length > 0)) {
+    double dx = m_ax0 - m_tow_x;
+    double dy = m_ay0 - m_tow_y;
+    double dist = towHypot(dx, dy);
+    if(dist > 0) {
+      m_trx_ex = dx / dist;
+      m_trx_ey = dy / dist;
+      double v_along  = m_tow_vx * m_trx_ex + m_tow_vy * m_trx_ey;
+      double v_across = m_tow_vy * m_trx_ex - m_tow_vx * m_trx_ey;
+      m_trx_v0 = v_along;
+      m_trx_ok = (fabs(dist - m_cable_length) <= m_trx_pos_tol) &&
+        (fabs(v_across) <= m_trx_vel_tol) && (v_along >= m_trx_min_v0);
+    }
+  }
+  m_trx_served    = 0;
+  m_trx_fallbacks = 0;
+
+  prepareTrajCache();
+
+  // Tow speeds memoized by evalBoxBounds() and tabled utilities
+  // belong to the old state
+  m_bound_tow_spd.clear();
+  m_rec_pts.clear();
+  m_pt_state.clear();
+  m_pt_util.clear();
+  if(m_build_memo) {
+    unsigned int n = m_domain.getVarPoints(m_crs_ix) *
+      m_domain.getVarPoints(m_spd_ix);
+    m_pt_state.assign(n, 0);
+    m_pt_util.assign(n, 0);
+  }
+  m_pt_calls  = 0;
+  m_pt_served = 0;
+  m_pt_dups   = 0;
+  m_sim_steps = 0;
+}
+
+//----------------------------------------------------------------
+// Procedure: noteModeConflicts()
+//   Purpose: Name the eval modes requested for this context that
+//            evalCandidate() bypasses because a mode it tries first
+//            is in use, so the owner can report them. Order:
+//              surrogate, tractrix   per candidate; later modes
+//                                    see only their fallbacks
+//              adaptive, float, cascade, trajectory cache
+//                                    per context; the first usable
+//                                    one serves every candidate
+
+void AOF_TowObstacleAvoid::noteModeConflicts()
+{
+  vector<string> notes;
+
+  if(m_surrogate && m_swept_check)
+    notes.push_back("surrogate is off with swept checks");
+  if(m_surr_ok) {
+    string later;
+    if(m_trx_ok)     later += ", tractrix";
+    if(m_adapt_ok)   later += ", adaptive steps";
+    if(m_float_ok)   later += ", float eval";
+    if(m_cascade_ok) later += ", cascade";
+    if(m_traj_ok)    later += ", trajectory cache";
+    if(later != "")
+      notes.push_back("surrogate serves candidates ahead of " +
+                      later.substr(2));
+  }
+
+  if(m_tractrix && m_swept_check)
+    notes.push_back("tractrix is off with swept checks");
+  if(m_trx_ok) {
+    string later;
+    if(m_adapt_ok)   later += ", adaptive steps";
+    if(m_float_ok)   later += ", float eval";
+    if(m_cascade_ok) later += ", cascade";
+    if(m_traj_ok)    later += ", trajectory cache";
+    if(later != "")
+      notes.push_back("tractrix serves candidates ahead of " +
+                      later.substr(2));
+  }
+
+  if(m_float_eval && !m_float_ok) {
+    if(m_adapt_ok)
+      notes.push_back("float eval is off with adaptive steps");
+    else if(m_swept_check)
+      notes.push_back("float eval is off with swept checks");
+  }
+
+  if(m_cascade && m_use_cable_dynamics && !m_cascade_ok) {
+    if(m_adapt_ok)
+      notes.push_back("cascade is off with adaptive steps");
+    else if(m_float_ok)
+      notes.push_back("cascade is off with float eval");
+    else if(m_swept_check)
+      notes.push_back("cascade is off with swept checks");
+  }
+
+  if(m_traj_cache && !m_traj_ok) {
+    if(m_adapt_ok)
+      notes.push_back("trajectory cache is off with adaptive steps");
+    else if(m_float_ok)
+      notes.push_back("trajectory cache is off with float eval");
+    else if(m_cascade_ok)
+      notes.push_back("trajectory cache is off with cascade");
+    else if(m_swept_check)
+      notes.push_back("trajectory cache is off with swept checks");
+  }
+
+  m_mode_conflicts.clear();
+  for(unsigned int i = 0; i < notes.size(); i++) {
+    if(i > 0)
+      m_mode_conflicts += "; ";
+    m_mode_conflicts += notes[i];
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: buildHeadingProfiles()
+//   Purpose: Tabulate cos/sin of the turn-rate-limited vessel
+//            heading at each sim step for every course in the
+//            domain. The heading never depends on the candidate
+//            speed, so this replaces (num speeds) x (steps) trig
+//            evaluations per course with one table row. Each row
+//            stops once the heading settles on the course.
+
+void AOF_TowObstacleAvoid::buildHeadingProfiles()
+{
+  m_prof_stride = 0;
+  m_prof_crs.clear();
+  m_prof_len.clear();
+  m_prof_cos.clear();
+  m_prof_sin.clear();
+  if(m_steps <= 0)
+    return;
+
+  // Worst case the heading swings 180 degrees before settling
+  double dt = m_sim_dt;
+  int stride = 1;
+  if(m_turn_rate_max > 0) {
+    double max_turn_steps = ceil(180.0 / (m_turn_rate_max * dt)) + 2;
+    stride = (int)std::min((double)m_steps, max_turn_steps);
+  }
+
+  unsigned int crs_pts = m_domain.getVarPoints(m_crs_ix);
+  m_prof_stride = stride;
+  m_prof_crs.assign(crs_pts, 0.0);
+  m_prof_len.assign(crs_pts, 0);
+  m_prof_cos.assign(crs_pts * stride, 0.0);
+  m_prof_sin.assign(crs_pts * stride, 0.0);
+
+  double osh = m_obship_model.getOSH();
+  for(unsigned int ix = 0; ix < crs_pts; ix++) {
+    double eval_crs = 0;
+    m_domain.getVal(m_crs_ix, ix, eval_crs);
+    m_prof_crs[ix] = eval_crs;
+
+    double *pc = &m_prof_cos[ix * stride];
+    double *ps = &m_prof_sin[ix * stride];
+    double vh = osh;
+    int len = 0;
+    for(int k = 0; k < stride; k++) {
+      if(m_turn_rate_max > 0) {
+        double diff = angleDiff(eval_crs, vh);
+        double step_deg = m_turn_rate_max * dt;
+        if(fabs(diff) <= step_deg)
+          vh = eval_crs;
+        else
+          vh = angle360(vh + (diff > 0 ? step_deg : -step_deg));
+      } else {
+        vh = eval_crs;
+      }
+      double hdg_rad = (90.0 - vh) * M_PI / 180.0;
+      pc[k] = cos(hdg_rad);
+      ps[k] = sin(hdg_rad);
+      if(vh == eval_crs) {
+        len = k + 1;
+        break;
+      }
+    }
+    // A row that covers the whole horizon needs no settling
+    if((len == 0) && (stride == m_steps))
+      len = stride;
+    m_prof_len[ix] = len;
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: headingProfile()
+//   Purpose: Find the tabulated heading profile for a course given
+//            in domain units. Returns the row length and sets pc/ps
+//            to the cos/sin rows, or returns 0 if the course is not
+//            a domain point (or its row did not settle).
+
+int AOF_TowObstacleAvoid::headingProfile(double eval_crs, const double *&pc,
+                                         const double *&ps) const
+{
+  if(m_prof_len.empty())
+    return(0);
+
+  double delta = m_domain.getVarDelta(m_crs_ix);
+  if(!(delta > 0))
+    return(0);
+
+  double fix = (eval_crs - m_domain.getVarLow(m_crs_ix)) / delta;
+  int ix = (int)floor(fix + 0.5);
+  if((ix < 0) || (ix >= (int)m_prof_len.size()))
+    return(0);
+  if((m_prof_crs[ix] != eval_crs) || (m_prof_len[ix] == 0))
+    return(0);
+
+  pc = &m_prof_cos[ix * m_prof_stride];
+  ps = &m_prof_sin[ix * m_prof_stride];
+  return(m_prof_len[ix]);
+}
+
+//----------------------------------------------------------------
+// Procedure: reachPrune()
+//   Purpose: Decide, without simulating the cable, that a candidate
+//            keeps the whole cable beyond max_util_cpa over the
+//            horizon. If so, sets util to the result the full
+//            simulation would give (umax, less any tow speed
+//            penalty) and returns true.
+//
+//   The bound: after any sim step each interior cable node lies
+//   within rest_length of its tow-side neighbour (the last pass of
+//   both the dynamic and relaxed cable is the backward constraint
+//   pass), so every checked point is within
+//   R = max(cable_length, |anchor - tow|) of the tow body. Only the
+//   vessel and tow are propagated (identically to evalCandidate(),
+//   which also yields the exact min tow speed for the penalty). The
+//   tow's range to the obstacle is bounded below by the range at a
+//   reference point minus the distance moved since (range is
+//   1-Lipschitz), with an exact query only when that bound gets
+//   too weak. Pruning is abandoned as soon as range - R drops below
+//   max_util_cpa (plus the distance grid error, if a grid is used,
+//   since the full simulation would see grid distances).
+//
+//   With swept checks the region between two steps is also
+//   covered: it lies in the hull of both cable shapes, so within
+//   the larger of the two R of the segment the tow moved along,
+//   i.e. within max(R, R_prev) + |tow - tow_prev| of the tow.
+//
+//   With adaptive steps the vessel and tow must take the same
+//   steps as in evalAdaptive(). Those depend on the cable's own
+//   clearance, which is not known here, but range - R is a lower
+//   bound on it: pruning is abandoned unless that bound already
+//   leaves the clearance limit of adaptiveMult() inactive, in
+//   which case both choose the same step. The exact tow range is
+//   queried every step.
+
+bool AOF_TowObstacleAvoid::reachPrune(double eval_crs, double eval_spd,
+                                      double &util) const
+{
+  if(!m_reach_prune || !m_reach_ok)
+    return(false);
+
+  const double *pc = 0;
+  const double *ps = 0;
+  int plen = headingProfile(eval_crs, pc, ps);
+  if(plen <= 0)
+    return(false);
+  m_reach_checks++;
+
+  double dt = m_sim_dt;
+  double vs = eval_spd;
+  double osx = m_obship_model.getOSX();
+  double osy = m_obship_model.getOSY();
+  double tx  = m_tow_x;
+  double ty  = m_tow_y;
+  double tvx = m_tow_vx;
+  double tvy = m_tow_vy;
+  double min_tow_spd = 1e9;
+
+  // Slack for rounding in the constraint passes
+  double margin = 1e-6 * (1 + m_cable_length);
+
+  double ref_x = tx;
+  double ref_y = ty;
+  double ref_d = m_init_tow_dist;
+
+  double prev_tx    = tx;
+  double prev_ty    = ty;
+  double prev_reach = std::max(m_cable_length, towHypot(m_ax0 - tx, m_ay0 - ty)) + margin;
+
+  if(m_adapt_ok) {
+    double clear_lb = m_init_tow_dist - prev_reach - m_reach_margin;
+    double accel = -1;
+    double tow_spd = towHypot(tvx, tvy);
+    int k = 0;
+    while(k < m_steps) {
+      int m = adaptiveMult(k, plen, 1e300, accel, tow_spd, vs);
+      if(adaptiveMult(k, plen, clear_lb, accel, tow_spd, vs) != m)
+        return(false);
+      double h = m * dt;
+      int j = (k < plen) ? k : plen - 1;
+      double hc = pc[j];
+      double hs = ps[j];
+      osx += vs * hc * h;
+      osy += vs * hs * h;
+      double ax = osx - m_attach_offset * hc;
+      double ay = osy - m_attach_offset * hs;
+
+      double pvx = tvx;
+      double pvy = tvy;
+      propagateTowOneStep(ax, ay, h, tx, ty, tvx, tvy);
+
+      tow_spd = towHypot(tvx, tvy);
+      if(tow_spd < min_tow_spd)
+        min_tow_spd = tow_spd;
+      accel = towHypot(tvx - pvx, tvy - pvy) / h;
+
+      double tow_d = std::max(0.0, m_gut.exactDist(tx, ty));
+      double reach = std::max(m_cable_length, towHypot(ax - tx, ay - ty)) + margin;
+      clear_lb = tow_d - reach - m_reach_margin;
+      if(m_swept_check) {
+        double span = std::max(reach, prev_reach) + towHypot(tx - prev_tx, ty - prev_ty);
+        prev_reach = reach;
+        prev_tx = tx;
+        prev_ty = ty;
+        reach = span;
+      }
+      if(tow_d - reach < m_reach_thresh + m_reach_margin)
+        return(false);
+      k += m;
+    }
+    m_reach_pruned++;
+    util = utilityFromSim(m_reach_thresh, -1, m_steps, min_tow_spd);
+    return(true);
+  }
+
+  for(int k = 0; k < m_steps; k++) {
+    int j = (k < plen) ? k : plen - 1;
+    double hc = pc[j];
+    double hs = ps[j];
+    osx += vs * hc * dt;
+    osy += vs * hs * dt;
+    double ax = osx - m_attach_offset * hc;
+    double ay = osy - m_attach_offset * hs;
+
+    propagateTowOneStep(ax, ay, dt, tx, ty, tvx, tvy);
+
+    double tow_spd = towHypot(tvx, tvy);
+    if(tow_spd < min_tow_spd)
+      min_tow_spd = tow_spd;
+
+    double reach = std::max(m_cable_length, towHypot(ax - tx, ay - ty)) + margin;
+    if(m_swept_check) {
+      double span = std::max(reach, prev_reach) + towHypot(tx - prev_tx, ty - prev_ty);
+      prev_reach = reach;
+      prev_tx = tx;
+      prev_ty = ty;
+      reach = span;
+    }
+    double bound = ref_d - towHypot(tx - ref_x, ty - ref_y) - reach;
+    if(bound < m_reach_thresh + m_reach_margin) {
+      ref_x = tx;
+      ref_y = ty;
+      ref_d = std::max(0.0, m_gut.exactDist(tx, ty));
+      if(ref_d - reach < m_reach_thresh + m_reach_margin)
+        return(false);
+    }
+  }
+
+  m_reach_pruned++;
+  util = utilityFromSim(m_reach_thresh, -1, m_steps, min_tow_spd);
   return(true);
 }
 
@@ -138,42 +846,292 @@ static double clamp01(double v)
 
 double AOF_TowObstacleAvoid::evalBox(const IvPBox *b) const
 {
+  // Dry run of a parallel build: note the point only
+  if(m_recording) {
+    unsigned int c = b->pt(m_crs_ix,0) * m_domain.getVarPoints(m_spd_ix) +
+      b->pt(m_spd_ix,0);
+    if((c < m_pt_state.size()) && (m_pt_state[c] == 0)) {
+      m_pt_state[c] = 1;
+      m_rec_pts.push_back(c);
+    }
+    return(getKnownMax());
+  }
+
   double eval_crs = 0;
   double eval_spd = 0;
   m_domain.getVal(m_crs_ix, b->pt(m_crs_ix,0), eval_crs);
   m_domain.getVal(m_spd_ix, b->pt(m_spd_ix,0), eval_spd);
 
+  // Past the anytime deadline: let the build run out cheaply
+  if(m_has_deadline) {
+    if(m_expired || (chrono::steady_clock::now() > m_deadline)) {
+      m_expired = true;
+      return(getKnownMax());
+    }
+  }
+
+  // Evaluated ahead by evalRecordedPoints(), or earlier in this
+  // build with the memo on
+  unsigned int crs_pt = b->pt(m_crs_ix,0);
+  unsigned int spd_pt = b->pt(m_spd_ix,0);
+  unsigned int c = crs_pt * m_domain.getVarPoints(m_spd_ix) + spd_pt;
+  bool tabled = (c < m_pt_state.size()) && !m_pt_util.empty();
+  m_pt_calls++;
+  if(tabled && (m_pt_state[c] >= 2)) {
+    m_pt_served++;
+    if(m_pt_state[c] == 3)
+      m_pt_dups++;
+    m_pt_state[c] = 3;
+    return(m_pt_util[c]);
+  }
+
+  double util = 0;
+  if(!m_eval_cache)
+    util = evalCandidate(eval_crs, eval_spd);
+
+  // Reuse a utility from an earlier build in a nearby state
+  else if(!m_eval_cache->lookup(crs_pt, spd_pt, util)) {
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    util = evalCandidate(eval_crs, eval_spd);
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+    m_eval_cache->store(crs_pt, spd_pt, util, ms.count());
+  }
+
+  if(tabled && m_build_memo) {
+    m_pt_util[c]  = util;
+    m_pt_state[c] = 3;
+  }
+  return(util);
+}
+
+//----------------------------------------------------------------
+// Procedure: sideLockBlocks()
+//   Purpose: Side lock: if the vehicle has committed to passing on
+//            one side, penalize headings that would place the
+//            obstacle on the locked side. Checked for every
+//            obstacle with a lock. Relative bearing of obstacle
+//            centroid w.r.t. candidate heading:
+//              (0,180) = starboard, (180,360) = port.
+
+bool AOF_TowObstacleAvoid::sideLockBlocks(double eval_crs) const
+{
+  if(sideLockBlocks(m_side_lock, m_bng_to_ob, eval_crs))
+    return(true);
+  for(unsigned int i = 0; i < m_extra_bng.size(); i++)
+    if(sideLockBlocks(m_extra_locks[i], m_extra_bng[i], eval_crs))
+      return(true);
+  return(false);
+}
+
+bool AOF_TowObstacleAvoid::sideLockBlocks(const string& side_lock,
+                                          double bng_to_ob,
+                                          double eval_crs) const
+{
+  if(side_lock == "")
+    return(false);
+
+  double rel_bng = angle360(bng_to_ob - eval_crs);
+  bool ob_to_star = (rel_bng > 0) && (rel_bng < 180);
+  bool ob_to_port = (rel_bng > 180);
+  if((side_lock == "star") && ob_to_star)
+    return(true);
+  if((side_lock == "port") && ob_to_port)
+    return(true);
+  return(false);
+}
+
+//----------------------------------------------------------------
+// Procedure: addObstacle()
+//   Purpose: Add an obstacle to check alongside the obship model's
+//            gut poly. Takes effect at the next initialize().
+
+void AOF_TowObstacleAvoid::addObstacle(const XYPolygon& gut,
+                                       shared_ptr<const PolySDFGrid> grid,
+                                       const string& side_lock)
+{
+  m_extra_guts.push_back(gut);
+  m_extra_grids.push_back(grid);
+  m_extra_locks.push_back(side_lock);
+}
+
+//----------------------------------------------------------------
+// Procedure: clearObstacles()
+
+void AOF_TowObstacleAvoid::clearObstacles()
+{
+  m_extra_guts.clear();
+  m_extra_grids.clear();
+  m_extra_locks.clear();
+  m_extra_bng.clear();
+}
+
+//----------------------------------------------------------------
+// Procedure: evalCandidate()
+//   Purpose: Scalar evaluation of one (course, speed) candidate in
+//            domain units. Shared by evalBox() and the scalar tail
+//            of evalBatch(), which has already tried reachPrune().
+
+double AOF_TowObstacleAvoid::evalCandidate(double eval_crs,
+                                           double eval_spd,
+                                           bool try_prune) const
+{
   // If tow evaluation is not enabled or state is not ready, return max utility
   if(!m_tow_eval)
     return(getKnownMax());
-  if(!m_tow_pose_set || !m_dyn_params_set)
+  if(!m_tow_pose_set || !m_dyn_params_set || !m_prepared)
+    return(getKnownMax());
+
+  if(sideLockBlocks(eval_crs))
+    return(getKnownMin());
+
+  int steps = m_steps;
+  if(steps <= 0 && !m_static_only)
     return(getKnownMax());
 
-  // Side lock: if the vehicle has committed to passing on one side,
-  // penalize headings that would place the obstacle on the locked side.
-  // Relative bearing of obstacle centroid w.r.t. candidate heading:
-  //   (0,180) = starboard, (180,360) = port.
-  if(m_side_lock != "") {
-    double cx = m_obship_model.getObcentX();
-    double cy = m_obship_model.getObcentY();
-    double bng_to_ob = relAng(m_tow_x, m_tow_y, cx, cy);
-    double rel_bng = angle360(bng_to_ob - eval_crs);
-    bool ob_to_star = (rel_bng > 0) && (rel_bng < 180);
-    bool ob_to_port = (rel_bng > 180);
-    if((m_side_lock == "star") && ob_to_star)
-      return(getKnownMin());
-    if((m_side_lock == "port") && ob_to_port)
-      return(getKnownMin());
+  // Obstacle provably out of reach over the horizon
+  double pruned_util = 0;
+  if(try_prune && reachPrune(eval_crs, eval_spd, pruned_util))
+    return(pruned_util);
+
+  // Heading profile for this course (shared across speeds)
+  const double *pc = 0;
+  const double *ps = 0;
+  int plen = headingProfile(eval_crs, pc, ps);
+
+  // Interpolated from the surrogate table when it covers the candidate
+  if(m_surrogate && (plen > 0)) {
+    double util = 0;
+    if(evalSurrogate(eval_crs, eval_spd, pc, ps, plen, util))
+      return(util);
   }
 
-  // Simulation horizon: use configured value or fall back to allowable_ttc.
-  // A value of -2 signals "static cable check only, no forward sim."
-  bool static_only = (m_sim_horizon < -1.5);
-  double T = static_only ? 0 : ((m_sim_horizon > 0) ? m_sim_horizon : m_obship_model.getAllowableTTC());
+  // Closed-form tractrix while the cable stays taut
+  if(m_trx_ok && (plen > 0)) {
+    double util = 0;
+    if(evalTractrix(eval_spd, pc, ps, plen, util))
+      return(util);
+  }
+
+  if(m_adapt_ok && (plen > 0))
+    return(evalAdaptive(eval_spd, pc, ps, plen));
+  if(m_float_ok && (plen > 0))
+    return(evalFloat(eval_spd, pc, ps, plen));
+  if(m_cascade_ok && (plen > 0))
+    return(evalCascade(eval_crs, eval_spd, pc, ps, plen));
+
+  if(m_traj_ok && (plen > 0))
+    return(evalTrajCache(eval_crs, eval_spd, pc, ps, plen));
+
+  double min_dist = 0, min_tow_spd = 0;
+  int contact_step = -1;
+  simulate(eval_crs, eval_spd, pc, ps, plen, m_use_cable_dynamics,
+           m_init_min_dist, min_dist, contact_step, min_tow_spd);
+
+  return(utilityFromSim(min_dist, contact_step, steps, min_tow_spd));
+}
+
+//----------------------------------------------------------------
+// Procedure: evalCascade()
+//   Purpose: Screen a candidate with the relaxed cable and re-run
+//            it with full cable dynamics only when the screened
+//            result is near a utility breakpoint: contact or near
+//            contact, or a CPA within the band of the ramp between
+//            min_util_cpa and max_util_cpa. Elsewhere the relaxed
+//            result stands. The band is m_cascade_gap, the largest
+//            relaxed-vs-full node gap seen by cascadeGap(), plus the
+//            m_cascade_band margin.
+
+double AOF_TowObstacleAvoid::evalCascade(double eval_crs, double eval_spd,
+                                         const double *pc, const double *ps,
+                                         int plen) const
+{
+  double min_dist = 0, min_tow_spd = 0;
+  int contact_step = -1;
+  simulate(eval_crs, eval_spd, pc, ps, plen, false, m_init_relaxed_dist,
+           min_dist, contact_step, min_tow_spd);
+  m_cascade_screened++;
+
+  double band = m_cascade_band + m_cascade_gap;
+  double minu = m_obship_model.getMinUtilCPA();
+  double maxu = m_obship_model.getMaxUtilCPA();
+  bool escalate = (contact_step >= 0) || (min_dist < band) ||
+    ((min_dist > minu - band) && (min_dist < maxu + band));
+
+  if(escalate) {
+    m_cascade_escalated++;
+    simulate(eval_crs, eval_spd, pc, ps, plen, true, m_init_min_dist,
+             min_dist, contact_step, min_tow_spd);
+  }
+  return(utilityFromSim(min_dist, contact_step, m_steps, min_tow_spd));
+}
+
+//----------------------------------------------------------------
+// Procedure: cascadeGap()
+//   Purpose: Largest distance between a full-dynamics cable node
+//            and the same node of the relaxed cable, over the
+//            horizon of a sweep of candidates: up to 8 courses
+//            across the domain at its lowest and highest speed,
+//            and the initial shape. Both models share the tow body
+//            and check the same nodes, and a node's range to the
+//            obstacle moves no more than the node, so the two
+//            CPAs of a swept candidate differ by at most this gap.
+//            Candidates between the sweep's are not covered by the
+//            bound, hence the m_cascade_band margin on top of it.
+
+double AOF_TowObstacleAvoid::cascadeGap() const
+{
+  relaxCable(m_ax0, m_ay0, m_tow_x, m_tow_y, m_rx, m_ry);
+  double gap = 0;
+  for(int i = m_start_node; i < m_num_nodes; i++)
+    gap = std::max(gap, towHypot(m_init_nx[i] - m_rx[i],
+                                 m_init_ny[i] - m_ry[i]));
+
+  unsigned int crs_pts = m_domain.getVarPoints(m_crs_ix);
+  unsigned int spd_pts = m_domain.getVarPoints(m_spd_ix);
+  if((crs_pts == 0) || (spd_pts == 0))
+    return(gap);
+  unsigned int crs_step = std::max(1u, crs_pts / 8);
+
+  for(unsigned int ci = 0; ci < crs_pts; ci += crs_step) {
+    for(unsigned int si = 0; si < spd_pts; si += std::max(1u, spd_pts - 1)) {
+      double eval_crs = 0, eval_spd = 0;
+      m_domain.getVal(m_crs_ix, ci, eval_crs);
+      m_domain.getVal(m_spd_ix, si, eval_spd);
+
+      const double *pc = 0;
+      const double *ps = 0;
+      int plen = headingProfile(eval_crs, pc, ps);
+      double min_dist = 0, min_tow_spd = 0;
+      int contact_step = -1;
+      simulate(eval_crs, eval_spd, pc, ps, plen, true, 1e9, min_dist,
+               contact_step, min_tow_spd, 0, &gap);
+    }
+  }
+  return(gap);
+}
+
+//----------------------------------------------------------------
+// Procedure: simulate()
+//   Purpose: Fixed-step forward simulation of one candidate with
+//            full cable dynamics or the relaxed cable, from an
+//            initial cable range of init_min_dist. Returns the
+//            minimum range, the contact step (-1 for none) and the
+//            minimum tow speed over the horizon. If rec is given,
+//            each step's tow and cable nodes are stored there (see
+//            recordTrajectory()). If gap is given, it is raised to
+//            the largest node gap to the relaxed cable (see
+//            cascadeGap()).
+
+void AOF_TowObstacleAvoid::simulate(double eval_crs, double eval_spd,
+                                    const double *pc, const double *ps,
+                                    int plen, bool cable_dyn,
+                                    double init_min_dist, double &min_dist,
+                                    int &contact_step,
+                                    double &min_tow_spd,
+                                    float *rec, double *gap) const
+{
   double dt = m_sim_dt;
-  int steps = (dt > 1e-6) ? (int)ceil(T / dt) : 0;
-  if(steps <= 0 && !static_only)
-    return(getKnownMax());
+  int steps = m_steps;
 
   // Initial ownship pose (drives the tow anchor point)
   double osx = m_obship_model.getOSX();
@@ -187,58 +1145,31 @@ double AOF_TowObstacleAvoid::evalBox(const IvPBox *b) const
   double tvy = m_tow_vy;
 
   // Track minimum predicted tow speed over the horizon
-  double min_tow_spd = 1e9;
+  min_tow_spd = 1e9;
 
-  XYPolygon gut = m_obship_model.getGutPoly();
-
-  // Compute cable node layout (mirrors Cable.cpp logic)
-  int num_nodes;
-  if(m_cable_length < 30.0)
-    num_nodes = 3;
-  else
-    num_nodes = std::max(3, (int)(m_cable_length / 10.0));
-  double rest_length = m_cable_length / (double)(num_nodes - 1);
-
-  // Skip shallow cable nodes near surface when cable_start_node is set
-  int start = std::min(m_cable_start_node, num_nodes - 1);
-
-  double hdg_rad0 = (90.0 - osh) * M_PI / 180.0;
-  double ax0 = osx - m_attach_offset * cos(hdg_rad0);
-  double ay0 = osy - m_attach_offset * sin(hdg_rad0);
-
-  // Track minimum tow-to-obstacle distance over the horizon
-  double min_dist = 1e9;
+  // Track minimum tow-to-obstacle distance over the horizon, seeded
+  // with the (candidate-independent) range of the initial cable shape
+  min_dist = init_min_dist;
 
   // Track time-to-first-contact: when min_dist hits 0, record which
   // simulation step it happened on.  -1 means no contact predicted.
-  int contact_step = -1;
-
-  // Initialize cable node arrays only when using full dynamics
-  vector<double> n_x, n_y, n_vx, n_vy;
-  if(m_use_cable_dynamics) {
-    n_x.resize(num_nodes);  n_y.resize(num_nodes);
-    n_vx.assign(num_nodes, 0.0);  n_vy.assign(num_nodes, 0.0);
+  contact_step = -1;
+  if(min_dist <= 0)
+    contact_step = 0;
+
+  // Reset cable node scratch arrays only when using full dynamics
+  int num_nodes = m_num_nodes;
+  int start = m_start_node;
+  if(cable_dyn) {
     for(int i = 0; i < num_nodes; i++) {
-      double t = (double)i / (double)(num_nodes - 1);
-      n_x[i] = ax0 + t * (tx - ax0);
-      n_y[i] = ay0 + t * (ty - ay0);
+      m_nx[i]  = m_init_nx[i];
+      m_ny[i]  = m_init_ny[i];
+      m_nvx[i] = 0;
+      m_nvy[i] = 0;
     }
   }
-
-  // Check initial cable nodes for obstacle proximity
-  if(m_use_cable_dynamics) {
-    for(int i = start; i < num_nodes; i++) {
-      double ds = gut.dist_to_poly(n_x[i], n_y[i]);
-      if(ds < 0) ds = 0;
-      min_dist = std::min(min_dist, ds);
-      if(min_dist <= 0) { contact_step = 0; break; }
-    }
-  } else {
-    double d = cableRelaxedMinDist(ax0, ay0, tx, ty,
-                                   num_nodes, rest_length, start, gut);
-    min_dist = std::min(min_dist, d);
-    if(min_dist <= 0) contact_step = 0;
-  }
+  else if(m_swept_check)
+    relaxCable(m_ax0, m_ay0, m_tow_x, m_tow_y, m_sx, m_sy);
 
   // Forward simulation of vessel + tow dynamics
   double vh = osh;       // vessel heading (turn-rate-limited)
@@ -249,71 +1180,302 @@ double AOF_TowObstacleAvoid::evalBox(const IvPBox *b) const
     // If contact already occurred, stop simulating
     if(contact_step >= 0)
       break;
+    m_sim_steps++;
 
-    // Heading update (with optional turn-rate limit)
-    if(m_turn_rate_max > 0) {
-      double diff = angleDiff(eval_crs, vh);
-      double step_deg = m_turn_rate_max * dt;
-      if(fabs(diff) <= step_deg)
+    double hc, hs;
+    if(plen > 0) {
+      int j = (k < plen) ? k : plen - 1;
+      hc = pc[j];
+      hs = ps[j];
+    }
+    else {
+      // Heading update (with optional turn-rate limit)
+      if(m_turn_rate_max > 0) {
+        double diff = angleDiff(eval_crs, vh);
+        double step_deg = m_turn_rate_max * dt;
+        if(fabs(diff) <= step_deg)
+          vh = eval_crs;
+        else
+          vh = angle360(vh + (diff > 0 ? step_deg : -step_deg));
+      } else {
         vh = eval_crs;
-      else
-        vh = angle360(vh + (diff > 0 ? step_deg : -step_deg));
-    } else {
-      vh = eval_crs;
+      }
+      double hdg_rad = (90.0 - vh) * M_PI / 180.0;
+      hc = cos(hdg_rad);
+      hs = sin(hdg_rad);
     }
 
     // Vessel position update (simple kinematics)
-    double hdg_rad = (90.0 - vh) * M_PI / 180.0;
-    osx += vs * cos(hdg_rad) * dt;
-    osy += vs * sin(hdg_rad) * dt;
+    osx += vs * hc * dt;
+    osy += vs * hs * dt;
 
     // Anchor point (stern attachment offset from vessel CG)
-    double ax = osx - m_attach_offset * cos(hdg_rad);
-    double ay = osy - m_attach_offset * sin(hdg_rad);
+    double ax = osx - m_attach_offset * hc;
+    double ay = osy - m_attach_offset * hs;
 
     // Advance the tow body endpoint (matches pTowing physics)
     propagateTowOneStep(ax, ay, dt, tx, ty, tvx, tvy);
 
     // Track minimum predicted tow speed
-    double tow_spd = hypot(tvx, tvy);
+    double tow_spd = towHypot(tvx, tvy);
     if(tow_spd < min_tow_spd)
       min_tow_spd = tow_spd;
 
-    if(m_use_cable_dynamics) {
+    if(cable_dyn) {
+      // Keep the shape before the step for the swept check
+      if(m_swept_check) {
+        for(int i = 0; i < num_nodes; i++) {
+          m_sx[i] = m_nx[i];
+          m_sy[i] = m_ny[i];
+        }
+      }
+
       // Full cable dynamics: propagate interior node positions + velocities
-      propagateCableOneStep(ax, ay, tx, ty, dt, num_nodes, rest_length,
-                            n_x, n_y, n_vx, n_vy);
+      propagateCableOneStep(ax, ay, tx, ty, dt, num_nodes, m_rest_length,
+                            m_nx, m_ny, m_nvx, m_nvy);
+
+      // Gap to the relaxed cable for cascadeGap()
+      if(gap) {
+        relaxCable(ax, ay, tx, ty, m_rx, m_ry);
+        for(int i = start; i < num_nodes; i++)
+          *gap = std::max(*gap, towHypot(m_nx[i] - m_rx[i],
+                                         m_ny[i] - m_ry[i]));
+      }
 
-      if(k % m_cable_check_interval == 0 || min_dist < 5.0) {
-        for(int i = start; i < num_nodes; i++) {
-          double d = gut.dist_to_poly(n_x[i], n_y[i]);
-          if(d < 0) d = 0;
-          min_dist = std::min(min_dist, d);
-          if(min_dist <= 0) break;
-        }
+      if(m_swept_check)
+        min_dist = sweptCableMinDist(m_sx, m_sy, m_nx, m_ny, min_dist);
+      else if(k % m_cable_check_interval == 0 || min_dist < 5.0) {
+        double d = m_gut.minDist(&m_nx[start], &m_ny[start], num_nodes - start);
+        if(d < 0) d = 0;
+        min_dist = std::min(min_dist, d);
       } else {
-        double d = gut.dist_to_poly(tx, ty);
+        double d = m_gut.dist(tx, ty);
         if(d < 0) d = 0;
         min_dist = std::min(min_dist, d);
       }
     }
+    else if(m_swept_check) {
+      // Relaxed cable swept from its shape at the previous step
+      relaxCable(ax, ay, tx, ty, m_rx, m_ry);
+      min_dist = sweptCableMinDist(m_sx, m_sy, m_rx, m_ry, min_dist);
+      m_sx.swap(m_rx);
+      m_sy.swap(m_ry);
+    }
     else {
       // Relaxed cable: reconstruct shape from endpoints at check intervals
       if(k % m_cable_check_interval == 0 || min_dist < 5.0) {
-        double d = cableRelaxedMinDist(ax, ay, tx, ty,
-                                       num_nodes, rest_length, start, gut);
+        double d = cableRelaxedMinDist(ax, ay, tx, ty);
         min_dist = std::min(min_dist, d);
       } else {
-        double d = gut.dist_to_poly(tx, ty);
+        double d = m_gut.dist(tx, ty);
         if(d < 0) d = 0;
         min_dist = std::min(min_dist, d);
       }
     }
 
+    if(rec) {
+      float *r = rec + (size_t)k * TowSurrogate::recFloats(num_nodes);
+      r[0] = (float)(tx - osx);
+      r[1] = (float)(ty - osy);
+      r[2] = (float)(tvx - vs * hc);
+      r[3] = (float)(tvy - vs * hs);
+      for(int i = 1; i < num_nodes - 1; i++) {
+        r[2*i + 2] = (float)(m_nx[i] - osx);
+        r[2*i + 3] = (float)(m_ny[i] - osy);
+      }
+    }
+
     if(min_dist <= 0)
       contact_step = k + 1;
   }
+}
+
+//----------------------------------------------------------------
+// Procedure: recordTrajectory()
+//   Purpose: Simulate one candidate with full cable dynamics and
+//            store the tow (x, y, vx, vy) and interior node (x, y)
+//            at every step, relative to ownship at that step, as
+//            TowSurrogate records.
+
+bool AOF_TowObstacleAvoid::recordTrajectory(double eval_crs,
+                                            double eval_spd,
+                                            vector<float>& rec) const
+{
+  rec.clear();
+  if(!m_prepared || (m_steps <= 0) || !(m_cable_length > 0))
+    return(false);
+
+  const double *pc = 0;
+  const double *ps = 0;
+  int plen = headingProfile(eval_crs, pc, ps);
+
+  rec.assign((size_t)m_steps * TowSurrogate::recFloats(m_num_nodes), 0);
+  double min_dist = 0, min_tow_spd = 0;
+  int contact_step = -1;
+  simulate(eval_crs, eval_spd, pc, ps, plen, true, 1e9, min_dist,
+           contact_step, min_tow_spd, &rec[0]);
+  return(contact_step < 0);
+}
+
+//----------------------------------------------------------------
+// Procedure: adaptiveMult()
+//   Purpose: Size of the next adaptive step, as a multiple of
+//            sim_dt. One step at a time while the heading is still
+//            turning; after that the step grows up to m_adapt_cap,
+//            limited by
+//              - drag stability: cd*|v|*h <= 1, so the quadratic
+//                drag update never reverses the velocity (not
+//                needed by the semi-implicit integrator),
+//              - clearance: the cable moves (at about the faster of
+//                tow and vessel) at most half of its room beyond
+//                max_util_cpa per step, so steps shrink as the cable
+//                nears the obstacle (clear is the checked nodes'
+//                range after the last step),
+//              - settling: the tow velocity changes by at most
+//                ADAPT_DV_TOL per step.
+//            accel < 0 (unknown, first step) gives one step.
+
+static const double ADAPT_DV_TOL = 0.05;  // m/s per step
+
+int AOF_TowObstacleAvoid::adaptiveMult(int k, int plen, double clear,
+                                       double accel, double tow_spd,
+                                       double vs) const
+{
+  if((k < plen - 1) || (accel < 0))
+    return(1);
+
+  double room = clear - m_reach_thresh;
+  if(room <= 0)
+    return(1);
+
+  double v = std::max(std::max(tow_spd, vs), 0.1);
+  double h = m_adapt_cap;
+  if((m_cd > 0) && (m_integrator != TOW_INT_SEMI_IMPLICIT))
+    h = std::min(h, 1.0 / (m_cd * v));
+  h = std::min(h, 0.5 * room / v);
+  if(accel > 0)
+    h = std::min(h, ADAPT_DV_TOL / accel);
+
+  double m = floor(h / m_sim_dt);
+  int remaining = m_steps - k;
+  if(m < 1)
+    return(1);
+  if(m > remaining)
+    return(remaining);
+  return((int)m);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalAdaptive()
+//   Purpose: Forward simulation with adaptive steps (a multiple of
+//            sim_dt chosen by adaptiveMult()). The whole checked
+//            cable is measured every step, or swept between steps
+//            when swept checks are on. Time to contact is kept in
+//            sim_dt units so utilities compare with the fixed-step
+//            simulation. Takes the course's heading profile.
+
+double AOF_TowObstacleAvoid::evalAdaptive(double eval_spd, const double *pc,
+                                          const double *ps, int plen) const
+{
+  double dt  = m_sim_dt;
+  double vs  = eval_spd;
+  double osx = m_obship_model.getOSX();
+  double osy = m_obship_model.getOSY();
+  double tx  = m_tow_x;
+  double ty  = m_tow_y;
+  double tvx = m_tow_vx;
+  double tvy = m_tow_vy;
+  double min_tow_spd = 1e9;
+
+  double min_dist = m_init_min_dist;
+  int contact_step = (min_dist <= 0) ? 0 : -1;
+
+  int num_nodes = m_num_nodes;
+  int start = m_start_node;
+  if(m_use_cable_dynamics) {
+    for(int i = 0; i < num_nodes; i++) {
+      m_nx[i]  = m_init_nx[i];
+      m_ny[i]  = m_init_ny[i];
+      m_nvx[i] = 0;
+      m_nvy[i] = 0;
+    }
+  }
+  else if(m_swept_check)
+    relaxCable(m_ax0, m_ay0, m_tow_x, m_tow_y, m_sx, m_sy);
+
+  // Step selection state (see reachPrune() for the matching steps)
+  double clear = m_init_min_dist;
+  double accel = -1;
+  double tow_spd = towHypot(tvx, tvy);
+
+  int k = 0;
+  while((k < m_steps) && (contact_step < 0)) {
+    int m = adaptiveMult(k, plen, clear, accel, tow_spd, vs);
+    double h = m * dt;
+    int j = (k < plen) ? k : plen - 1;
+    double hc = pc[j];
+    double hs = ps[j];
+    m_sim_steps++;
+
+    osx += vs * hc * h;
+    osy += vs * hs * h;
+    double ax = osx - m_attach_offset * hc;
+    double ay = osy - m_attach_offset * hs;
+
+    double pvx = tvx;
+    double pvy = tvy;
+    propagateTowOneStep(ax, ay, h, tx, ty, tvx, tvy);
+
+    tow_spd = towHypot(tvx, tvy);
+    if(tow_spd < min_tow_spd)
+      min_tow_spd = tow_spd;
+    accel = towHypot(tvx - pvx, tvy - pvy) / h;
+
+    if(m_use_cable_dynamics) {
+      if(m_swept_check) {
+        for(int i = 0; i < num_nodes; i++) {
+          m_sx[i] = m_nx[i];
+          m_sy[i] = m_ny[i];
+        }
+      }
+      propagateCableOneStep(ax, ay, tx, ty, h, num_nodes, m_rest_length,
+                            m_nx, m_ny, m_nvx, m_nvy);
+      double d = m_gut.minDist(&m_nx[start], &m_ny[start], num_nodes - start);
+      clear = std::max(0.0, d);
+      if(m_swept_check)
+        min_dist = sweptCableMinDist(m_sx, m_sy, m_nx, m_ny, min_dist);
+      else
+        min_dist = std::min(min_dist, clear);
+    }
+    else if(m_swept_check) {
+      relaxCable(ax, ay, tx, ty, m_rx, m_ry);
+      double d = m_gut.minDist(&m_rx[start], &m_ry[start], num_nodes - start);
+      clear = std::max(0.0, d);
+      min_dist = sweptCableMinDist(m_sx, m_sy, m_rx, m_ry, min_dist);
+      m_sx.swap(m_rx);
+      m_sy.swap(m_ry);
+    }
+    else {
+      clear = cableRelaxedMinDist(ax, ay, tx, ty);
+      min_dist = std::min(min_dist, clear);
+    }
+
+    k += m;
+    if(min_dist <= 0)
+      contact_step = k;
+  }
 
+  return(utilityFromSim(min_dist, contact_step, m_steps, min_tow_spd));
+}
+
+//----------------------------------------------------------------
+// Procedure: utilityFromSim()
+//   Purpose: Map the outcome of one forward simulation (minimum
+//            distance, contact step, minimum tow speed) to utility.
+
+double AOF_TowObstacleAvoid::utilityFromSim(double min_dist, int contact_step,
+                                            int steps, double min_tow_spd) const
+{
   // Map minimum distance to utility using min/max CPA thresholds
   // Above max_util_cpa: full utility (safe)
   // Between min and max: linear ramp from sub_ceiling to max
@@ -404,10 +1566,10 @@ void AOF_TowObstacleAvoid::setSimParams(double dt, double horizon, double turn_r
 
 //----------------------------------------------------------------
 // Procedure: propagateTowOneStep()
-//   Purpose: Advance the tow body state by one time step.
-//            Replicates pTowing deployed-state dynamics: spring
-//            tension, quadratic drag, tangential damping, and
-//            rigid cable clamp.
+//   Purpose: Advance the tow body state by one time step, with
+//            pTowing's model (towAdvanceBody(), lib_towdyn):
+//            spring tension, quadratic drag, tangential damping,
+//            and rigid cable clamp.
 
 void AOF_TowObstacleAvoid::propagateTowOneStep(double ax, double ay, double dt,
                                                double &tx, double &ty,
@@ -417,91 +1579,15 @@ void AOF_TowObstacleAvoid::propagateTowOneStep(double ax, double ay, double dt,
     return;
   dt = std::max(dt, 1e-3);
 
-  // Fallback: if cable length is invalid, integrate with drag only
-  if(!(m_cable_length > 0)) {
-    double spd = std::hypot(tvx, tvy);
-    if((spd > 1e-6) && (m_cd > 0)) {
-      tvx += -m_cd * tvx * spd * dt;
-      tvy += -m_cd * tvy * spd * dt;
-    }
-    tx += tvx * dt;
-    ty += tvy * dt;
-    return;
-  }
-
-  // Vector from tow body to anchor point
-  double dx = ax - tx;
-  double dy = ay - ty;
-  double distance = std::hypot(dx, dy);
-
-  // If tow is essentially co-located with anchor, apply drag only
-  if(distance <= 0.01) {
-    double spd = std::hypot(tvx, tvy);
-    if((spd > 1e-6) && (m_cd > 0)) {
-      tvx += -m_cd * tvx * spd * dt;
-      tvy += -m_cd * tvy * spd * dt;
-    }
-    tx += tvx * dt;
-    ty += tvy * dt;
-    return;
-  }
-
-  // Unit vector along cable (tow -> anchor)
-  double d_dir = std::hypot(dx, dy);
-  if(d_dir < 1e-6)
-    d_dir = 1.0;
-  double ux = dx / d_dir;
-  double uy = dy / d_dir;
-
-  // Tangential unit vector (perpendicular to cable)
-  double nx = -uy;
-  double ny =  ux;
-
-  // Spring tension when cable is overstretched
-  if((distance > m_cable_length) && (m_k_spring > 0)) {
-    double overshoot = distance - m_cable_length;
-    tvx += m_k_spring * overshoot * ux * dt;
-    tvy += m_k_spring * overshoot * uy * dt;
-  }
-
-  // Quadratic drag
-  double speed = std::hypot(tvx, tvy);
-  if((speed > 1e-6) && (m_cd > 0)) {
-    tvx += -m_cd * tvx * speed * dt;
-    tvy += -m_cd * tvy * speed * dt;
-  }
-
-  // Tangential damping (penalizes sideways motion)
-  if(m_c_tan > 0) {
-    double vt = tvx * nx + tvy * ny;
-    tvx += (-m_c_tan * vt) * nx * dt;
-    tvy += (-m_c_tan * vt) * ny * dt;
-  }
-
-  // Euler position integration
-  tx += tvx * dt;
-  ty += tvy * dt;
-
-  // Rigid cable clamp: project tow back onto cable radius
-  double sx = ax - tx;
-  double sy = ay - ty;
-  double dist_a = std::hypot(sx, sy);
-
-  if((dist_a > m_cable_length) && (dist_a > 1e-9)) {
-    double sc = m_cable_length / dist_a;
-    tx = ax - sx * sc;
-    ty = ay - sy * sc;
+  towAdvanceBody(m_integrator, m_cable_params, ax, ay, dt,
+                 tx, ty, tvx, tvy);
+}
 
-    // Remove outward radial velocity component
-    double urx = sx / dist_a;
-    double ury = sy / dist_a;
-    double vrad = tvx * urx + tvy * ury;
-    if(vrad < 0) {
-      tvx -= vrad * urx;
-      tvy -= vrad * ury;
-    }
-  }
-} 
+//----------------------------------------------------------------
+// Procedure: propagateCableOneStep()
+//   Purpose: Advance the interior cable nodes by one time step,
+//            with pCable's model (lib_towdyn). The fixed-N kernel
+//            picked in initialize() is used when there is one.
 
 void AOF_TowObstacleAvoid::propagateCableOneStep(
     double ax, double ay,   // anchor (node 0, pinned)
@@ -516,161 +1602,124 @@ void AOF_TowObstacleAvoid::propagateCableOneStep(
 {
   dt = std::max(dt, 1e-3);
 
-  // Pin endpoints
-  nx_arr[0]  = ax;  ny_arr[0]  = ay;
-  nvx_arr[0] = 0;   nvy_arr[0] = 0;
-  nx_arr[num_nodes-1]  = tx;  ny_arr[num_nodes-1]  = ty;
-  nvx_arr[num_nodes-1] = 0;   nvy_arr[num_nodes-1] = 0;
-
-  // Interior node dynamics — mirrors Cable.cpp exactly
-  for(int i = 1; i < num_nodes - 1; i++) {
-    // Spring from previous neighbor
-    double dx_prev = nx_arr[i-1] - nx_arr[i];
-    double dy_prev = ny_arr[i-1] - ny_arr[i];
-    double dist_prev = hypot(dx_prev, dy_prev);
-    if(dist_prev > 0.01 && dist_prev > rest_length && m_k_spring > 0) {
-      double ux = dx_prev / dist_prev;
-      double uy = dy_prev / dist_prev;
-      double overshoot = dist_prev - rest_length;
-      nvx_arr[i] += m_k_spring * overshoot * ux * dt;
-      nvy_arr[i] += m_k_spring * overshoot * uy * dt;
-    }
-
-    // Spring from next neighbor
-    double dx_next = nx_arr[i+1] - nx_arr[i];
-    double dy_next = ny_arr[i+1] - ny_arr[i];
-    double dist_next = hypot(dx_next, dy_next);
-    if(dist_next > 0.01 && dist_next > rest_length && m_k_spring > 0) {
-      double ux = dx_next / dist_next;
-      double uy = dy_next / dist_next;
-      double overshoot = dist_next - rest_length;
-      nvx_arr[i] += m_k_spring * overshoot * ux * dt;
-      nvy_arr[i] += m_k_spring * overshoot * uy * dt;
-    }
-
-    // Quadratic drag
-    double speed = hypot(nvx_arr[i], nvy_arr[i]);
-    if(speed > 1e-6 && m_cd > 0) {
-      nvx_arr[i] += -m_cd * nvx_arr[i] * speed * dt;
-      nvy_arr[i] += -m_cd * nvy_arr[i] * speed * dt;
-    }
-
-    // Tangential damping
-    if(m_c_tan > 0) {
-      double cx   = nx_arr[i+1] - nx_arr[i-1];
-      double cy   = ny_arr[i+1] - ny_arr[i-1];
-      double clen = hypot(cx, cy);
-      if(clen > 1e-6) {
-        double utx = cx / clen;
-        double uty = cy / clen;
-        double perpx = -uty;
-        double perpy =  utx;
-        double vn = nvx_arr[i] * perpx + nvy_arr[i] * perpy;
-        nvx_arr[i] += (-m_c_tan * vn) * perpx * dt;
-        nvy_arr[i] += (-m_c_tan * vn) * perpy * dt;
-      }
-    }
-
-    // Euler integration
-    nx_arr[i] += nvx_arr[i] * dt;
-    ny_arr[i] += nvy_arr[i] * dt;
-  }
-
-  // Forward constraint pass
-  for(int i = 1; i < num_nodes - 1; i++) {
-    double dx   = nx_arr[i-1] - nx_arr[i];
-    double dy   = ny_arr[i-1] - ny_arr[i];
-    double dist = hypot(dx, dy);
-    if(dist > rest_length && dist > 1e-9) {
-      double sc = rest_length / dist;
-      nx_arr[i] = nx_arr[i-1] - dx * sc;
-      ny_arr[i] = ny_arr[i-1] - dy * sc;
-      double urx = dx / dist;
-      double ury = dy / dist;
-      double vrad = nvx_arr[i] * urx + nvy_arr[i] * ury;
-      if(vrad < 0) {
-        nvx_arr[i] -= vrad * urx;
-        nvy_arr[i] -= vrad * ury;
-      }
-    }
+  if(m_cable_step_fn && (num_nodes == m_num_nodes)) {
+    m_cable_step_fn(m_cable_params, ax, ay, tx, ty, dt, &nx_arr[0],
+                    &ny_arr[0], &nvx_arr[0], &nvy_arr[0]);
+    return;
   }
 
-  // Backward constraint pass
-  for(int i = num_nodes - 2; i >= 1; i--) {
-    double dx   = nx_arr[i+1] - nx_arr[i];
-    double dy   = ny_arr[i+1] - ny_arr[i];
-    double dist = hypot(dx, dy);
-    if(dist > rest_length && dist > 1e-9) {
-      double sc = rest_length / dist;
-      nx_arr[i] = nx_arr[i+1] - dx * sc;
-      ny_arr[i] = ny_arr[i+1] - dy * sc;
-      double urx = dx / dist;
-      double ury = dy / dist;
-      double vrad = nvx_arr[i] * urx + nvy_arr[i] * ury;
-      if(vrad < 0) {
-        nvx_arr[i] -= vrad * urx;
-        nvy_arr[i] -= vrad * ury;
-      }
-    }
-  }
+  TowCableParams p = m_cable_params;
+  p.rest_length = rest_length;
+  towAdvanceCableN(m_integrator, p, num_nodes, ax, ay, tx, ty, dt,
+                   &nx_arr[0], &ny_arr[0], &nvx_arr[0], &nvy_arr[0]);
 }
 
 //----------------------------------------------------------------
 // Procedure: cableRelaxedMinDist()
 //   Purpose: Compute minimum distance from cable nodes to obstacle
 //            using position-only constraint relaxation (no velocity
-//            arrays). Matches the approach in BHV cableMinDistToPoly.
-
-double AOF_TowObstacleAvoid::cableRelaxedMinDist(
-    double ax, double ay, double tx, double ty,
-    int num_nodes, double rest_length, int start,
-    const XYPolygon &poly) const
-{
-  // Initialize nodes as straight line from anchor to tow
-  vector<double> nx(num_nodes), ny(num_nodes);
-  for(int i = 0; i < num_nodes; i++) {
-    double frac = (double)i / (double)(num_nodes - 1);
-    nx[i] = ax + frac * (tx - ax);
-    ny[i] = ay + frac * (ty - ay);
-  }
-
-  // Constraint relaxation passes (no velocities)
-  int relax_iters = 4;
-  for(int r = 0; r < relax_iters; r++) {
-    // Forward pass: pull interior nodes toward previous neighbor
-    for(int i = 1; i < num_nodes - 1; i++) {
-      double dx = nx[i-1] - nx[i];
-      double dy = ny[i-1] - ny[i];
-      double dist = hypot(dx, dy);
-      if(dist > rest_length && dist > 1e-9) {
-        double sc = rest_length / dist;
-        nx[i] = nx[i-1] - dx * sc;
-        ny[i] = ny[i-1] - dy * sc;
-      }
-    }
-    // Backward pass: pull interior nodes toward next neighbor
-    for(int i = num_nodes - 2; i >= 1; i--) {
-      double dx = nx[i+1] - nx[i];
-      double dy = ny[i+1] - ny[i];
-      double dist = hypot(dx, dy);
-      if(dist > rest_length && dist > 1e-9) {
-        double sc = rest_length / dist;
-        nx[i] = nx[i+1] - dx * sc;
-        ny[i] = ny[i+1] - dy * sc;
-      }
-    }
-  }
+//            arrays). Same relaxation as BHV cableMinDistToPoly.
+//            Works in the prepared scratch arrays (no allocation).
+
+double AOF_TowObstacleAvoid::cableRelaxedMinDist(double ax, double ay,
+                                                 double tx, double ty) const
+{
+  vector<double> &nx = m_rx;
+  vector<double> &ny = m_ry;
+  relaxCable(ax, ay, tx, ty, nx, ny);
 
   // Find minimum distance from cable nodes to polygon
+  double min_dist = m_gut.minDist(&nx[m_start_node], &ny[m_start_node],
+                                  m_num_nodes - m_start_node);
+  if(min_dist < 0) min_dist = 0;
+
+  return min_dist;
+}
+
+//----------------------------------------------------------------
+// Procedure: relaxCable()
+//   Purpose: Relaxed cable shape between anchor and tow: a straight
+//            line pulled to the rest length by position-only
+//            constraint passes. Written into nx/ny (num_nodes each).
+
+void AOF_TowObstacleAvoid::relaxCable(double ax, double ay,
+                                      double tx, double ty,
+                                      vector<double> &nx,
+                                      vector<double> &ny) const
+{
+  if(m_cable_relax_fn) {
+    m_cable_relax_fn(m_rest_length, ax, ay, tx, ty, &nx[0], &ny[0]);
+    return;
+  }
+
+  towCableRelaxN(m_rest_length, m_num_nodes, ax, ay, tx, ty,
+                 &nx[0], &ny[0]);
+}
+
+//----------------------------------------------------------------
+// Procedure: cableSegMinDist()
+//   Purpose: Minimum distance from the checked cable segments (from
+//            the start node to the tow) to the obstacle. Exact edge
+//            kernel, so it covers the cable between the nodes.
+
+double AOF_TowObstacleAvoid::cableSegMinDist(const vector<double> &nx,
+                                             const vector<double> &ny) const
+{
+  int last = m_num_nodes - 1;
+  if(m_start_node >= last)
+    return(std::max(0.0, m_gut.exactDist(nx[last], ny[last])));
+
   double min_dist = 1e9;
-  for(int i = start; i < num_nodes; i++) {
-    double d = poly.dist_to_poly(nx[i], ny[i]);
-    if(d < 0) d = 0;
-    if(d < min_dist) min_dist = d;
-    if(min_dist <= 0) return 0;
+  for(int i = m_start_node; i < last; i++) {
+    double d = m_gut.segDist(nx[i], ny[i], nx[i+1], ny[i+1]);
+    min_dist = std::min(min_dist, std::max(0.0, d));
+    if(min_dist <= 0)
+      break;
   }
+  return(min_dist);
+}
 
-  return min_dist;
+//----------------------------------------------------------------
+// Procedure: sweptCableMinDist()
+//   Purpose: Lower min_dist to the range of everything the checked
+//            cable passes through between two steps (shape px,py
+//            moving to nx,ny). Each segment sweeps a quad, measured
+//            by ConvexPolyDist::sweptDist(). A quad whose bounding
+//            circle is farther than both min_dist and max_util_cpa
+//            is skipped: utility is flat beyond max_util_cpa, so
+//            this cannot change the result.
+
+double AOF_TowObstacleAvoid::sweptCableMinDist(const vector<double> &px,
+                                               const vector<double> &py,
+                                               const vector<double> &nx,
+                                               const vector<double> &ny,
+                                               double min_dist) const
+{
+  int last = m_num_nodes - 1;
+  if(m_start_node >= last) {
+    double d = m_gut.segDist(px[last], py[last], nx[last], ny[last]);
+    return(std::min(min_dist, std::max(0.0, d)));
+  }
+
+  double cap = std::min(min_dist, m_reach_thresh);
+  for(int i = m_start_node; i < last; i++) {
+    double cx = (px[i] + px[i+1] + nx[i] + nx[i+1]) * 0.25;
+    double cy = (py[i] + py[i+1] + ny[i] + ny[i+1]) * 0.25;
+    double r  = towHypot(px[i] - cx, py[i] - cy);
+    r = std::max(r, towHypot(px[i+1] - cx, py[i+1] - cy));
+    r = std::max(r, towHypot(nx[i] - cx, ny[i] - cy));
+    r = std::max(r, towHypot(nx[i+1] - cx, ny[i+1] - cy));
+    if(m_gut.exactDist(cx, cy) - r > cap)
+      continue;
+
+    double d = m_gut.sweptDist(px[i], py[i], px[i+1], py[i+1],
+                               nx[i], ny[i], nx[i+1], ny[i+1]);
+    min_dist = std::min(min_dist, std::max(0.0, d));
+    cap = std::min(cap, min_dist);
+    if(min_dist <= 0)
+      break;
+  }
+  return(min_dist);
 }
 
 //----------------------------------------------------------------
@@ -17,6 +17,15 @@
 #include "AOF.h"
 #include "ObShipModelV24.h"
 #include "XYPolygon.h"
+#include "PolyFieldDist.h"
+#include "PolySDFGrid.h"
+#include "TowDynamics.h"
+#include "TowEvalCache.h"
+#include "TowSurrogate.h"
+#include "TowTrajectoryCache.h"
+#include "TowWorkPool.h"
+#include <chrono>
+#include <memory>
 #include <vector>
 
 class IvPDomain;
@@ -37,6 +46,13 @@ public:
   void   setObShipModel(ObShipModelV24 obm) {m_obship_model=obm;}
   bool   initialize();
 
+  // Batched evaluation of n (course, speed) candidates in domain
+  // units. Groups of four are simulated together in SIMD lanes and
+  // match evalBox() bit-for-bit (see AOF_TowObstacleBatch.cpp).
+  void   evalBatch(const double *crs, const double *spd,
+                   unsigned int n, double *utils) const;
+  static const char* batchSimdPath();
+
   // Tow-specific methods
   void   setTowEval(bool v) {m_tow_eval = v;}
   void   setTowOnly(bool v) {m_tow_only = v;}
@@ -68,20 +84,231 @@ public:
   void setTowDynParams(double cable_len, double attach_offset,
                        double k_spring, double cd, double c_tan);
   void setSimParams(double dt, double horizon, double turn_rate_max_deg = 0.0);
-  void setCableSampleStep(double v) { if(v > 0) m_cable_sample_step = v; }
   void setCableCheckInterval(int v) { if(v > 0) m_cable_check_interval = v; }
   void setCableStartNode(int v) { if(v >= 0) m_cable_start_node = v; }
   void setUseCableDynamics(bool v) { m_use_cable_dynamics = v; }
   void setSideLock(const std::string &s) { m_side_lock = s; }
+  void setReachPrune(bool v) { m_reach_prune = v; }
+  void setSweptCheck(bool v) { m_swept_check = v; }
+  void setAdaptiveStep(double max_dt) { m_adapt_max_dt = max_dt; }
+  void setIntegrator(TowIntegrator m) { m_integrator = m; }
+  void setFixedCableKernels(bool v) { m_fixed_kernels = v; }
+  void setFloatEval(bool v) { m_float_eval = v; }
+  void setDistanceGrid(std::shared_ptr<const PolySDFGrid> g) { m_dist_grid = g; }
+
+  // Further obstacles checked in the same forward sim. Ranges are
+  // taken to the nearest one, each with its own grid (may be null)
+  // and side lock, under the obship model's CPA thresholds.
+  void addObstacle(const XYPolygon& gut,
+                   std::shared_ptr<const PolySDFGrid> grid,
+                   const std::string& side_lock = "");
+  void clearObstacles();
+  unsigned int getObstacleCount() const { return(1 + m_extra_guts.size()); }
+  void setEvalCache(TowEvalCache *cache) { m_eval_cache = cache; }
+
+  // Wall-clock deadline for the anytime build. Once past it, evalBox()
+  // returns without simulating so the build finishes quickly; the
+  // owner checks deadlineExpired() and discards that function.
+  void setDeadline(std::chrono::steady_clock::time_point t)
+  { m_deadline = t; m_has_deadline = true; }
+  bool deadlineExpired() const { return(m_expired); }
+
+  // Screen with the relaxed cable, re-running full cable dynamics
+  // only for candidates near a utility breakpoint. The band is the
+  // relaxed-vs-full cable gap measured at initialize() plus a margin
+  // of band (m), see cascadeGap().
+  void setCascade(bool v, double band = -1)
+  { m_cascade = v; if(band >= 0) m_cascade_band = band; }
+  bool usingCascade() const { return(m_cascade_ok); }
+  double getCascadeBand() const { return(m_cascade_band + m_cascade_gap); }
+  unsigned long getCascadeScreened() const { return(m_cascade_screened); }
+  unsigned long getCascadeEscalated() const { return(m_cascade_escalated); }
+
+  // Precomputed tow response table. Candidates it covers are
+  // interpolated instead of simulated; the rest, and any context
+  // outside its config or initial tow state (within pos_tol m and
+  // vel_tol m/s of trailing taut astern), are simulated live.
+  void setSurrogate(std::shared_ptr<const TowSurrogate> s) { m_surrogate = s; }
+  void setSurrogateTolerances(double pos_tol, double vel_tol)
+  { if(pos_tol >= 0) m_surr_pos_tol = pos_tol;
+    if(vel_tol >= 0) m_surr_vel_tol = vel_tol; }
+  bool usingSurrogate() const { return(m_surr_ok); }
+  unsigned long getSurrogateServed() const { return(m_surr_served); }
+  unsigned long getSurrogateFallbacks() const { return(m_surr_fallbacks); }
+
+  // Closed-form tractrix propagation (see evalTractrix()) for a
+  // tow starting taut (cable within pos_tol m of its length) and
+  // moving along the cable (within vel_tol m/s) at min_v0 m/s or
+  // more. Candidates that would slacken the cable, or whose CPA is
+  // within cpa_margin m of min_util_cpa or tow speed within
+  // spd_margin m/s of the speed penalty, are simulated.
+  void setTractrix(bool v) { m_tractrix = v; }
+  void setTractrixTolerances(double pos_tol, double vel_tol)
+  { if(pos_tol >= 0) m_trx_pos_tol = pos_tol;
+    if(vel_tol >= 0) m_trx_vel_tol = vel_tol; }
+  void setTractrixGate(double min_v0, double cpa_margin, double spd_margin)
+  { if(min_v0 >= 0)     m_trx_min_v0     = min_v0;
+    if(cpa_margin >= 0) m_trx_cpa_margin = cpa_margin;
+    if(spd_margin >= 0) m_trx_spd_margin = spd_margin; }
+  bool usingTractrix() const { return(m_trx_ok); }
+  unsigned long getTractrixServed() const { return(m_trx_served); }
+  unsigned long getTractrixFallbacks() const { return(m_trx_fallbacks); }
+
+  // Trajectories shared with the AOFs of other obstacles built for
+  // the same state in the same helm iteration (stamp), up to max_mb
+  // of them in all (see AOF_TowObstacleTrajCache.cpp)
+  void setTrajectoryCache(bool v, double stamp = 0, double max_mb = -1)
+  { m_traj_cache = v; m_traj_stamp = stamp;
+    if(max_mb > 0) m_traj_max_mb = max_mb; }
+  bool usingTrajectoryCache() const { return(m_traj_ok); }
+  unsigned long getTrajectoryHits() const { return(m_traj_hits); }
+  unsigned long getTrajectoryMisses() const { return(m_traj_misses); }
+  // Candidates not served from the shared set (no room, off grid)
+  unsigned long getTrajectoryLive() const { return(m_traj_live); }
+
+  // Parallel build (see AOF_TowObstacleParallel.cpp). While
+  // recording, evalBox() notes the domain point it is given and
+  // returns without evaluating. evalRecordedPoints() evaluates the
+  // noted points across the pool's workers and evalBox() then
+  // serves them from a table.
+  void setPointRecording(bool v);
+  void evalRecordedPoints(TowWorkPool& pool);
+  double evalPoint(unsigned int crs_pt, unsigned int spd_pt) const;
+  unsigned int  getRecordedPoints() const { return(m_rec_pts.size()); }
+  unsigned long getTableServed() const { return(m_pt_served); }
+
+  // Per-build memo: each domain point is evaluated at most once
+  // between initialize() calls, however often the reflector's
+  // overlapping grid, pieces and regions ask for it. Counts are of
+  // evalBox() calls since initialize() and, with the memo on, of
+  // those repeating a point already asked for.
+  void setBuildMemo(bool v) { m_build_memo = v; }
+  unsigned long getEvalCalls() const { return(m_pt_calls); }
+  unsigned long getEvalDuplicates() const { return(m_pt_dups); }
+
+  // Interval evaluation (see AOF_TowObstacleBounds.cpp): bounds on
+  // evalBox() over a whole box, and the domain split into boxes
+  // whose bounds collapse to max (plateaus) or min (basins)
+  // utility, down to min_crs x min_spd points
+  void evalBoxBounds(const IvPBox *b, double &lo, double &hi) const;
+  void findFlatBoxes(unsigned int min_crs, unsigned int min_spd,
+                     std::vector<IvPBox>& plateaus,
+                     std::vector<IvPBox>& basins) const;
+  unsigned long getBoundBoxes() const { return(m_bound_boxes); }
+
+  // Tow and interior cable node trajectory of one candidate with
+  // full cable dynamics relative to ownship, in the layout of
+  // TowSurrogate records.
+  // Used to generate tables; false if the sim stopped on contact.
+  bool recordTrajectory(double eval_crs, double eval_spd,
+                        std::vector<float>& rec) const;
+  int  getCableNodes() const { return(m_num_nodes); }
+  int  getSimStepCount() const { return(m_steps); }
+
+  // Reachability pruning stats (candidates checked / pruned)
+  unsigned int getReachChecks() const { return(m_reach_checks); }
+  unsigned int getReachPruned() const { return(m_reach_pruned); }
+
+  // Cable sim steps taken (all candidates since initialize())
+  unsigned long getSimSteps() const { return(m_sim_steps); }
+
+  // Obstacle distance queries (points and segments) since
+  // initialize(), parallel workers included
+  unsigned long getDistQueries() const
+  { return(m_gut.queries() + m_dist_merged); }
+
+  // True if initialize() picked node-count specialized kernels
+  bool usingFixedCableKernels() const { return(m_cable_relax_fn != 0); }
+
+  // True if initialize() enabled the single-precision eval path
+  bool usingFloatEval() const { return(m_float_ok); }
+
+  // Eval modes requested but bypassed for this context by a mode
+  // evalCandidate() tries first, empty if none (see
+  // noteModeConflicts()). Combinations that conflict:
+  //   surrogate     with swept checks; while it serves the context,
+  //                 later modes get only the candidates it misses
+  //   tractrix      the same
+  //   float eval    with adaptive steps or swept checks
+  //   cascade       with adaptive steps, float eval or swept checks
+  //   traj cache    with adaptive steps, float eval, cascade or
+  //                 swept checks
+  const std::string& getModeConflicts() const { return(m_mode_conflicts); }
 
  private:
+  void prepareEvalContext();
+  void noteModeConflicts();
+  void buildHeadingProfiles();
+  int  headingProfile(double eval_crs, const double *&pc,
+                      const double *&ps) const;
+  double evalCandidate(double eval_crs, double eval_spd,
+                       bool try_prune=true) const;
+  bool   reachPrune(double eval_crs, double eval_spd, double &util) const;
+  double evalAdaptive(double eval_spd, const double *pc,
+                      const double *ps, int plen) const;
+  int    adaptiveMult(int k, int plen, double clear, double accel,
+                      double tow_spd, double vs) const;
+  double evalFloat(double eval_spd, const double *pc,
+                   const double *ps, int plen) const;
+  double evalCascade(double eval_crs, double eval_spd, const double *pc,
+                     const double *ps, int plen) const;
+  double cascadeGap() const;
+  bool   evalSurrogate(double eval_crs, double eval_spd, const double *pc,
+                       const double *ps, int plen, double &util) const;
+  bool   evalTractrix(double eval_spd, const double *pc, const double *ps,
+                      int plen, double &util) const;
+  void   prepareTrajCache();
+  bool   trajSlot(double eval_crs, double eval_spd, unsigned int &c) const;
+  double evalTrajCache(double eval_crs, double eval_spd, const double *pc,
+                       const double *ps, int plen) const;
+  void   recordTrajSoA(double eval_spd, const double *pc, const double *ps,
+                       int plen, const TowTrajView& v) const;
+  bool   replayTrajectory(const TowTrajView& v, double &util) const;
+  void   clearEvalStats();
+  void   mergeWorkerStats(const AOF_TowObstacleAvoid& w);
+  bool   boxClearOfObstacle(int crs_lo, int crs_hi,
+                            int spd_lo, int spd_hi) const;
+  bool   boxTowSpeedClear(int crs_lo, int crs_hi,
+                          int spd_lo, int spd_hi) const;
+  double towBodyMinSpeed(double eval_spd, const double *pc,
+                         const double *ps, int plen) const;
+  void   mergeFlatBoxes(std::vector<IvPBox>& boxes,
+                        std::vector<IvPBox>& out) const;
+  void   simulate(double eval_crs, double eval_spd, const double *pc,
+                  const double *ps, int plen, bool cable_dyn,
+                  double init_min_dist, double &min_dist,
+                  int &contact_step, double &min_tow_spd,
+                  float *rec=0, double *gap=0) const;
+  bool   sideLockBlocks(double eval_crs) const;
+  bool   sideLockBlocks(const std::string& side_lock, double bng_to_ob,
+                        double eval_crs) const;
+  double utilityFromSim(double min_dist, int contact_step, int steps,
+                        double min_tow_spd) const;
+
+  // Four-lane kernels used by evalBatch()
+  void evalLanes4(const double *crs, const double *spd, double *utils) const;
+  void propagateTowLanes4(const double *ax, const double *ay, double dt,
+                          double *tx, double *ty,
+                          double *tvx, double *tvy) const;
+  void propagateCableLanes4(const double *ax, const double *ay,
+                            const double *tx, const double *ty, double dt,
+                            double *nx, double *ny,
+                            double *nvx, double *nvy) const;
   void propagateTowOneStep(double ax, double ay, double dt,
                            double &tx, double &ty,
                            double &tvx, double &tvy) const;
   double applyTowSpeedPenalty(double util, double tow_spd_metric) const;
-  double cableRelaxedMinDist(double ax, double ay, double tx, double ty,
-                             int num_nodes, double rest_length, int start,
-                             const XYPolygon &poly) const;
+  double cableRelaxedMinDist(double ax, double ay,
+                             double tx, double ty) const;
+  void   relaxCable(double ax, double ay, double tx, double ty,
+                    std::vector<double> &nx, std::vector<double> &ny) const;
+  double cableSegMinDist(const std::vector<double> &nx,
+                         const std::vector<double> &ny) const;
+  double sweptCableMinDist(const std::vector<double> &px,
+                           const std::vector<double> &py,
+                           const std::vector<double> &nx,
+                           const std::vector<double> &ny,
+                           double min_dist) const;
   void propagateCableOneStep(
     double ax, double ay,   // anchor (node 0, pinned)
     double tx, double ty,   // tow body (last node, pinned)
@@ -105,6 +332,7 @@ public:
   double m_k_spring;
   double m_cd;
   double m_c_tan;
+  TowIntegrator m_integrator;
 
   // Forward simulation params
   double m_sim_dt;
@@ -113,13 +341,66 @@ public:
 
   // Cable avoidance params
   bool   m_use_cable_dynamics;
-  double m_cable_sample_step;
   int    m_cable_check_interval;
   int    m_cable_start_node;
 
   // Side lock
   std::string m_side_lock;
 
+  // Reachability pruning
+  bool   m_reach_prune;
+
+  // Swept (continuous) contact checks between sim steps
+  bool   m_swept_check;
+
+  // Adaptive time step: largest step in seconds (0 = fixed sim_dt)
+  double m_adapt_max_dt;
+
+  // Use the node-count specialized cable kernels when available
+  bool   m_fixed_kernels;
+
+  // Simulate in single precision where supported (see evalFloat())
+  bool   m_float_eval;
+
+  // Relaxed-cable screening before full dynamics (see evalCascade())
+  bool   m_cascade;
+  double m_cascade_band;
+
+  // Optional precomputed tow response (see evalSurrogate())
+  std::shared_ptr<const TowSurrogate> m_surrogate;
+  double m_surr_pos_tol;
+  double m_surr_vel_tol;
+
+  // Tractrix tow model where it holds (see evalTractrix())
+  bool   m_tractrix;
+  double m_trx_pos_tol;
+  double m_trx_vel_tol;
+  double m_trx_min_v0;
+  double m_trx_cpa_margin;
+  double m_trx_spd_margin;
+
+  // Trajectories shared across AOFs (see evalTrajCache())
+  bool   m_traj_cache;
+  double m_traj_stamp;
+  double m_traj_max_mb;
+
+  // Optional signed-distance raster for the gut poly
+  std::shared_ptr<const PolySDFGrid> m_dist_grid;
+
+  // Further obstacles (see addObstacle())
+  std::vector<XYPolygon>   m_extra_guts;
+  std::vector<std::shared_ptr<const PolySDFGrid> > m_extra_grids;
+  std::vector<std::string> m_extra_locks;
+
+  // Optional cross-iteration eval cache (not owned). The owner
+  // calls beginBuild() with the state before evaluating.
+  TowEvalCache *m_eval_cache;
+
+  // Anytime build deadline (see setDeadline())
+  bool   m_has_deadline;
+  std::chrono::steady_clock::time_point m_deadline;
+  mutable bool m_expired;
+
   // Tow speed penalty params
   bool   m_penalize_low_tow_spd;
   double m_tow_spd_min;
@@ -127,6 +408,114 @@ public:
   double m_tow_spd_power;
   double m_tow_spd_floor;
 
+ private: // Prepared eval context (built once in initialize())
+  // Everything that does not depend on the candidate (course, speed)
+  // is computed once so evalBox() does no redundant setup.
+  bool      m_prepared;
+  PolyFieldDist m_gut;      // prepared distance to the gut poly(s)
+  bool      m_static_only;  // sim_horizon of -2: static cable check only
+  int       m_steps;        // forward sim steps over the horizon
+  int       m_num_nodes;    // cable node count (towCableNodes())
+  double    m_rest_length;  // rest length per cable segment
+  int       m_start_node;   // first node checked against the obstacle
+  double    m_ax0;          // initial anchor (stern attachment) x
+  double    m_ay0;          // initial anchor (stern attachment) y
+  double    m_bng_to_ob;    // bearing tow -> obstacle centroid (side lock)
+  std::vector<double> m_extra_bng;  // same, for each further obstacle
+  double    m_init_min_dist;   // min dist of the initial cable shape
+  std::vector<double> m_init_nx;  // initial straight-line cable nodes
+  std::vector<double> m_init_ny;
+  bool      m_reach_ok;      // context admits reachability pruning
+  double    m_reach_thresh;  // range that guarantees max utility
+  double    m_reach_margin;  // allowance for distance grid error
+  double    m_init_tow_dist; // initial tow body range to the obstacle
+  mutable unsigned int m_reach_checks;
+  mutable unsigned int m_reach_pruned;
+  TowCableStepFn  m_cable_step_fn;   // null: std::vector path
+  TowCableRelaxFn m_cable_relax_fn;
+  TowCableParams  m_cable_params;
+  bool      m_float_ok;      // context admits the float eval path
+  double    m_float_ox;      // float frame origin (initial ownship)
+  double    m_float_oy;
+  TowCableFns<float>::Step  m_fcable_step_fn;
+  TowCableFns<float>::Relax m_fcable_relax_fn;
+  TowCableParamsT<float>    m_fcable_params;
+  bool      m_cascade_ok;         // context admits cascaded screening
+  double    m_init_relaxed_dist;  // relaxed cable's initial range
+  double    m_cascade_gap;        // relaxed vs full node gap (m)
+  mutable unsigned long m_cascade_screened;
+  mutable unsigned long m_cascade_escalated;
+  bool      m_surr_ok;       // context admits the surrogate table
+  double    m_surr_v0;       // initial tow speed along ownship heading
+  double    m_surr_fc;       // ownship frame: forward unit vector
+  double    m_surr_fs;
+  mutable unsigned long m_surr_served;
+  mutable unsigned long m_surr_fallbacks;
+  bool      m_trx_ok;        // context admits the tractrix model
+  double    m_trx_ex;        // initial cable direction, tow to anchor
+  double    m_trx_ey;
+  double    m_trx_v0;        // initial tow speed along the cable
+  mutable unsigned long m_trx_served;
+  mutable unsigned long m_trx_fallbacks;
+  bool      m_traj_ok;       // context uses the shared trajectories
+  std::shared_ptr<TowTrajectorySet> m_traj_set;
+  unsigned int m_traj_pts;   // recorded points per check step
+  double    m_traj_ox;       // record frame origin (initial ownship)
+  double    m_traj_oy;
+  mutable unsigned long m_traj_hits;
+  mutable unsigned long m_traj_misses;
+  mutable unsigned long m_traj_live;
+  mutable std::vector<float> m_traj_scratch;  // record with no room
+  std::string m_mode_conflicts;  // bypassed modes (noteModeConflicts())
+  mutable std::vector<double> m_bound_tow_spd; // min tow speed per
+                                               // domain pt (-1 unknown)
+  mutable unsigned long m_bound_boxes;  // boxes bounded by findFlatBoxes()
+  bool      m_recording;     // evalBox() notes points only
+  bool      m_build_memo;    // table every evaluation (see setBuildMemo())
+  mutable std::vector<unsigned int>  m_rec_pts;   // noted, in order
+  mutable std::vector<unsigned char> m_pt_state;  // per domain pt:
+                                                  // 1 noted, 2 in table,
+                                                  // 3 in table and asked
+  mutable std::vector<double> m_pt_util;
+  mutable unsigned long m_pt_calls;
+  mutable unsigned long m_pt_served;
+  mutable unsigned long m_pt_dups;
+  bool      m_adapt_ok;      // context admits adaptive steps
+  double    m_adapt_cap;     // stability cap on the step (s)
+  mutable unsigned long m_sim_steps;
+  unsigned long m_dist_merged;   // distance queries of worker copies
+
+  // Per-course heading profile. The turn-rate-limited heading at
+  // each sim step depends only on the course and ownship heading,
+  // so cos/sin of it are tabulated once per course domain point and
+  // shared by every speed. Entry [ix*stride + k] is step k; past
+  // m_prof_len[ix] the heading has settled on the course and the
+  // last entry repeats. A length of 0 means no profile (evaluate
+  // the heading inline).
+  int                 m_prof_stride;
+  std::vector<double> m_prof_crs;
+  std::vector<int>    m_prof_len;
+  std::vector<double> m_prof_cos;
+  std::vector<double> m_prof_sin;
+
+  // Reusable scratch buffers, sized once in initialize() so the
+  // per-box evaluation makes no heap allocations. evalBox() is not
+  // reentrant on a single AOF instance; parallel builds give each
+  // worker a copy of the AOF, and so of these.
+  mutable std::vector<double> m_nx;
+  mutable std::vector<double> m_ny;
+  mutable std::vector<double> m_nvx;
+  mutable std::vector<double> m_nvy;
+  mutable std::vector<double> m_rx;
+  mutable std::vector<double> m_ry;
+  mutable std::vector<double> m_sx;   // cable at the previous step
+  mutable std::vector<double> m_sy;   // (swept checks)
+
+  // Node-major lane scratch for evalBatch(): [node*4 + lane]
+  mutable std::vector<double> m_bnx;
+  mutable std::vector<double> m_bny;
+  mutable std::vector<double> m_bnvx;
+  mutable std::vector<double> m_bnvy;
 };
 
 #endif
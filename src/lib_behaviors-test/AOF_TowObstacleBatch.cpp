@@ -0,0 +1,502 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AOF_TowObstacleBatch.cpp                        */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Batched (SIMD) evaluation for AOF_TowObstacleAvoid.      */
+/* Simulates four (course, speed) candidates together in    */
+/* structure-of-arrays lanes (see TowSimd.h). Each lane     */
+/* mirrors the scalar evalCandidate() operation for         */
+/* operation, so utilities match evalBox() bit-for-bit      */
+/* when the build does not contract a*b+c into FMAs (the    */
+/* default; see TOW_NATIVE_ARCH in the top CMakeLists.txt). */
+/* With FMA contraction enabled utilities agree to within   */
+/* rounding noise, amplified only where a lane crosses a    */
+/* discrete threshold (contact step, 5 m check band).       */
+/************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "AOF_TowObstacleAvoid.h"
+#include "AngleUtils.h"
+#include "TowSimd.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Procedure: batchSimdPath()
+//   Purpose: Name of the vector implementation compiled in
+//            ("avx", "sse2" or "scalar"), for reporting.
+
+const char* AOF_TowObstacleAvoid::batchSimdPath()
+{
+  return(towSimdPath());
+}
+
+//----------------------------------------------------------------
+// Procedure: evalBatch()
+//   Purpose: Evaluate n candidates given in domain units. Those
+//            settled by reachPrune() are filled in directly; the
+//            rest are gathered into groups of four for the SIMD
+//            lanes. The remainder and configurations the lane
+//            kernel does not cover (swept checks, adaptive steps,
+//            integrators other than Euler, float evaluation,
+//            cascaded screening, a surrogate table, the tractrix
+//            model, shared trajectories) fall back to
+//            evalCandidate().
+
+void AOF_TowObstacleAvoid::evalBatch(const double *crs, const double *spd,
+                                     unsigned int n, double *utils) const
+{
+  bool lanes_ok = m_tow_eval && m_tow_pose_set && m_dyn_params_set &&
+    m_prepared && (m_cable_length > 0) && (m_sim_dt > 0) && !m_swept_check &&
+    !m_adapt_ok && !m_float_ok && !m_cascade_ok && !m_surr_ok &&
+    !m_trx_ok && !m_traj_ok && (m_integrator == TOW_INT_EULER);
+
+  if(!lanes_ok) {
+    for(unsigned int i = 0; i < n; i++)
+      utils[i] = evalCandidate(crs[i], spd[i]);
+    return;
+  }
+
+  double       g_crs[4], g_spd[4], g_util[4];
+  unsigned int g_ix[4];
+  unsigned int g = 0;
+
+  for(unsigned int i = 0; i < n; i++) {
+    double util = 0;
+    if(!sideLockBlocks(crs[i]) && reachPrune(crs[i], spd[i], util)) {
+      utils[i] = util;
+      continue;
+    }
+    g_crs[g] = crs[i];
+    g_spd[g] = spd[i];
+    g_ix[g]  = i;
+    g++;
+    if(g == 4) {
+      evalLanes4(g_crs, g_spd, g_util);
+      for(unsigned int l = 0; l < 4; l++)
+        utils[g_ix[l]] = g_util[l];
+      g = 0;
+    }
+  }
+  for(unsigned int l = 0; l < g; l++)
+    utils[g_ix[l]] = evalCandidate(g_crs[l], g_spd[l], false);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalLanes4()
+//   Purpose: Forward-simulate four candidates in lockstep. Lanes
+//            that reach contact (or are blocked by the side lock)
+//            are frozen out of the bookkeeping; the loop ends once
+//            every lane is done.
+
+void AOF_TowObstacleAvoid::evalLanes4(const double *crs, const double *spd,
+                                      double *utils) const
+{
+  const int L = 4;
+  int num_nodes = m_num_nodes;
+  int start     = m_start_node;
+  int steps     = m_steps;
+  double dt     = m_sim_dt;
+
+  if(steps <= 0 && !m_static_only) {
+    for(int l = 0; l < L; l++)
+      utils[l] = sideLockBlocks(crs[l]) ? getKnownMin() : getKnownMax();
+    return;
+  }
+
+  // Per-lane scalar bookkeeping
+  bool   active[L];
+  double min_dist[L];
+  double min_tow_spd[L];
+  int    contact_step[L];
+  double vh[L];
+  const double *pc[L];
+  const double *ps[L];
+  int    plen[L];
+
+  // Per-lane state in SoA form
+  double osx[L], osy[L], ax[L], ay[L];
+  double tx[L], ty[L], tvx[L], tvy[L];
+  double hc[L], hs[L];
+  double spd_l[L];
+
+  double *nx  = &m_bnx[0];
+  double *ny  = &m_bny[0];
+  double *nvx = &m_bnvx[0];
+  double *nvy = &m_bnvy[0];
+
+  bool any_active = false;
+  for(int l = 0; l < L; l++) {
+    active[l]       = !sideLockBlocks(crs[l]);
+    min_dist[l]     = m_init_min_dist;
+    min_tow_spd[l]  = 1e9;
+    contact_step[l] = -1;
+    if(min_dist[l] <= 0)
+      contact_step[l] = 0;
+    if(contact_step[l] >= 0)
+      active[l] = false;
+    any_active = any_active || active[l];
+
+    vh[l]    = m_obship_model.getOSH();
+    osx[l]   = m_obship_model.getOSX();
+    osy[l]   = m_obship_model.getOSY();
+    tx[l]    = m_tow_x;
+    ty[l]    = m_tow_y;
+    tvx[l]   = m_tow_vx;
+    tvy[l]   = m_tow_vy;
+    spd_l[l] = spd[l];
+    plen[l]  = headingProfile(crs[l], pc[l], ps[l]);
+  }
+
+  if(m_use_cable_dynamics) {
+    for(int i = 0; i < num_nodes; i++) {
+      for(int l = 0; l < L; l++) {
+        nx[i*L + l]  = m_init_nx[i];
+        ny[i*L + l]  = m_init_ny[i];
+        nvx[i*L + l] = 0;
+        nvy[i*L + l] = 0;
+      }
+    }
+  }
+
+  for(int k = 0; (k < steps) && any_active; k++) {
+
+    // Heading per lane from the course profile, else inline
+    for(int l = 0; l < L; l++) {
+      if(plen[l] > 0) {
+        int j = (k < plen[l]) ? k : plen[l] - 1;
+        hc[l] = pc[l][j];
+        hs[l] = ps[l][j];
+        continue;
+      }
+      if(m_turn_rate_max > 0) {
+        double diff = angleDiff(crs[l], vh[l]);
+        double step_deg = m_turn_rate_max * dt;
+        if(fabs(diff) <= step_deg)
+          vh[l] = crs[l];
+        else
+          vh[l] = angle360(vh[l] + (diff > 0 ? step_deg : -step_deg));
+      }
+      else
+        vh[l] = crs[l];
+      double hdg_rad = (90.0 - vh[l]) * M_PI / 180.0;
+      hc[l] = cos(hdg_rad);
+      hs[l] = sin(hdg_rad);
+    }
+
+    // Vessel kinematics and anchor point
+    TowVec4d v_dt(dt);
+    TowVec4d v_off(m_attach_offset);
+    TowVec4d v_vs  = TowVec4d::load(spd_l);
+    TowVec4d v_hc  = TowVec4d::load(hc);
+    TowVec4d v_hs  = TowVec4d::load(hs);
+    TowVec4d v_osx = TowVec4d::load(osx) + v_vs * v_hc * v_dt;
+    TowVec4d v_osy = TowVec4d::load(osy) + v_vs * v_hs * v_dt;
+    TowVec4d v_ax  = v_osx - v_off * v_hc;
+    TowVec4d v_ay  = v_osy - v_off * v_hs;
+    v_osx.store(osx);
+    v_osy.store(osy);
+    v_ax.store(ax);
+    v_ay.store(ay);
+
+    // Tow body endpoint
+    propagateTowLanes4(ax, ay, dt, tx, ty, tvx, tvy);
+
+    if(m_use_cable_dynamics)
+      propagateCableLanes4(ax, ay, tx, ty, dt, nx, ny, nvx, nvy);
+
+    // Which lanes need the full cable check this step
+    bool full_check[L];
+    bool any_full = false;
+    bool any_tow  = false;
+    for(int l = 0; l < L; l++) {
+      full_check[l] = active[l] &&
+        ((k % m_cable_check_interval == 0) || (min_dist[l] < 5.0));
+      any_full = any_full || full_check[l];
+      any_tow  = any_tow || (active[l] && !full_check[l]);
+    }
+
+    // Obstacle distances for all four lanes per kernel pass. Node i
+    // of every lane is contiguous, as are the tow positions.
+    double node_min[L] = {1e9, 1e9, 1e9, 1e9};
+    double tow_d[L];
+    if(m_use_cable_dynamics && any_full) {
+      double d4[L];
+      for(int i = start; i < num_nodes; i++) {
+        m_gut.dist(nx + i*L, ny + i*L, L, d4);
+        for(int l = 0; l < L; l++)
+          node_min[l] = std::min(node_min[l], d4[l]);
+      }
+    }
+    if(any_tow)
+      m_gut.dist(tx, ty, L, tow_d);
+
+    // Per-lane bookkeeping (mirrors evalCandidate())
+    any_active = false;
+    for(int l = 0; l < L; l++) {
+      if(!active[l])
+        continue;
+
+      m_sim_steps++;
+      double tow_spd = towHypot(tvx[l], tvy[l]);
+      if(tow_spd < min_tow_spd[l])
+        min_tow_spd[l] = tow_spd;
+
+      if(m_use_cable_dynamics && full_check[l]) {
+        double d = node_min[l];
+        if(d < 0) d = 0;
+        min_dist[l] = std::min(min_dist[l], d);
+      }
+      else if(full_check[l]) {
+        double d = cableRelaxedMinDist(ax[l], ay[l], tx[l], ty[l]);
+        min_dist[l] = std::min(min_dist[l], d);
+      }
+      else {
+        double d = tow_d[l];
+        if(d < 0) d = 0;
+        min_dist[l] = std::min(min_dist[l], d);
+      }
+
+      if(min_dist[l] <= 0) {
+        contact_step[l] = k + 1;
+        active[l] = false;
+      }
+      any_active = any_active || active[l];
+    }
+  }
+
+  for(int l = 0; l < L; l++) {
+    if(sideLockBlocks(crs[l]))
+      utils[l] = getKnownMin();
+    else
+      utils[l] = utilityFromSim(min_dist[l], contact_step[l], steps,
+                                min_tow_spd[l]);
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: propagateTowLanes4()
+//   Purpose: Four-lane version of propagateTowOneStep(). Branches
+//            become lane masks; the operation order matches the
+//            scalar code so each lane rounds identically. Requires
+//            m_cable_length > 0 (checked by evalBatch()).
+
+void AOF_TowObstacleAvoid::propagateTowLanes4(const double *ax_l, const double *ay_l,
+                                              double dt, double *tx_l, double *ty_l,
+                                              double *tvx_l, double *tvy_l) const
+{
+  if(!(dt > 0))
+    return;
+  dt = std::max(dt, 1e-3);
+
+  TowVec4d v_dt(dt);
+  TowVec4d v_len(m_cable_length);
+  TowVec4d v_zero(0.0);
+
+  TowVec4d ax  = TowVec4d::load(ax_l);
+  TowVec4d ay  = TowVec4d::load(ay_l);
+  TowVec4d tx  = TowVec4d::load(tx_l);
+  TowVec4d ty  = TowVec4d::load(ty_l);
+  TowVec4d tvx = TowVec4d::load(tvx_l);
+  TowVec4d tvy = TowVec4d::load(tvy_l);
+
+  // Vector from tow body to anchor point
+  TowVec4d dx = ax - tx;
+  TowVec4d dy = ay - ty;
+  TowVec4d distance = towHypot(dx, dy);
+
+  // Lanes co-located with the anchor get drag only (no spring,
+  // tangential damping or clamp), as in the scalar early return
+  TowMask4d far = distance > TowVec4d(0.01);
+
+  // Unit vector along cable (tow -> anchor); distance > 0.01 on
+  // every lane that uses it, so the 1e-6 guard never applies
+  TowVec4d ux = dx / distance;
+  TowVec4d uy = dy / distance;
+  TowVec4d nx = -uy;
+  TowVec4d ny = ux;
+
+  // Spring tension when cable is overstretched
+  if(m_k_spring > 0) {
+    TowMask4d m = far & (distance > v_len);
+    TowVec4d overshoot = distance - v_len;
+    TowVec4d kk(m_k_spring);
+    tvx = towSelect(m, tvx + kk * overshoot * ux * v_dt, tvx);
+    tvy = towSelect(m, tvy + kk * overshoot * uy * v_dt, tvy);
+  }
+
+  // Quadratic drag
+  if(m_cd > 0) {
+    TowVec4d speed = towHypot(tvx, tvy);
+    TowMask4d m = speed > TowVec4d(1e-6);
+    TowVec4d ncd(-m_cd);
+    tvx = towSelect(m, tvx + ncd * tvx * speed * v_dt, tvx);
+    tvy = towSelect(m, tvy + ncd * tvy * speed * v_dt, tvy);
+  }
+
+  // Tangential damping (penalizes sideways motion)
+  if(m_c_tan > 0) {
+    TowVec4d vt = tvx * nx + tvy * ny;
+    TowVec4d nct(-m_c_tan);
+    tvx = towSelect(far, tvx + nct * vt * nx * v_dt, tvx);
+    tvy = towSelect(far, tvy + nct * vt * ny * v_dt, tvy);
+  }
+
+  // Euler position integration
+  tx = tx + tvx * v_dt;
+  ty = ty + tvy * v_dt;
+
+  // Rigid cable clamp: project tow back onto cable radius
+  TowVec4d sx = ax - tx;
+  TowVec4d sy = ay - ty;
+  TowVec4d dist_a = towHypot(sx, sy);
+  TowMask4d clamp = far & (dist_a > v_len) & (dist_a > TowVec4d(1e-9));
+  if(clamp.any()) {
+    TowVec4d sc = v_len / dist_a;
+    tx = towSelect(clamp, ax - sx * sc, tx);
+    ty = towSelect(clamp, ay - sy * sc, ty);
+
+    // Remove outward radial velocity component
+    TowVec4d urx  = sx / dist_a;
+    TowVec4d ury  = sy / dist_a;
+    TowVec4d vrad = tvx * urx + tvy * ury;
+    TowMask4d out = clamp & (vrad < v_zero);
+    tvx = towSelect(out, tvx - vrad * urx, tvx);
+    tvy = towSelect(out, tvy - vrad * ury, tvy);
+  }
+
+  tx.store(tx_l);
+  ty.store(ty_l);
+  tvx.store(tvx_l);
+  tvy.store(tvy_l);
+}
+
+//----------------------------------------------------------------
+// Procedure: propagateCableLanes4()
+//   Purpose: Four-lane version of propagateCableOneStep(). Node
+//            arrays are laid out node-major: element [i*4 + lane].
+
+void AOF_TowObstacleAvoid::propagateCableLanes4(const double *ax_l, const double *ay_l,
+                                                const double *tx_l, const double *ty_l,
+                                                double dt,
+                                                double *nx, double *ny,
+                                                double *nvx, double *nvy) const
+{
+  const int L = 4;
+  int num_nodes = m_num_nodes;
+  dt = std::max(dt, 1e-3);
+
+  TowVec4d v_dt(dt);
+  TowVec4d v_rest(m_rest_length);
+  TowVec4d v_zero(0.0);
+  TowVec4d v_kk(m_k_spring);
+  TowVec4d v_ncd(-m_cd);
+  TowVec4d v_nct(-m_c_tan);
+
+  // Pin endpoints
+  TowVec4d::load(ax_l).store(nx);
+  TowVec4d::load(ay_l).store(ny);
+  v_zero.store(nvx);
+  v_zero.store(nvy);
+  int last = (num_nodes - 1) * L;
+  TowVec4d::load(tx_l).store(nx + last);
+  TowVec4d::load(ty_l).store(ny + last);
+  v_zero.store(nvx + last);
+  v_zero.store(nvy + last);
+
+  // Interior node dynamics — mirrors propagateCableOneStep()
+  for(int i = 1; i < num_nodes - 1; i++) {
+    TowVec4d px  = TowVec4d::load(nx + (i-1)*L);
+    TowVec4d py  = TowVec4d::load(ny + (i-1)*L);
+    TowVec4d cx  = TowVec4d::load(nx + i*L);
+    TowVec4d cy  = TowVec4d::load(ny + i*L);
+    TowVec4d qx  = TowVec4d::load(nx + (i+1)*L);
+    TowVec4d qy  = TowVec4d::load(ny + (i+1)*L);
+    TowVec4d vx  = TowVec4d::load(nvx + i*L);
+    TowVec4d vy  = TowVec4d::load(nvy + i*L);
+
+    if(m_k_spring > 0) {
+      // Spring from previous neighbor
+      TowVec4d dx_prev   = px - cx;
+      TowVec4d dy_prev   = py - cy;
+      TowVec4d dist_prev = towHypot(dx_prev, dy_prev);
+      TowMask4d mp = (dist_prev > TowVec4d(0.01)) & (dist_prev > v_rest);
+      TowVec4d over_p = dist_prev - v_rest;
+      vx = towSelect(mp, vx + v_kk * over_p * (dx_prev / dist_prev) * v_dt, vx);
+      vy = towSelect(mp, vy + v_kk * over_p * (dy_prev / dist_prev) * v_dt, vy);
+
+      // Spring from next neighbor
+      TowVec4d dx_next   = qx - cx;
+      TowVec4d dy_next   = qy - cy;
+      TowVec4d dist_next = towHypot(dx_next, dy_next);
+      TowMask4d mn = (dist_next > TowVec4d(0.01)) & (dist_next > v_rest);
+      TowVec4d over_n = dist_next - v_rest;
+      vx = towSelect(mn, vx + v_kk * over_n * (dx_next / dist_next) * v_dt, vx);
+      vy = towSelect(mn, vy + v_kk * over_n * (dy_next / dist_next) * v_dt, vy);
+    }
+
+    // Quadratic drag
+    if(m_cd > 0) {
+      TowVec4d speed = towHypot(vx, vy);
+      TowMask4d m = speed > TowVec4d(1e-6);
+      vx = towSelect(m, vx + v_ncd * vx * speed * v_dt, vx);
+      vy = towSelect(m, vy + v_ncd * vy * speed * v_dt, vy);
+    }
+
+    // Tangential damping
+    if(m_c_tan > 0) {
+      TowVec4d tcx  = qx - px;
+      TowVec4d tcy  = qy - py;
+      TowVec4d clen = towHypot(tcx, tcy);
+      TowMask4d m = clen > TowVec4d(1e-6);
+      TowVec4d utx = tcx / clen;
+      TowVec4d uty = tcy / clen;
+      TowVec4d perpx = -uty;
+      TowVec4d perpy = utx;
+      TowVec4d vn = vx * perpx + vy * perpy;
+      vx = towSelect(m, vx + v_nct * vn * perpx * v_dt, vx);
+      vy = towSelect(m, vy + v_nct * vn * perpy * v_dt, vy);
+    }
+
+    // Euler integration
+    (cx + vx * v_dt).store(nx + i*L);
+    (cy + vy * v_dt).store(ny + i*L);
+    vx.store(nvx + i*L);
+    vy.store(nvy + i*L);
+  }
+
+  // Forward and backward constraint passes
+  for(int pass = 0; pass < 2; pass++) {
+    for(int j = 1; j < num_nodes - 1; j++) {
+      int i  = (pass == 0) ? j : (num_nodes - 1 - j);
+      int nb = (pass == 0) ? (i - 1) : (i + 1);
+
+      TowVec4d bx = TowVec4d::load(nx + nb*L);
+      TowVec4d by = TowVec4d::load(ny + nb*L);
+      TowVec4d cx = TowVec4d::load(nx + i*L);
+      TowVec4d cy = TowVec4d::load(ny + i*L);
+      TowVec4d dx = bx - cx;
+      TowVec4d dy = by - cy;
+      TowVec4d dist = towHypot(dx, dy);
+      TowMask4d m = (dist > v_rest) & (dist > TowVec4d(1e-9));
+      if(!m.any())
+        continue;
+
+      TowVec4d sc = v_rest / dist;
+      towSelect(m, bx - dx * sc, cx).store(nx + i*L);
+      towSelect(m, by - dy * sc, cy).store(ny + i*L);
+
+      TowVec4d vx = TowVec4d::load(nvx + i*L);
+      TowVec4d vy = TowVec4d::load(nvy + i*L);
+      TowVec4d urx  = dx / dist;
+      TowVec4d ury  = dy / dist;
+      TowVec4d vrad = vx * urx + vy * ury;
+      TowMask4d out = m & (vrad < v_zero);
+      towSelect(out, vx - vrad * urx, vx).store(nvx + i*L);
+      towSelect(out, vy - vrad * ury, vy).store(nvy + i*L);
+    }
+  }
+}
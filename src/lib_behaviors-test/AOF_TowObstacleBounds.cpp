@@ -0,0 +1,380 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AOF_TowObstacleBounds.cpp                       */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Interval evaluation for AOF_TowObstacleAvoid: bounds on  */
+/* the utility of every candidate in a (course x speed) box */
+/* without simulating the cable, and a recursive split of   */
+/* the domain into boxes whose bounds collapse. Those are   */
+/* handed to OF_Reflector as plateau (max utility) and      */
+/* basin (min utility) regions, so it can cover each with   */
+/* one flat piece instead of sampling its interior.         */
+/*                                                          */
+/* The range bound: the rigid clamp keeps the tow within    */
+/* the cable length L of the anchor after every step, and   */
+/* every checked cable point lies within L of the tow (see  */
+/* reachPrune()), so all of them are within 2L of the       */
+/* anchor. For one course the anchor at step k is           */
+/* os0 + v*P(k) - offset*h(k), with P(k) the summed heading */
+/* profile times dt: over a speed range it sweeps a segment */
+/* whose midpoint is queried, less half its length. Range   */
+/* is 1-Lipschitz, so like reachPrune() an exact query is   */
+/* made only when the bound from the last one gets weak.    */
+/*                                                          */
+/* The tow speed penalty is bounded by propagating the tow  */
+/* body alone for each candidate (no cable), memoized per   */
+/* domain point until the next initialize().                */
+/************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "AOF_TowObstacleAvoid.h"
+#include "TowSimd.h"
+
+using namespace std;
+
+namespace {
+
+// Orders boxes by speed range, then by first course
+struct FlatBoxOrder {
+  int cix, six;
+  FlatBoxOrder(int c, int s) : cix(c), six(s) {}
+  bool operator()(const IvPBox& a, const IvPBox& b) const {
+    if(a.pt(six, 0) != b.pt(six, 0))
+      return(a.pt(six, 0) < b.pt(six, 0));
+    if(a.pt(six, 1) != b.pt(six, 1))
+      return(a.pt(six, 1) < b.pt(six, 1));
+    return(a.pt(cix, 0) < b.pt(cix, 0));
+  }
+};
+
+}
+
+//----------------------------------------------------------------
+// Procedure: evalBoxBounds()
+//   Purpose: Conservative bounds [lo, hi] on evalBox() over every
+//            domain point in box b. lo == hi == getKnownMax() means
+//            every candidate is provably beyond max_util_cpa over
+//            the horizon with no tow speed penalty; lo == hi ==
+//            getKnownMin() that the side lock blocks every course.
+//            Otherwise the bounds are [min, max] of what could be
+//            shown cheaply, and may be loose.
+
+void AOF_TowObstacleAvoid::evalBoxBounds(const IvPBox *b, double &lo,
+                                         double &hi) const
+{
+  double umin = getKnownMin();
+  double umax = getKnownMax();
+  lo = umin;
+  hi = umax;
+
+  // evalCandidate() gives max utility to every candidate here
+  if(!m_tow_eval || !m_tow_pose_set || !m_dyn_params_set || !m_prepared) {
+    lo = umax;
+    return;
+  }
+
+  int crs_lo = b->pt(m_crs_ix, 0);
+  int crs_hi = b->pt(m_crs_ix, 1);
+  int spd_lo = b->pt(m_spd_ix, 0);
+  int spd_hi = b->pt(m_spd_ix, 1);
+  if((crs_hi < crs_lo) || (spd_hi < spd_lo))
+    return;
+
+  // Side lock depends on the course alone
+  int blocked = 0;
+  for(int ci = crs_lo; ci <= crs_hi; ci++) {
+    double eval_crs = 0;
+    m_domain.getVal(m_crs_ix, ci, eval_crs);
+    if(sideLockBlocks(eval_crs))
+      blocked++;
+  }
+  if(blocked == (crs_hi - crs_lo + 1)) {
+    hi = umin;
+    return;
+  }
+  if(blocked > 0)
+    return;
+
+  // Needs the same context as reachPrune(): a tethered tow, a
+  // forward sim, and an initial cable beyond max_util_cpa. The
+  // surrogate blends trajectories of neighbouring courses, which
+  // the anchor bound does not cover.
+  if(!m_reach_ok || m_surr_ok || m_static_only)
+    return;
+
+  // Lower bound on the penalized utility of any candidate not yet
+  // shown to keep its tow speed up
+  double pen_lo = applyTowSpeedPenalty(umax, 0);
+
+  if(!boxClearOfObstacle(crs_lo, crs_hi, spd_lo, spd_hi)) {
+    lo = umin;
+    return;
+  }
+
+  // Beyond max_util_cpa throughout: only the penalty is left
+  lo = pen_lo;
+  if(!boxTowSpeedClear(crs_lo, crs_hi, spd_lo, spd_hi))
+    return;
+  lo = umax;
+}
+
+//----------------------------------------------------------------
+// Procedure: boxClearOfObstacle()
+//   Purpose: True if every checked cable point of every candidate
+//            in the box stays beyond max_util_cpa (plus grid error)
+//            over the horizon, by the anchor bound above.
+//
+//   Adaptive steps land on a subset of the fixed-step anchor
+//   positions (steps only grow once the heading has settled), so
+//   the bound covers them too. With swept checks the region
+//   between two steps lies within 2L of the anchor's segment, so
+//   each step also gives up the length of that segment.
+
+bool AOF_TowObstacleAvoid::boxClearOfObstacle(int crs_lo, int crs_hi,
+                                              int spd_lo, int spd_hi) const
+{
+  double v_lo = 0, v_hi = 0;
+  m_domain.getVal(m_spd_ix, spd_lo, v_lo);
+  m_domain.getVal(m_spd_ix, spd_hi, v_hi);
+  double v_mid  = 0.5 * (v_lo + v_hi);
+  double v_half = 0.5 * (v_hi - v_lo);
+
+  // Slack for rounding in the constraint passes and float eval
+  double margin = 1e-3 * (1 + m_cable_length);
+  double need = m_reach_thresh + m_reach_margin + 2 * m_cable_length + margin;
+
+  double dt  = m_sim_dt;
+  double off = m_attach_offset;
+  double osx = m_obship_model.getOSX();
+  double osy = m_obship_model.getOSY();
+
+  for(int ci = crs_lo; ci <= crs_hi; ci++) {
+    double eval_crs = 0;
+    m_domain.getVal(m_crs_ix, ci, eval_crs);
+    const double *pc = 0;
+    const double *ps = 0;
+    int plen = headingProfile(eval_crs, pc, ps);
+    if(plen <= 0)
+      return(false);
+
+    double px = 0, py = 0;
+    double ref_x = 0, ref_y = 0, ref_d = -1;
+    double prev_hc = cos((90.0 - m_obship_model.getOSH()) * M_PI / 180.0);
+    double prev_hs = sin((90.0 - m_obship_model.getOSH()) * M_PI / 180.0);
+    for(int k = 0; k < m_steps; k++) {
+      int j = (k < plen) ? k : plen - 1;
+      double hc = pc[j];
+      double hs = ps[j];
+      px += hc * dt;
+      py += hs * dt;
+      double mx = osx + v_mid * px - off * hc;
+      double my = osy + v_mid * py - off * hs;
+
+      double spread = v_half * towHypot(px, py);
+      if(m_swept_check) {
+        spread += v_hi * dt + off * towHypot(hc - prev_hc, hs - prev_hs);
+        prev_hc = hc;
+        prev_hs = hs;
+      }
+
+      double bound = ref_d - towHypot(mx - ref_x, my - ref_y) - spread;
+      if((ref_d < 0) || (bound < need)) {
+        ref_x = mx;
+        ref_y = my;
+        ref_d = std::max(0.0, m_gut.exactDist(mx, my));
+        if(ref_d - spread < need)
+          return(false);
+      }
+    }
+  }
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: boxTowSpeedClear()
+//   Purpose: True if no candidate in the box can draw a tow speed
+//            penalty. The tow body does not depend on the cable
+//            nodes, so its fixed-step propagation alone gives the
+//            exact min tow speed of simulate(). Adaptive steps and
+//            the tractrix model track it differently, so with the
+//            penalty on they are not bounded.
+
+bool AOF_TowObstacleAvoid::boxTowSpeedClear(int crs_lo, int crs_hi,
+                                            int spd_lo, int spd_hi) const
+{
+  if(!m_penalize_low_tow_spd)
+    return(true);
+  double thresh = std::max(m_tow_spd_min, m_tow_spd_hard_min);
+  if(!(thresh > 0))
+    return(true);
+  if(m_adapt_ok || m_trx_ok)
+    return(false);
+
+  // Allowance for the float path's rounding
+  thresh += 1e-3;
+
+  unsigned int num_spd = m_domain.getVarPoints(m_spd_ix);
+  unsigned int num_crs = m_domain.getVarPoints(m_crs_ix);
+  if(m_bound_tow_spd.size() != num_crs * num_spd)
+    m_bound_tow_spd.assign(num_crs * num_spd, -1);
+
+  // Slowest speeds first: they are the likeliest to fail
+  for(int si = spd_lo; si <= spd_hi; si++) {
+    double eval_spd = 0;
+    m_domain.getVal(m_spd_ix, si, eval_spd);
+    for(int ci = crs_lo; ci <= crs_hi; ci++) {
+      double &memo = m_bound_tow_spd[ci * num_spd + si];
+      if(memo < 0) {
+        double eval_crs = 0;
+        m_domain.getVal(m_crs_ix, ci, eval_crs);
+        const double *pc = 0;
+        const double *ps = 0;
+        int plen = headingProfile(eval_crs, pc, ps);
+        if(plen <= 0)
+          return(false);
+        memo = towBodyMinSpeed(eval_spd, pc, ps, plen);
+      }
+      if(memo < thresh)
+        return(false);
+    }
+  }
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: towBodyMinSpeed()
+//   Purpose: Min tow speed over the horizon of one candidate,
+//            propagating ownship and the tow body only, as the
+//            fixed-step simulate() does.
+
+double AOF_TowObstacleAvoid::towBodyMinSpeed(double eval_spd,
+                                             const double *pc,
+                                             const double *ps,
+                                             int plen) const
+{
+  double dt = m_sim_dt;
+  double vs = eval_spd;
+  double osx = m_obship_model.getOSX();
+  double osy = m_obship_model.getOSY();
+  double tx  = m_tow_x;
+  double ty  = m_tow_y;
+  double tvx = m_tow_vx;
+  double tvy = m_tow_vy;
+  double min_tow_spd = 1e9;
+
+  for(int k = 0; k < m_steps; k++) {
+    int j = (k < plen) ? k : plen - 1;
+    double hc = pc[j];
+    double hs = ps[j];
+    osx += vs * hc * dt;
+    osy += vs * hs * dt;
+    double ax = osx - m_attach_offset * hc;
+    double ay = osy - m_attach_offset * hs;
+
+    propagateTowOneStep(ax, ay, dt, tx, ty, tvx, tvy);
+    min_tow_spd = std::min(min_tow_spd, towHypot(tvx, tvy));
+  }
+  return(min_tow_spd);
+}
+
+//----------------------------------------------------------------
+// Procedure: findFlatBoxes()
+//   Purpose: Split the domain into boxes by halving the longer
+//            side (in units of the minimum box, so every cut lies
+//            on the min_crs x min_spd grid) until a box's bounds
+//            collapse or it reaches the minimum size. Collapsed
+//            boxes go to plateaus (max utility) or basins (min
+//            utility), with neighbours along the course axis over
+//            the same speeds merged. Call after initialize().
+
+void AOF_TowObstacleAvoid::findFlatBoxes(unsigned int min_crs,
+                                         unsigned int min_spd,
+                                         vector<IvPBox>& plateaus,
+                                         vector<IvPBox>& basins) const
+{
+  m_bound_boxes = 0;
+  if((m_crs_ix < 0) || (m_spd_ix < 0))
+    return;
+
+  int dim = (int)m_domain.size();
+  IvPBox root(dim);
+  for(int d = 0; d < dim; d++)
+    root.setPTS(d, 0, (int)m_domain.getVarPoints(d) - 1);
+
+  int unit_crs = (int)std::max(min_crs, 1u);
+  int unit_spd = (int)std::max(min_spd, 1u);
+
+  vector<IvPBox> flat_hi, flat_lo;
+  vector<IvPBox> todo(1, root);
+  while(!todo.empty()) {
+    IvPBox box = todo.back();
+    todo.pop_back();
+
+    double lo = 0, hi = 0;
+    evalBoxBounds(&box, lo, hi);
+    m_bound_boxes++;
+    if(lo >= getKnownMax()) {
+      flat_hi.push_back(box);
+      continue;
+    }
+    if(hi <= getKnownMin()) {
+      flat_lo.push_back(box);
+      continue;
+    }
+
+    int c0 = box.pt(m_crs_ix, 0), c1 = box.pt(m_crs_ix, 1);
+    int s0 = box.pt(m_spd_ix, 0), s1 = box.pt(m_spd_ix, 1);
+    int crs_units = (c1 - c0 + unit_crs) / unit_crs;
+    int spd_units = (s1 - s0 + unit_spd) / unit_spd;
+    if((crs_units <= 1) && (spd_units <= 1))
+      continue;
+
+    IvPBox half_a = box;
+    IvPBox half_b = box;
+    if(crs_units >= spd_units) {
+      int mid = c0 + unit_crs * ((crs_units + 1) / 2);
+      half_a.setPTS(m_crs_ix, c0, mid - 1);
+      half_b.setPTS(m_crs_ix, mid, c1);
+    }
+    else {
+      int mid = s0 + unit_spd * ((spd_units + 1) / 2);
+      half_a.setPTS(m_spd_ix, s0, mid - 1);
+      half_b.setPTS(m_spd_ix, mid, s1);
+    }
+    todo.push_back(half_b);
+    todo.push_back(half_a);
+  }
+
+  mergeFlatBoxes(flat_hi, plateaus);
+  mergeFlatBoxes(flat_lo, basins);
+}
+
+//----------------------------------------------------------------
+// Procedure: mergeFlatBoxes()
+//   Purpose: Append boxes to out, joining runs that span the same
+//            speeds and abut along the course axis.
+
+void AOF_TowObstacleAvoid::mergeFlatBoxes(vector<IvPBox>& boxes,
+                                          vector<IvPBox>& out) const
+{
+  int cix = m_crs_ix;
+  int six = m_spd_ix;
+  std::sort(boxes.begin(), boxes.end(), FlatBoxOrder(cix, six));
+
+  for(unsigned int i = 0; i < boxes.size(); i++) {
+    const IvPBox& b = boxes[i];
+    if(!out.empty() && (i > 0)) {
+      IvPBox& last = out.back();
+      if((last.pt(six, 0) == b.pt(six, 0)) &&
+         (last.pt(six, 1) == b.pt(six, 1)) &&
+         (last.pt(cix, 1) + 1 == b.pt(cix, 0))) {
+        last.setPTS(cix, last.pt(cix, 0), b.pt(cix, 1));
+        continue;
+      }
+    }
+    out.push_back(b);
+  }
+}
@@ -0,0 +1,118 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AOF_TowObstacleFloat.cpp                        */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Single-precision evaluation for AOF_TowObstacleAvoid.    */
+/* Runs the fixed-step Euler forward simulation of          */
+/* evalCandidate() with the tow, cable and distance kernels */
+/* instantiated for float (TowCableKernel.h, and the local  */
+/* frame tables of ConvexPolyDist). Positions are taken     */
+/* relative to the initial ownship position so they stay    */
+/* within a few hundred meters of the origin.               */
+/*                                                          */
+/* Reach pruning, the heading profile and the utility       */
+/* mapping stay in double. Results differ from the double   */
+/* path by rounding, amplified only where a candidate       */
+/* crosses a discrete threshold (contact step, 5 m check    */
+/* band); app_aof_bench --mode=precision reports the worst  */
+/* case over the domain.                                    */
+/************************************************************/
+
+#include <algorithm>
+#include "AOF_TowObstacleAvoid.h"
+#include "TowSimd.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Procedure: evalFloat()
+//   Purpose: Forward simulate one candidate speed along a heading
+//            profile in single precision and return its utility.
+//            Requires m_float_ok (see prepareEvalContext()).
+
+double AOF_TowObstacleAvoid::evalFloat(double eval_spd, const double *pc,
+                                       const double *ps, int plen) const
+{
+  const float dt     = (float)m_sim_dt;
+  const float dyn_dt = (float)std::max(m_sim_dt, 1e-3);
+  const float vs     = (float)eval_spd;
+  const float offset = (float)m_attach_offset;
+  const TowCableParamsT<float>& prm = m_fcable_params;
+
+  // Ownship starts at the frame origin
+  float osx = 0;
+  float osy = 0;
+
+  // Initial tow state (position and velocity)
+  float tx  = (float)(m_tow_x - m_float_ox);
+  float ty  = (float)(m_tow_y - m_float_oy);
+  float tvx = (float)m_tow_vx;
+  float tvy = (float)m_tow_vy;
+
+  float min_tow_spd = 1e9f;
+  float min_dist = (float)m_init_min_dist;
+  int contact_step = -1;
+  if(min_dist <= 0)
+    contact_step = 0;
+
+  // Cable nodes on the stack; initialize() bounds num_nodes
+  int num_nodes = m_num_nodes;
+  int start = m_start_node;
+  float nx[TOW_CABLE_MAX_N], ny[TOW_CABLE_MAX_N];
+  float nvx[TOW_CABLE_MAX_N], nvy[TOW_CABLE_MAX_N];
+  if(m_use_cable_dynamics) {
+    for(int i = 0; i < num_nodes; i++) {
+      nx[i]  = (float)(m_init_nx[i] - m_float_ox);
+      ny[i]  = (float)(m_init_ny[i] - m_float_oy);
+      nvx[i] = 0;
+      nvy[i] = 0;
+    }
+  }
+
+  int steps = m_steps;
+  for(int k = 0; k < steps; k++) {
+    if(contact_step >= 0)
+      break;
+    m_sim_steps++;
+
+    int j = (k < plen) ? k : plen - 1;
+    float hc = (float)pc[j];
+    float hs = (float)ps[j];
+
+    osx += vs * hc * dt;
+    osy += vs * hs * dt;
+    float ax = osx - offset * hc;
+    float ay = osy - offset * hs;
+
+    towBodyStep(prm, ax, ay, dyn_dt, tx, ty, tvx, tvy);
+
+    float tow_spd = towHypot(tvx, tvy);
+    if(tow_spd < min_tow_spd)
+      min_tow_spd = tow_spd;
+
+    // Whole cable at check intervals or near the obstacle, else
+    // the tow body only (as evalCandidate())
+    bool full = (k % m_cable_check_interval == 0) || (min_dist < 5.0f);
+    if(m_use_cable_dynamics && m_fcable_step_fn)
+      m_fcable_step_fn(prm, ax, ay, tx, ty, dyn_dt, nx, ny, nvx, nvy);
+    else if(m_use_cable_dynamics)
+      towCableStepN(prm, num_nodes, ax, ay, tx, ty, dyn_dt, nx, ny, nvx, nvy);
+    else if(full)
+      m_fcable_relax_fn(prm.rest_length, ax, ay, tx, ty, nx, ny);
+
+    float d;
+    if(full)
+      d = m_gut.localMinDist(&nx[start], &ny[start], num_nodes - start);
+    else
+      d = m_gut.localDist(tx, ty);
+    if(d < 0) d = 0;
+    min_dist = std::min(min_dist, d);
+
+    if(min_dist <= 0)
+      contact_step = k + 1;
+  }
+
+  return(utilityFromSim(min_dist, contact_step, steps, min_tow_spd));
+}
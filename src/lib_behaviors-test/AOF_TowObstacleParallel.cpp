@@ -0,0 +1,202 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AOF_TowObstacleParallel.cpp                     */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Parallel evaluation for AOF_TowObstacleAvoid. The        */
+/* reflector calls evalBox() one point at a time on the     */
+/* helm thread, so the build is run twice: a dry pass that  */
+/* only notes which domain points the reflector asks for    */
+/* (its sampling does not depend on the utilities), then    */
+/* the real pass served from a table filled in between on   */
+/* a TowWorkPool. Each worker evaluates on its own copy of  */
+/* the prepared AOF, so scratch buffers and counters are    */
+/* never shared; the counters are summed back afterwards.   */
+/* A point's utility does not depend on the worker that     */
+/* evaluated it, so the function built is the same for any  */
+/* thread count. Points the real pass asks for that the dry */
+/* pass did not are evaluated on the spot as usual.         */
+/************************************************************/
+
+#include <chrono>
+#include "AOF_TowObstacleAvoid.h"
+
+using namespace std;
+
+namespace {
+
+//----------------------------------------------------------------
+// Functor: TowPointTask
+//   Purpose: Evaluate task ix on worker w's AOF, timing it for the
+//            eval cache.
+
+class TowPointTask : public TowWorkTask {
+public:
+  TowPointTask(const vector<const AOF_TowObstacleAvoid*>& aofs,
+               const vector<unsigned int>& pts, unsigned int num_spd,
+               vector<double>& utils, vector<double>& ms) :
+    m_aofs(aofs), m_pts(pts), m_num_spd(num_spd), m_utils(utils),
+    m_ms(ms) {}
+
+  void operator()(unsigned int ix, unsigned int worker)
+  {
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    unsigned int c = m_pts[ix];
+    m_utils[ix] = m_aofs[worker]->evalPoint(c / m_num_spd, c % m_num_spd);
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - t0;
+    m_ms[ix] = ms.count();
+  }
+
+private:
+  const vector<const AOF_TowObstacleAvoid*>& m_aofs;
+  const vector<unsigned int>& m_pts;
+  unsigned int     m_num_spd;
+  vector<double>&  m_utils;
+  vector<double>&  m_ms;
+};
+
+}
+
+//----------------------------------------------------------------
+// Procedure: setPointRecording()
+//   Purpose: Start (or stop) noting the points evalBox() is given.
+//            Starting drops any table from an earlier build.
+
+void AOF_TowObstacleAvoid::setPointRecording(bool v)
+{
+  if(v) {
+    unsigned int n = m_domain.getVarPoints(m_crs_ix) *
+      m_domain.getVarPoints(m_spd_ix);
+    m_rec_pts.clear();
+    m_pt_state.assign(n, 0);
+    m_pt_util.clear();
+    m_pt_served = 0;
+  }
+  m_recording = v;
+}
+
+//----------------------------------------------------------------
+// Procedure: evalRecordedPoints()
+//   Purpose: Fill the table with the noted points. Eval cache hits
+//            are taken on this thread, the rest are spread over
+//            the pool and stored back to the cache in order. If the
+//            deadline passes meanwhile the table is left empty and
+//            the real pass runs out as evalBox() would.
+
+void AOF_TowObstacleAvoid::evalRecordedPoints(TowWorkPool& pool)
+{
+  m_recording = false;
+  unsigned int num_spd = m_domain.getVarPoints(m_spd_ix);
+
+  vector<unsigned int> todo;
+  m_pt_util.assign(m_pt_state.size(), 0);
+  for(unsigned int i = 0; i < m_rec_pts.size(); i++) {
+    unsigned int c = m_rec_pts[i];
+    double util = 0;
+    if(m_eval_cache && m_eval_cache->lookup(c / num_spd, c % num_spd, util)) {
+      m_pt_util[c]  = util;
+      m_pt_state[c] = 2;
+    }
+    else
+      todo.push_back(c);
+  }
+
+  // Worker 0 is this thread and evaluates on this AOF
+  vector<AOF_TowObstacleAvoid> copies;
+  vector<const AOF_TowObstacleAvoid*> aofs(1, this);
+  if((pool.size() > 1) && (todo.size() > 1)) {
+    copies.assign(pool.size() - 1, *this);
+    for(unsigned int w = 0; w < copies.size(); w++) {
+      copies[w].clearEvalStats();
+      aofs.push_back(&copies[w]);
+    }
+  }
+  else
+    aofs.resize(pool.size(), this);
+
+  vector<double> utils(todo.size(), 0);
+  vector<double> ms(todo.size(), 0);
+  TowPointTask task(aofs, todo, num_spd, utils, ms);
+  pool.run(todo.size(), task);
+
+  for(unsigned int w = 0; w < copies.size(); w++)
+    mergeWorkerStats(copies[w]);
+
+  if(m_expired) {
+    m_pt_util.clear();
+    return;
+  }
+
+  for(unsigned int i = 0; i < todo.size(); i++) {
+    unsigned int c = todo[i];
+    m_pt_util[c]  = utils[i];
+    m_pt_state[c] = 2;
+    if(m_eval_cache)
+      m_eval_cache->store(c / num_spd, c % num_spd, utils[i], ms[i]);
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: evalPoint()
+//   Purpose: evalBox() of one domain point without the eval cache
+//            or table. Safe to call on different AOF copies from
+//            different threads.
+
+double AOF_TowObstacleAvoid::evalPoint(unsigned int crs_pt,
+                                       unsigned int spd_pt) const
+{
+  double eval_crs = 0;
+  double eval_spd = 0;
+  m_domain.getVal(m_crs_ix, crs_pt, eval_crs);
+  m_domain.getVal(m_spd_ix, spd_pt, eval_spd);
+
+  if(m_has_deadline) {
+    if(m_expired || (chrono::steady_clock::now() > m_deadline)) {
+      m_expired = true;
+      return(getKnownMax());
+    }
+  }
+  return(evalCandidate(eval_crs, eval_spd));
+}
+
+//----------------------------------------------------------------
+// Procedures: clearEvalStats(), mergeWorkerStats()
+//   Purpose: Zero a worker copy's counters, and add them to this
+//            AOF's once it is done.
+
+void AOF_TowObstacleAvoid::clearEvalStats()
+{
+  m_reach_checks      = 0;
+  m_reach_pruned      = 0;
+  m_cascade_screened  = 0;
+  m_cascade_escalated = 0;
+  m_surr_served       = 0;
+  m_surr_fallbacks    = 0;
+  m_trx_served        = 0;
+  m_trx_fallbacks     = 0;
+  m_traj_hits         = 0;
+  m_traj_misses       = 0;
+  m_traj_live         = 0;
+  m_sim_steps         = 0;
+  m_dist_merged       = 0;
+  m_gut.clearQueries();
+}
+
+void AOF_TowObstacleAvoid::mergeWorkerStats(const AOF_TowObstacleAvoid& w)
+{
+  m_reach_checks      += w.m_reach_checks;
+  m_reach_pruned      += w.m_reach_pruned;
+  m_cascade_screened  += w.m_cascade_screened;
+  m_cascade_escalated += w.m_cascade_escalated;
+  m_surr_served       += w.m_surr_served;
+  m_surr_fallbacks    += w.m_surr_fallbacks;
+  m_trx_served        += w.m_trx_served;
+  m_trx_fallbacks     += w.m_trx_fallbacks;
+  m_traj_hits         += w.m_traj_hits;
+  m_traj_misses       += w.m_traj_misses;
+  m_traj_live         += w.m_traj_live;
+  m_sim_steps         += w.m_sim_steps;
+  m_dist_merged       += w.getDistQueries();
+  m_expired = m_expired || w.m_expired;
+}
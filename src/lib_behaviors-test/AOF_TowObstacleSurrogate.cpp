@@ -0,0 +1,129 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AOF_TowObstacleSurrogate.cpp                    */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Surrogate-table evaluation for AOF_TowObstacleAvoid.     */
+/* Replaces the tow and cable integration of simulate()     */
+/* with a trilinear blend of tabulated trajectories (see    */
+/* TowSurrogate.h), rotated from the initial ownship frame  */
+/* and added to ownship's position at each step. Ownship    */
+/* and the attach point follow the heading profile exactly  */
+/* and the obstacle range checks are those of simulate(),   */
+/* so only the tow and cable positions are approximate: by  */
+/* the blend across grid cells and by the initial tow       */
+/* state's distance from the table's. app_aof_bench         */
+/* --mode=surrogate reports the utility error against the   */
+/* live sim.                                                */
+/************************************************************/
+
+#include <algorithm>
+#include "AOF_TowObstacleAvoid.h"
+#include "AngleUtils.h"
+#include "TowSimd.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Procedure: evalSurrogate()
+//   Purpose: Utility of one candidate from the surrogate table.
+//            Returns false, leaving the candidate to the live sim,
+//            if the context or the candidate speed is not covered.
+
+bool AOF_TowObstacleAvoid::evalSurrogate(double eval_crs, double eval_spd,
+                                         const double *pc, const double *ps,
+                                         int plen, double &util) const
+{
+  TowSurrogateCell cell;
+  double osh = m_obship_model.getOSH();
+  double crs_off = angle360(eval_crs - osh);
+  if(!m_surr_ok || !m_surrogate->cell(crs_off, eval_spd, m_surr_v0, cell)) {
+    m_surr_fallbacks++;
+    return(false);
+  }
+  m_surr_served++;
+
+  const double dt = m_sim_dt;
+  const double vs = eval_spd;
+  const double fc = m_surr_fc;
+  const double fs = m_surr_fs;
+  const size_t rf = m_surrogate->recFloats();
+
+  double osx = m_obship_model.getOSX();
+  double osy = m_obship_model.getOSY();
+
+  double min_tow_spd = 1e9;
+  double min_dist = m_init_min_dist;
+  int contact_step = -1;
+  if(min_dist <= 0)
+    contact_step = 0;
+
+  int num_nodes = m_num_nodes;
+  int start = m_start_node;
+  int steps = m_steps;
+  for(int k = 0; k < steps; k++) {
+    if(contact_step >= 0)
+      break;
+
+    int j = (k < plen) ? k : plen - 1;
+    double hc = pc[j];
+    double hs = ps[j];
+    osx += vs * hc * dt;
+    osy += vs * hs * dt;
+    double ax = osx - m_attach_offset * hc;
+    double ay = osy - m_attach_offset * hs;
+
+    // Blended tow position and velocity at this step
+    size_t off = (size_t)k * rf;
+    double fx = 0, fy = 0, fvx = 0, fvy = 0;
+    for(unsigned int c = 0; c < cell.n; c++) {
+      const float *r = cell.rec[c] + off;
+      fx  += cell.w[c] * r[0];
+      fy  += cell.w[c] * r[1];
+      fvx += cell.w[c] * r[2];
+      fvy += cell.w[c] * r[3];
+    }
+    double tx = osx + fx * fc - fy * fs;
+    double ty = osy + fx * fs + fy * fc;
+    double tvx = vs * hc + fvx * fc - fvy * fs;
+    double tvy = vs * hs + fvx * fs + fvy * fc;
+    double tow_spd = towHypot(tvx, tvy);
+    if(tow_spd < min_tow_spd)
+      min_tow_spd = tow_spd;
+
+    // Whole cable at check intervals or near the obstacle, else
+    // the tow body only (as simulate())
+    bool full = (k % m_cable_check_interval == 0) || (min_dist < 5.0);
+    double d;
+    if(!full)
+      d = m_gut.dist(tx, ty);
+    else if(m_use_cable_dynamics) {
+      m_nx[0] = ax;
+      m_ny[0] = ay;
+      for(int i = 1; i < num_nodes - 1; i++) {
+        double nx = 0, ny = 0;
+        for(unsigned int c = 0; c < cell.n; c++) {
+          const float *r = cell.rec[c] + off;
+          nx += cell.w[c] * r[2*i + 2];
+          ny += cell.w[c] * r[2*i + 3];
+        }
+        m_nx[i] = osx + nx * fc - ny * fs;
+        m_ny[i] = osy + nx * fs + ny * fc;
+      }
+      m_nx[num_nodes-1] = tx;
+      m_ny[num_nodes-1] = ty;
+      d = m_gut.minDist(&m_nx[start], &m_ny[start], num_nodes - start);
+    }
+    else
+      d = cableRelaxedMinDist(ax, ay, tx, ty);
+    if(d < 0) d = 0;
+    min_dist = std::min(min_dist, d);
+
+    if(min_dist <= 0)
+      contact_step = k + 1;
+  }
+
+  util = utilityFromSim(min_dist, contact_step, steps, min_tow_spd);
+  return(true);
+}
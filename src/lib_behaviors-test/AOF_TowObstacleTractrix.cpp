@@ -0,0 +1,335 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AOF_TowObstacleTractrix.cpp                     */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Tractrix evaluation for AOF_TowObstacleAvoid. Replaces   */
+/* the stepped tow and cable integration of simulate() with */
+/* the closed-form tractrix of TowTractrix.h: the cable is  */
+/* straight and taut and the tow follows the attach point.  */
+/*                                                          */
+/* A candidate's heading profile splits the horizon into at */
+/* most three runs of identical steps (the turn at the full */
+/* rate, the step that settles on the course, the course    */
+/* held), each advanced in O(1). The range check samples    */
+/* only the steps that can matter: every point of the cable */
+/* moves at most one anchor step per sim step, so after a   */
+/* check at range d the next (d - floor)/step steps cannot  */
+/* bring it under floor = min(CPA so far, max_util_cpa).    */
+/* Checks land on simulate()'s cadence (whole cable or tow  */
+/* body). The tow speed for the speed penalty follows the   */
+/* Euler sim's own balance of spring impulse and drag along */
+/* the cable, in closed form per run.                       */
+/*                                                          */
+/* Falls back to the numerical sim (returns false) when the */
+/* cable would go slack, the anchor closing on the tow,     */
+/* when the tow's damping is too weak for it to follow the  */
+/* cable, and when the CPA or the tow speed lands within a  */
+/* margin of min_util_cpa or the speed penalty, where small */
+/* model errors are large utility errors. app_aof_bench     */
+/* --mode=tractrix reports the utility error against the    */
+/* Euler sim.                                               */
+/************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include "AOF_TowObstacleAvoid.h"
+#include "TowTractrix.h"
+
+using namespace std;
+
+namespace {
+
+// Damping across the cable (c_tan plus drag) must exceed this many
+// times the rate the cable turns at speed, v/L, for the tow to
+// follow the tractrix rather than swing on its own inertia
+const double TRX_MIN_DAMPING = 4.0;
+
+// A run of steps whose heading turns by dh (rad, ccw) per step
+struct TractrixRun {
+  int    k0;        // first step
+  int    n;         // step count
+  double cgx, cgy;  // ownship before the first step
+  double hx, hy;    // heading of the first step
+  double dh;
+  double ux, uy;    // anchor track of the first step (unit)
+  double s;         // anchor track length per step
+};
+
+//----------------------------------------------------------------
+// runHeadingSum(): sum of the first m headings of a run, in
+// closed form (a geometric series of rotations).
+
+void runHeadingSum(const TractrixRun& r, int m, double& gx, double& gy)
+{
+  double sh = sin(0.5 * r.dh);
+  if(fabs(sh) < 1e-12) {
+    gx = m * r.hx;
+    gy = m * r.hy;
+    return;
+  }
+  double k  = sin(0.5 * m * r.dh) / sh;
+  double ca = cos(0.5 * (m - 1) * r.dh);
+  double sa = sin(0.5 * (m - 1) * r.dh);
+  gx = k * (r.hx * ca - r.hy * sa);
+  gy = k * (r.hx * sa + r.hy * ca);
+}
+
+//----------------------------------------------------------------
+// towBodySpeed(): the tow body's velocity along the cable after t
+// seconds, from w. The clamp holds the tow on the tractrix without
+// changing its velocity, which the spring impulse of each step,
+// a = k*(anchor move along the cable) per second, and drag settle:
+// w' = a - cd*w^2. The speed the sim reports is w less a*dt.
+
+double towBodySpeed(double w, double a, double cd, double t)
+{
+  if(!(a > 0) || !(cd > 0))
+    return(w + std::max(a, 0.0) * t);
+
+  double w_eq = sqrt(a / cd);
+  double x = sqrt(a * cd) * t;
+  if(w < w_eq)
+    return(w_eq * tanh(x + atanh(std::max(w, 0.0) / w_eq)));
+  if(w > w_eq)
+    return(w_eq / tanh(x + atanh(w_eq / w)));
+  return(w_eq);
+}
+
+//----------------------------------------------------------------
+// runPose(): anchor, cable direction (tow to anchor) and tow after
+// step j of a run, for u = tan(theta/2) off the step's track.
+
+void runPose(const TractrixRun& r, int j, double u, double vs_dt,
+             double offset, double L, double& ax, double& ay,
+             double& ex, double& ey, double& tx, double& ty)
+{
+  double cj = 1, sj = 0;
+  if(r.dh != 0) {
+    cj = cos(j * r.dh);
+    sj = sin(j * r.dh);
+  }
+  double hx = r.hx * cj - r.hy * sj;
+  double hy = r.hx * sj + r.hy * cj;
+  double kx = r.ux * cj - r.uy * sj;
+  double ky = r.ux * sj + r.uy * cj;
+
+  double gx, gy;
+  runHeadingSum(r, j + 1, gx, gy);
+  ax = r.cgx + vs_dt * gx - offset * hx;
+  ay = r.cgy + vs_dt * gy - offset * hy;
+
+  double uu = u * u;
+  double ct = (1 - uu) / (1 + uu);
+  double st = 2 * u / (1 + uu);
+  ex = kx * ct - ky * st;
+  ey = kx * st + ky * ct;
+  tx = ax - L * ex;
+  ty = ay - L * ey;
+}
+
+}
+
+//----------------------------------------------------------------
+// Procedure: evalTractrix()
+//   Purpose: Utility of one candidate under the tractrix model.
+//            Returns false, leaving the candidate to the numerical
+//            sim, if the model does not hold for it.
+
+bool AOF_TowObstacleAvoid::evalTractrix(double eval_spd, const double *pc,
+                                        const double *ps, int plen,
+                                        double &util) const
+{
+  const double dt  = m_sim_dt;
+  const double vs  = eval_spd;
+  const double L   = m_cable_length;
+  const double off = m_attach_offset;
+  const int steps  = m_steps;
+
+  double damp = m_c_tan + m_cd * vs;
+  if(!(vs > 0) || (damp * L < TRX_MIN_DAMPING * vs)) {
+    m_trx_fallbacks++;
+    return(false);
+  }
+
+  // Runs: profile entries 0..plen-2 turn at the full rate, entry
+  // plen-1 settles on the course, and the course holds after it
+  double hdg_rad0 = (90.0 - m_obship_model.getOSH()) * M_PI / 180.0;
+  double hpx = cos(hdg_rad0);
+  double hpy = sin(hdg_rad0);
+  double cgx = m_obship_model.getOSX();
+  double cgy = m_obship_model.getOSY();
+
+  TractrixRun runs[3];
+  int nruns = 0;
+  int run_k0[3] = {0, plen - 1, plen};
+  int run_n[3]  = {plen - 1, 1, steps - plen};
+  double s_max = 0;
+  for(int i = 0; i < 3; i++) {
+    int n = std::min(run_n[i], steps - run_k0[i]);
+    if(n <= 0)
+      continue;
+    int jh = std::min(run_k0[i], plen - 1);
+    TractrixRun& r = runs[nruns++];
+    r.k0  = run_k0[i];
+    r.n   = n;
+    r.cgx = cgx;
+    r.cgy = cgy;
+    r.hx  = pc[jh];
+    r.hy  = ps[jh];
+    r.dh  = 0;
+    if(n > 1)
+      r.dh = atan2(hpx * r.hy - hpy * r.hx, hpx * r.hx + hpy * r.hy);
+
+    // Anchor move of the first step: ownship's, less the swing of
+    // the attach offset. Later steps are this move rotated by dh.
+    double mx = vs * dt * r.hx - off * (r.hx - hpx);
+    double my = vs * dt * r.hy - off * (r.hy - hpy);
+    r.s = towHypot(mx, my);
+    if(!(r.s > 1e-9)) {
+      m_trx_fallbacks++;
+      return(false);
+    }
+    r.ux = mx / r.s;
+    r.uy = my / r.s;
+    s_max = std::max(s_max, r.s);
+
+    // Ownship and heading at the end of the run
+    double gx, gy;
+    runHeadingSum(r, n, gx, gy);
+    cgx += vs * dt * gx;
+    cgy += vs * dt * gy;
+    double cn = cos((n - 1) * r.dh);
+    double sn = sin((n - 1) * r.dh);
+    hpx = r.hx * cn - r.hy * sn;
+    hpy = r.hx * sn + r.hy * cn;
+  }
+
+  double min_tow_spd = 1e9;
+  double min_dist = m_init_min_dist;
+  int contact_step = -1;
+  if(min_dist <= 0)
+    contact_step = 0;
+
+  double maxu = std::max(m_obship_model.getMaxUtilCPA(), 0.0);
+  int num_nodes = m_num_nodes;
+  int start = m_start_node;
+  double ex = m_trx_ex;
+  double ey = m_trx_ey;
+  double w = 0;
+  int next_k = 0;
+
+  for(int i = 0; (i < nruns) && (contact_step < 0); i++) {
+    const TractrixRun& r = runs[i];
+
+    // Cable angle off the run's first track. The anchor has to
+    // pull the tow (|theta| < 90 deg) or the cable goes slack.
+    double c = ex * r.ux + ey * r.uy;
+    double sn = r.ux * ey - r.uy * ex;
+    if(c <= 0) {
+      m_trx_fallbacks++;
+      return(false);
+    }
+    double u0 = sn / (1 + c) * exp(-r.s / L);
+
+    // theta moves monotonically over the run, so it stays under
+    // 90 deg if both ends do and it did not wrap through 180
+    TowMobius m = towTractrixStep(r.s, L, r.dh);
+    double u_end = u0;
+    if(r.n > 1) {
+      u_end = towMobiusApply(towMobiusPow(m, r.n - 1), u0);
+      double u1 = towMobiusApply(m, u0);
+      bool wrapped = ((u_end - u0) * (u1 - u0) < -1e-12);
+      double x = towMobiusHalfTrace(m);
+      if((x < 1) && ((r.n - 1) * acos(x) >= M_PI))
+        wrapped = true;
+      if(wrapped) {
+        m_trx_fallbacks++;
+        return(false);
+      }
+    }
+    if((fabs(u0) >= 1) || (fabs(u_end) >= 1)) {
+      m_trx_fallbacks++;
+      return(false);
+    }
+
+    // Tow body speed along the cable over the run, least at an end
+    double c0 = (1 - u0 * u0) / (1 + u0 * u0);
+    double c1 = (1 - u_end * u_end) / (1 + u_end * u_end);
+    double c_min = std::min(c0, c1);
+    double a = m_k_spring * r.s * 0.5 * (c0 + c1);
+    if(i == 0)
+      w = std::max(m_trx_v0, 0.0) + a * dt;
+
+    // A tow faster than the anchor along the cable overruns it
+    if(w - a * dt > r.s / dt * c_min) {
+      m_trx_fallbacks++;
+      return(false);
+    }
+    double w_end = towBodySpeed(w, a, m_cd, r.n * dt);
+    min_tow_spd = std::min(min_tow_spd, std::min(w, w_end) - a * dt);
+    w = w_end;
+
+    double ax, ay, tx, ty;
+    while((next_k < r.k0 + r.n) && (contact_step < 0)) {
+      int j = next_k - r.k0;
+      double u = u0;
+      if(j == r.n - 1)
+        u = u_end;
+      else if(j > 0)
+        u = towMobiusApply(towMobiusPow(m, j), u0);
+      runPose(r, j, u, vs * dt, off, L, ax, ay, ex, ey, tx, ty);
+
+      // Nodes of the straight cable, from the start node
+      for(int nd = start; nd < num_nodes; nd++) {
+        double t = (double)nd / (double)(num_nodes - 1);
+        m_nx[nd] = ax + t * (tx - ax);
+        m_ny[nd] = ay + t * (ty - ay);
+      }
+      double d = m_gut.minDist(&m_nx[start], &m_ny[start],
+                               num_nodes - start);
+      if(d < 0) d = 0;
+
+      // Range as simulate() checks it: the whole cable at check
+      // intervals or near the obstacle, else the tow body only
+      bool full = (next_k % m_cable_check_interval == 0) || (min_dist < 5.0);
+      double d_chk = d;
+      if(!full) {
+        d_chk = m_gut.dist(tx, ty);
+        if(d_chk < 0) d_chk = 0;
+      }
+      min_dist = std::min(min_dist, d_chk);
+      if(min_dist <= 0) {
+        contact_step = next_k + 1;
+        break;
+      }
+
+      // Skip on the whole cable's range, which bounds every check
+      double floor_d = std::min(min_dist, maxu);
+      double skip = std::max(floor((d - floor_d) / s_max), 0.0);
+      next_k += 1 + (int)std::min(skip, (double)steps);
+    }
+
+    // Cable direction entering the next run
+    runPose(r, r.n - 1, u_end, vs * dt, off, L, ax, ay, ex, ey, tx, ty);
+  }
+
+  // Near a utility breakpoint the model's small CPA and tow speed
+  // errors become large utility errors: leave those to the sim
+  double minu = m_obship_model.getMinUtilCPA();
+  if(fabs(min_dist - minu) < m_trx_cpa_margin) {
+    m_trx_fallbacks++;
+    return(false);
+  }
+  double spd_break = std::max(m_tow_spd_min, m_tow_spd_hard_min);
+  if(m_penalize_low_tow_spd && (spd_break > 0) &&
+     (min_tow_spd < spd_break + m_trx_spd_margin)) {
+    m_trx_fallbacks++;
+    return(false);
+  }
+
+  m_trx_served++;
+  util = utilityFromSim(min_dist, contact_step, steps, min_tow_spd);
+  return(true);
+}
@@ -0,0 +1,283 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: AOF_TowObstacleTrajCache.cpp                    */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Shared trajectory evaluation for AOF_TowObstacleAvoid.   */
+/* The fixed-step sim of simulate() is split in two: the    */
+/* dynamics, recorded once per candidate into the shared    */
+/* TowTrajectorySet over the whole horizon, and the range   */
+/* checks, replayed per obstacle on simulate()'s cadence.   */
+/* The cable is kept only at check steps; a replay that     */
+/* comes within 5 m of the obstacle between them, where     */
+/* simulate() checks every step, falls back to a live sim.  */
+/* Candidates the set has no room for are recorded into     */
+/* scratch and replayed the same way, so each utility is    */
+/* the same whichever AOF or worker thread recorded it.     */
+/* Every AOF reads the same float record, so instances for  */
+/* different obstacles agree with one another; against the  */
+/* double sim they differ only by float rounding of the     */
+/* positions (app_aof_bench --mode=trajcache reports it).   */
+/************************************************************/
+
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include "AOF_TowObstacleAvoid.h"
+#include "TowSimd.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Procedure: prepareTrajCache()
+//   Purpose: Attach the shared set for this context. The key holds
+//            the helm time and everything the dynamics depend on;
+//            the obstacle is not among them.
+
+void AOF_TowObstacleAvoid::prepareTrajCache()
+{
+  m_traj_ok = false;
+  m_traj_set.reset();
+  m_traj_hits   = 0;
+  m_traj_misses = 0;
+  m_traj_live   = 0;
+  if(!m_traj_cache || !(m_cable_length > 0) || (m_steps <= 0) ||
+     (m_prof_stride <= 0) || m_adapt_ok || m_float_ok || m_cascade_ok ||
+     m_swept_check)
+    return;
+
+  m_traj_pts = 1;
+  if(m_use_cable_dynamics)
+    m_traj_pts = m_num_nodes - m_start_node;
+  m_traj_ox = m_obship_model.getOSX();
+  m_traj_oy = m_obship_model.getOSY();
+
+  unsigned int num_crs = m_domain.getVarPoints(m_crs_ix);
+  unsigned int num_spd = m_domain.getVarPoints(m_spd_ix);
+
+  ostringstream key;
+  key.precision(17);
+  key << m_traj_stamp << "," << m_traj_ox << "," << m_traj_oy << ","
+      << m_obship_model.getOSH() << "," << m_tow_x << "," << m_tow_y
+      << "," << m_tow_vx << "," << m_tow_vy << "," << m_cable_length
+      << "," << m_attach_offset << "," << m_k_spring << "," << m_cd
+      << "," << m_c_tan << "," << m_sim_dt << "," << m_steps << ","
+      << m_turn_rate_max << "," << (int)m_integrator << ","
+      << m_cable_check_interval << ","
+      << (m_cable_step_fn != 0) << "," << m_use_cable_dynamics << ","
+      << m_num_nodes << "," << m_start_node << ","
+      << m_domain.getVarLow(m_crs_ix) << "/"
+      << m_domain.getVarDelta(m_crs_ix) << "/" << num_crs << ","
+      << m_domain.getVarLow(m_spd_ix) << "/"
+      << m_domain.getVarDelta(m_spd_ix) << "/" << num_spd;
+
+  size_t max_bytes = (size_t)(m_traj_max_mb * 1024 * 1024);
+  m_traj_set = TowTrajectoryCache::get(key.str(), m_traj_stamp,
+                                       num_crs * num_spd, m_steps,
+                                       m_cable_check_interval, m_traj_pts,
+                                       max_bytes);
+  m_traj_ok = (m_traj_set != 0);
+  if(m_traj_ok)
+    m_traj_scratch.assign(m_traj_set->blockFloats(), 0);
+}
+
+//----------------------------------------------------------------
+// Procedure: trajSlot()
+//   Purpose: Candidate index of a (course, speed) on the domain
+//            grid, false if it is off the grid.
+
+bool AOF_TowObstacleAvoid::trajSlot(double eval_crs, double eval_spd,
+                                    unsigned int &c) const
+{
+  int ix[2] = {m_crs_ix, m_spd_ix};
+  double val[2] = {eval_crs, eval_spd};
+  int pt[2];
+  for(int i = 0; i < 2; i++) {
+    double lo    = m_domain.getVarLow(ix[i]);
+    double delta = m_domain.getVarDelta(ix[i]);
+    int num = (int)m_domain.getVarPoints(ix[i]);
+    pt[i] = 0;
+    if(delta > 0)
+      pt[i] = (int)floor((val[i] - lo) / delta + 0.5);
+    if((pt[i] < 0) || (pt[i] >= num))
+      return(false);
+    if(fabs(lo + pt[i] * delta - val[i]) > 1e-6 * (1 + delta))
+      return(false);
+  }
+  c = (unsigned int)pt[0] * m_domain.getVarPoints(m_spd_ix) + pt[1];
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalTrajCache()
+//   Purpose: Utility of one candidate from its shared trajectory,
+//            recording it first if no AOF has yet (into scratch if
+//            the set has no room). Candidates off the domain grid,
+//            or whose replay needs the cable between check steps,
+//            are simulated live.
+
+double AOF_TowObstacleAvoid::evalTrajCache(double eval_crs, double eval_spd,
+                                           const double *pc, const double *ps,
+                                           int plen) const
+{
+  TowTrajView v;
+  unsigned int c = 0;
+  bool scratch = false;
+  bool on_grid = trajSlot(eval_crs, eval_spd, c);
+  if(on_grid && m_traj_set->find(c, v)) {
+    m_traj_hits++;
+    TowTrajectoryCache::countHit();
+  }
+  else if(on_grid && m_traj_set->reserve(c, v)) {
+    recordTrajSoA(eval_spd, pc, ps, plen, v);
+    m_traj_set->commit(c);
+    m_traj_misses++;
+    TowTrajectoryCache::countMiss();
+  }
+  else if(on_grid) {
+    v = m_traj_set->viewOf(&m_traj_scratch[0]);
+    recordTrajSoA(eval_spd, pc, ps, plen, v);
+    scratch = true;
+  }
+
+  double util = 0;
+  if(on_grid && replayTrajectory(v, util)) {
+    if(scratch)
+      m_traj_live++;
+    return(util);
+  }
+
+  m_traj_live++;
+  double min_dist = 0, min_tow_spd = 0;
+  int contact_step = -1;
+  simulate(eval_crs, eval_spd, pc, ps, plen, m_use_cable_dynamics,
+           m_init_min_dist, min_dist, contact_step, min_tow_spd);
+  return(utilityFromSim(min_dist, contact_step, m_steps, min_tow_spd));
+}
+
+//----------------------------------------------------------------
+// Procedure: recordTrajSoA()
+//   Purpose: The dynamics of simulate() over the whole horizon,
+//            storing the tow of each step and the checked points
+//            of each check step. Nothing here depends on the
+//            obstacle, so the sim does not stop on contact.
+
+void AOF_TowObstacleAvoid::recordTrajSoA(double eval_spd, const double *pc,
+                                         const double *ps, int plen,
+                                         const TowTrajView& v) const
+{
+  double dt = m_sim_dt;
+  int num_nodes = m_num_nodes;
+  int start = m_start_node;
+  int interval = m_cable_check_interval;
+  unsigned int pts = m_traj_pts;
+
+  double osx = m_obship_model.getOSX();
+  double osy = m_obship_model.getOSY();
+  double tx  = m_tow_x;
+  double ty  = m_tow_y;
+  double tvx = m_tow_vx;
+  double tvy = m_tow_vy;
+
+  if(m_use_cable_dynamics) {
+    for(int i = 0; i < num_nodes; i++) {
+      m_nx[i]  = m_init_nx[i];
+      m_ny[i]  = m_init_ny[i];
+      m_nvx[i] = 0;
+      m_nvy[i] = 0;
+    }
+  }
+
+  double vs = eval_spd;
+  for(int k = 0; k < m_steps; k++) {
+    m_sim_steps++;
+
+    int j = (k < plen) ? k : plen - 1;
+    double hc = pc[j];
+    double hs = ps[j];
+    osx += vs * hc * dt;
+    osy += vs * hs * dt;
+    double ax = osx - m_attach_offset * hc;
+    double ay = osy - m_attach_offset * hs;
+
+    propagateTowOneStep(ax, ay, dt, tx, ty, tvx, tvy);
+    v.spd[k] = (float)towHypot(tvx, tvy);
+    v.tx[k]  = (float)(tx - m_traj_ox);
+    v.ty[k]  = (float)(ty - m_traj_oy);
+
+    if(m_use_cable_dynamics)
+      propagateCableOneStep(ax, ay, tx, ty, dt, num_nodes, m_rest_length,
+                            m_nx, m_ny, m_nvx, m_nvy);
+    if(k % interval != 0)
+      continue;
+
+    float *kx = v.cx + (size_t)(k / interval) * pts;
+    float *ky = v.cy + (size_t)(k / interval) * pts;
+    if(m_use_cable_dynamics) {
+      for(unsigned int i = 0; i < pts; i++) {
+        kx[i] = (float)(m_nx[start + i] - m_traj_ox);
+        ky[i] = (float)(m_ny[start + i] - m_traj_oy);
+      }
+    }
+    else {
+      kx[0] = (float)(ax - m_traj_ox);
+      ky[0] = (float)(ay - m_traj_oy);
+    }
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: replayTrajectory()
+//   Purpose: simulate()'s range checks and bookkeeping over a
+//            recorded trajectory: the whole cable at check
+//            intervals, else the tow body. False if simulate()
+//            would check the cable at a step not recorded (within
+//            5 m between checks).
+
+bool AOF_TowObstacleAvoid::replayTrajectory(const TowTrajView& v,
+                                            double &util) const
+{
+  int interval = m_cable_check_interval;
+  unsigned int pts = m_traj_pts;
+  double min_tow_spd = 1e9;
+  double min_dist = m_init_min_dist;
+  int contact_step = -1;
+  if(min_dist <= 0)
+    contact_step = 0;
+
+  for(int k = 0; (k < m_steps) && (contact_step < 0); k++) {
+    min_tow_spd = std::min(min_tow_spd, (double)v.spd[k]);
+
+    double tx = v.tx[k] + m_traj_ox;
+    double ty = v.ty[k] + m_traj_oy;
+
+    double d = 0;
+    if(k % interval == 0) {
+      const float *kx = v.cx + (size_t)(k / interval) * pts;
+      const float *ky = v.cy + (size_t)(k / interval) * pts;
+      if(m_use_cable_dynamics) {
+        for(unsigned int i = 0; i < pts; i++) {
+          m_nx[i] = kx[i] + m_traj_ox;
+          m_ny[i] = ky[i] + m_traj_oy;
+        }
+        d = m_gut.minDist(&m_nx[0], &m_ny[0], pts);
+      }
+      else
+        d = cableRelaxedMinDist(kx[0] + m_traj_ox, ky[0] + m_traj_oy,
+                                tx, ty);
+    }
+    else if(min_dist < 5.0)
+      return(false);
+    else
+      d = m_gut.dist(tx, ty);
+    if(d < 0) d = 0;
+
+    min_dist = std::min(min_dist, d);
+    if(min_dist <= 0)
+      contact_step = k + 1;
+  }
+
+  util = utilityFromSim(min_dist, contact_step, m_steps, min_tow_spd);
+  return(true);
+}
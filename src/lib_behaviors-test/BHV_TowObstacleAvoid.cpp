@@ -38,8 +38,10 @@
 #include <cmath> 
 #include <cstdlib>
 #include <algorithm>
+#include <sstream>
 #include "BHV_TowObstacleAvoid.h"
 #include "AOF_TowObstacleAvoid.h"
+#include "TowDynamics.h"
 #include "OF_Reflector.h"
 #include "MBUtils.h"
 #include "AngleUtils.h"
@@ -91,6 +93,29 @@ BHV_TowObstacleAvoid::BHV_TowObstacleAvoid(IvPDomain gdomain) :
   m_tow_pad           = 0.0;
   m_abaft_beam_thresh = -1;
   m_post_view_points  = true;
+  m_sdf_cell_size     = 0;
+  m_sdf_max_range     = 50;
+  m_eval_cache_on     = false;
+  m_surrogate_pos_tol = 1.0;
+  m_surrogate_vel_tol = 0.2;
+  m_tractrix          = false;
+  m_tractrix_pos_tol  = 0.5;
+  m_tractrix_vel_tol  = 0.3;
+  m_tractrix_min_v0   = 1.0;
+  m_tractrix_cpa_margin = 1.0;
+  m_tractrix_spd_margin = 0.25;
+  m_interval_bounds   = false;
+  m_interval_min_crs  = 9;
+  m_interval_min_spd  = 3;
+  m_traj_cache        = false;
+  m_traj_cache_mb     = 32;
+  m_eval_threads      = 1;
+  m_build_memo        = true;
+  m_anytime_deadline  = 0;
+  m_fidelity          = TOW_FID_FULL;
+  m_build_ms          = 0;
+  for(int i = 0; i < 3; i++)
+    m_level_ms[i] = 0;
   m_towed_x      = 0;
   m_towed_y      = 0;
 
@@ -133,9 +158,14 @@ BHV_TowObstacleAvoid::BHV_TowObstacleAvoid(IvPDomain gdomain) :
   m_sim_horizon    = -1;
   m_turn_rate_max  = 0.0; //change to 0.
 
-  m_cable_sample_step = 1.0;
   m_cable_check_interval = 5;
   m_cable_start_node = 0;
+  m_swept_check = false;
+  m_adaptive_max_dt = 0;
+  m_integrator = TOW_INT_EULER;
+  m_aof_float = false;
+  m_cascade = false;
+  m_cascade_band = 1.0;
 
   initVisualHints();
   addInfoVars("NAV_X, NAV_Y, NAV_HEADING");
@@ -143,6 +173,7 @@ BHV_TowObstacleAvoid::BHV_TowObstacleAvoid(IvPDomain gdomain) :
   addInfoVars("TOWED_VX, TOWED_VY", "no_warning");
   addInfoVars("TOW_CABLE_LENGTH, TOW_ATTACH_OFFSET", "no_warning");
   addInfoVars("TOW_SPRING_STIFFNESS, TOW_DRAG_COEFF, TOW_TAN_DAMPING", "no_warning");
+  addInfoVars("TOW_INTEGRATOR", "no_warning");
   addInfoVars("TOW_DEPLOYED", "no_warning");
   addInfoVars(m_resolved_obstacle_var);
 }
@@ -239,8 +270,10 @@ bool BHV_TowObstacleAvoid::setParam(string param, string val)
     return(true);
   }
 
+  // Cable ranges are exact segment distances now; the old sample
+  // step is still accepted so existing missions load, with a warning
   else if((param == "cable_sample_step") && isNumber(val) && dval > 0) {
-    m_cable_sample_step = dval;
+    postWMessage("cable_sample_step is ignored: cable ranges are exact");
     return(true);
   }
 
@@ -270,9 +303,198 @@ bool BHV_TowObstacleAvoid::setParam(string param, string val)
     return(true);
   }
 
+  // With swept_check on, sim_dt can be coarsened (0.5-1.0 s) without
+  // the cable tunneling through thin obstacles between steps
+  else if((param == "sim_dt") && isNumber(val) && dval > 0) {
+    m_sim_dt = dval;
+    return(true);
+  }
+  else if(param == "swept_check")
+    return(setBooleanOnString(m_swept_check, val));
+
+  // Tow and cable integrator: euler, semi_implicit, rk2 or rk4.
+  // Overridden by TOW_INTEGRATOR when pTowing publishes it.
+  else if(param == "integrator")
+    return(towIntegratorFromString(tolower(val), m_integrator));
+
+  // Largest adaptive sim step in seconds, 0 keeps fixed sim_dt steps
+  else if((param == "adaptive_max_dt") && non_neg_number) {
+    m_adaptive_max_dt = dval;
+    return(true);
+  }
+
+  // AOF forward sim precision: double (default) or float. Float
+  // covers fixed-step Euler sims of convex obstacles; others run
+  // in double.
+  else if(param == "aof_precision") {
+    string prec = tolower(val);
+    if((prec != "double") && (prec != "float"))
+      return(false);
+    m_aof_float = (prec == "float");
+    return(true);
+  }
+
+  // Screen candidates with the relaxed cable; re-run full cable
+  // dynamics only near a utility breakpoint, within the relaxed vs
+  // full cable gap measured each iteration plus cascade_band (m)
+  else if(param == "cascade")
+    return(setBooleanOnString(m_cascade, val));
+  else if((param == "cascade_band") && non_neg_number) {
+    m_cascade_band = dval;
+    return(true);
+  }
+
   else if(param == "post_view_points")
     return(setBooleanOnString(m_post_view_points, val));
 
+  // Distance raster: worst-case lookup error is sdf_cell_size/sqrt(2)
+  else if((param == "sdf_cell_size") && non_neg_number) {
+    m_sdf_cell_size = dval;
+    return(true);
+  }
+  else if((param == "sdf_max_range") && non_neg_number) {
+    m_sdf_max_range = dval;
+    return(true);
+  }
+
+  // Reuse utilities across iterations while ownship and tow state
+  // stay within the tolerances (meters, degrees, m/s)
+  else if(param == "eval_cache")
+    return(setBooleanOnString(m_eval_cache_on, val));
+  else if((param == "eval_cache_pos_tol") && non_neg_number) {
+    m_eval_cache.setTolerances(dval, -1, -1);
+    return(true);
+  }
+  else if((param == "eval_cache_hdg_tol") && non_neg_number) {
+    m_eval_cache.setTolerances(-1, dval, -1);
+    return(true);
+  }
+  else if((param == "eval_cache_vel_tol") && non_neg_number) {
+    m_eval_cache.setTolerances(-1, -1, dval);
+    return(true);
+  }
+
+  // Tow response table from app_tow_surrogate, memory-mapped and
+  // used where it covers the config and initial tow state
+  else if(param == "surrogate_table") {
+    string err;
+    m_surrogate = TowSurrogate::open(val, err);
+    if(!m_surrogate) {
+      postWMessage("surrogate_table: " + err);
+      return(false);
+    }
+    m_surrogate_file = val;
+    return(true);
+  }
+  else if((param == "surrogate_pos_tol") && non_neg_number) {
+    m_surrogate_pos_tol = dval;
+    return(true);
+  }
+  else if((param == "surrogate_vel_tol") && non_neg_number) {
+    m_surrogate_vel_tol = dval;
+    return(true);
+  }
+
+  // Propagate the tow as a tractrix while the cable stays taut;
+  // the tolerances bound how far from taut and from moving along
+  // the cable the tow may start, min_v0 how slow. Candidates near
+  // min_util_cpa or the tow speed penalty (the margins) are simulated.
+  else if(param == "tractrix")
+    return(setBooleanOnString(m_tractrix, val));
+  else if((param == "tractrix_pos_tol") && non_neg_number) {
+    m_tractrix_pos_tol = dval;
+    return(true);
+  }
+  else if((param == "tractrix_vel_tol") && non_neg_number) {
+    m_tractrix_vel_tol = dval;
+    return(true);
+  }
+  else if((param == "tractrix_min_v0") && non_neg_number) {
+    m_tractrix_min_v0 = dval;
+    return(true);
+  }
+  else if((param == "tractrix_cpa_margin") && non_neg_number) {
+    m_tractrix_cpa_margin = dval;
+    return(true);
+  }
+  else if((param == "tractrix_spd_margin") && non_neg_number) {
+    m_tractrix_spd_margin = dval;
+    return(true);
+  }
+
+  // Share forward-sim trajectories with the other spawned
+  // instances in each helm iteration, holding up to traj_cache_mb
+  // of them in all (see TowTrajectoryCache.h)
+  else if(param == "traj_cache")
+    return(setBooleanOnString(m_traj_cache, val));
+  else if((param == "traj_cache_mb") && isNumber(val) && (dval > 0)) {
+    m_traj_cache_mb = dval;
+    return(true);
+  }
+
+  // Evaluate each domain point at most once per build, however
+  // often the reflector's grid, pieces and regions overlap on it
+  else if(param == "build_memo")
+    return(setBooleanOnString(m_build_memo, val));
+
+  // Size the reflector's pieces to hold the build near
+  // build_target_ms, within build_piece_course and
+  // build_piece_speed ("min,max" domain points; see TowResolution.h)
+  else if((param == "build_target_ms") && non_neg_number) {
+    m_resolution.setTarget(dval);
+    return(true);
+  }
+  else if((param == "build_piece_course") || (param == "build_piece_speed")) {
+    string lo = biteStringX(val, ',');
+    if(!isNumber(lo) || !isNumber(val))
+      return(false);
+    int ilo = atoi(lo.c_str());
+    int ihi = atoi(val.c_str());
+    if((ilo < 1) || (ihi < ilo))
+      return(false);
+    if(param == "build_piece_course")
+      m_resolution.setCourseBounds(ilo, ihi);
+    else
+      m_resolution.setSpeedBounds(ilo, ihi);
+    return(true);
+  }
+
+  // Seconds between TOW_OBS_PROFILE posts (0 = never post)
+  else if((param == "profile_interval") && non_neg_number) {
+    m_profile.setInterval(dval);
+    return(true);
+  }
+
+  // Evaluate the reflector's points on a pool of eval_threads
+  // threads (see AOF_TowObstacleParallel.cpp)
+  else if((param == "eval_threads") && non_neg_number) {
+    if((unsigned int)dval != m_eval_threads)
+      m_work_pool.reset();
+    m_eval_threads = (unsigned int)dval;
+    return(true);
+  }
+
+  // Cover regions the AOF bounds prove flat with single pieces,
+  // splitting the domain no finer than min_course x min_speed
+  // points
+  else if(param == "interval_bounds")
+    return(setBooleanOnString(m_interval_bounds, val));
+  else if((param == "interval_min_course") && isNumber(val) && (int)dval > 0) {
+    m_interval_min_crs = (int)dval;
+    return(true);
+  }
+  else if((param == "interval_min_speed") && isNumber(val) && (int)dval > 0) {
+    m_interval_min_spd = (int)dval;
+    return(true);
+  }
+
+  // Wall-clock budget in ms for buildOF(), 0 builds at full
+  // fidelity only (see TowFidelity.h)
+  else if((param == "anytime_deadline") && non_neg_number) {
+    m_anytime_deadline = dval;
+    return(true);
+  }
+
   else if(param == "allstop_on_breach")
     return(setBooleanOnString(m_allstop_on_breach, val));
   else if(param == "use_side_lock")
@@ -353,6 +575,8 @@ void BHV_TowObstacleAvoid::onHelmStart()
 
 void BHV_TowObstacleAvoid::onEveryState(string str)
 {
+  m_profile.beginIteration();
+
   // =================================================================
   // Part 1: Check for completion based on obstacle manager
   // =================================================================
@@ -402,6 +626,7 @@ void BHV_TowObstacleAvoid::onEveryState(string str)
   //   m_rng_sys:        cable min dist, drives relevance and TTC
   //   tow_only_rng:     tow pose to obstacle only (drives completion)
   // =================================================================
+  TowProfile::Time t_range = TowProfile::now();
   double os_range_to_poly = m_obship_model.getRange();
 
   // Default to NAV range; overwritten with tow-based values when tow is valid
@@ -449,6 +674,9 @@ void BHV_TowObstacleAvoid::onEveryState(string str)
   tmp_val = getBufferDoubleVal("TOW_TAN_DAMPING", ok_tmp);
   if(ok_tmp) m_c_tan = tmp_val;
 
+  string integ_str = getBufferStringVal("TOW_INTEGRATOR", ok_tmp);
+  if(ok_tmp) towIntegratorFromString(integ_str, m_integrator);
+
   // Read tow deployment state from pTowing
   string deploy_str = getBufferStringVal("TOW_DEPLOYED");
   m_tow_deployed = (deploy_str == "true");
@@ -556,6 +784,10 @@ void BHV_TowObstacleAvoid::onEveryState(string str)
     }
 
     XYPolygon gut_poly = m_obship_model.getGutPoly();
+    PolyFieldDist gut_dist;
+    gut_dist.set(gut_poly);
+    updateDistGrid(gut_poly);
+    gut_dist.setGrid(m_dist_grid);
 
     // Compute cable attachment point (node0) on vessel stern
     double osx = m_obship_model.getOSX();
@@ -566,7 +798,7 @@ void BHV_TowObstacleAvoid::onEveryState(string str)
     node0_y = osy - m_attach_offset * sin(hdg_rad_n0);
 
     // Tow truth range: actual tow pose to obstacle (used for completion)
-    double tow_rng_actual = gut_poly.dist_to_poly(m_towed_x, m_towed_y);
+    double tow_rng_actual = gut_dist.dist(m_towed_x, m_towed_y);
     if(tow_rng_actual < 0) tow_rng_actual = 0;
     tow_rng_actual = std::max(0.0, tow_rng_actual - m_tow_pad);
 
@@ -574,37 +806,18 @@ void BHV_TowObstacleAvoid::onEveryState(string str)
     double start_x = node0_x;
     double start_y = node0_y;
     if(m_cable_start_node > 0) {
-      int num_nodes_est;
-      if(m_cable_length < 30.0)
-        num_nodes_est = 3;
-      else
-        num_nodes_est = std::max(3, (int)(m_cable_length / 10.0));
+      int num_nodes_est = towCableNodes(m_cable_length);
       int sn = std::min(m_cable_start_node, num_nodes_est - 1);
       double frac_start = (double)sn / (double)(num_nodes_est - 1);
       start_x = node0_x + frac_start * (m_towed_x - node0_x);
       start_y = node0_y + frac_start * (m_towed_y - node0_y);
     }
 
-    // Sample along cable for closest approach (completion)
-    double cable_rng_actual = tow_rng_actual;
-    if(m_cable_sample_step > 0.1) {
-      double cx = m_towed_x - start_x;
-      double cy = m_towed_y - start_y;
-      double clen = std::hypot(cx, cy);
-      if(clen > m_cable_sample_step) {
-        int samples = (int)ceil(clen / m_cable_sample_step);
-        for(int s = 1; s < samples; s++) {
-          double frac = (double)s / (double)samples;
-          double sx = start_x + frac * cx;
-          double sy = start_y + frac * cy;
-          double ds = gut_poly.dist_to_poly(sx, sy);
-          if(ds < 0) ds = 0;
-          ds = std::max(0.0, ds - m_tow_pad);
-          if(ds < cable_rng_actual)
-            cable_rng_actual = ds;
-        }
-      }
-    }
+    // Closest approach of the cable line (completion)
+    double cable_rng_actual = gut_dist.segDist(start_x, start_y,
+                                               m_towed_x, m_towed_y);
+    if(cable_rng_actual < 0) cable_rng_actual = 0;
+    cable_rng_actual = std::max(0.0, cable_rng_actual - m_tow_pad);
     m_rng_tow_actual = std::min(tow_rng_actual, cable_rng_actual);
     tow_only_rng = tow_rng_actual;
 
@@ -612,13 +825,15 @@ void BHV_TowObstacleAvoid::onEveryState(string str)
     start_nx = node0_x;
     start_ny = node0_y;
     double rng_cable = cableMinDistToPoly(node0_x, node0_y,
-                                          m_towed_x, m_towed_y, gut_poly,
+                                          m_towed_x, m_towed_y, gut_dist,
                                           &start_nx, &start_ny);
     m_rng_tow = rng_cable;
     m_rng_sys = rng_cable;
     m_rng_src = "tow";
     os_range_to_poly = m_rng_sys;
+    m_profile.countDist(gut_dist.queries());
   }
+  m_profile.add(TOW_PROF_RANGE, t_range);
 
   // Range is valid when tow-derived or NAV-derived
   bool tow_sys_valid = (m_tow_pose_valid && (m_rng_src == "tow") && (m_rng_sys >= 0));
@@ -797,6 +1012,9 @@ IvPFunction* BHV_TowObstacleAvoid::onRunState()
   m_obstacle_relevance = getRelevance();
   if(m_obstacle_relevance <= 0)
     return 0;
+
+  if(fieldCovered())
+    return 0;
   
   IvPFunction* ipf = buildOF();
 
@@ -819,8 +1037,116 @@ IvPFunction* BHV_TowObstacleAvoid::onRunState()
 
 //-----------------------------------------------------------
 // Procedure: buildOF()
+//   Purpose: Build the objective function. With anytime_deadline
+//            set, build at increasing fidelity (see TowFidelity.h)
+//            until the per-iteration wall-clock deadline and keep
+//            the last function completed. The coarse level always
+//            runs; a later level is skipped when its time in the
+//            previous iteration would overrun the deadline, and
+//            abandoned if the deadline passes while it is built.
 
 IvPFunction *BHV_TowObstacleAvoid::buildOF()
+{
+  chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+
+  bool anytime = (m_anytime_deadline > 0) && m_tow_pose_valid &&
+    (m_sim_horizon > -1.5);
+
+  IvPFunction *ipf = 0;
+  if(!anytime) {
+    bool expired = false;
+    ipf = buildOFLevel(TOW_FID_FULL, false, t_start, expired);
+    m_fidelity = TOW_FID_FULL;
+  }
+  else {
+    chrono::steady_clock::time_point deadline = t_start +
+      chrono::duration_cast<chrono::steady_clock::duration>(
+        chrono::duration<double, milli>(m_anytime_deadline));
+    for(int i = TOW_FID_COARSE; i <= TOW_FID_FULL; i++) {
+      TowFidelity level = (TowFidelity)i;
+      chrono::steady_clock::time_point t_level =
+        chrono::steady_clock::now();
+      if(level != TOW_FID_COARSE) {
+        chrono::duration<double, milli> left = deadline - t_level;
+        if(m_level_ms[i] > left.count()) {
+          // Let the estimate decay so the level is retried
+          m_level_ms[i] *= 0.75;
+          break;
+        }
+      }
+
+      bool expired = false;
+      IvPFunction *level_ipf = buildOFLevel(level, (level != TOW_FID_COARSE),
+                                            deadline, expired);
+      chrono::duration<double, milli> level_ms =
+        chrono::steady_clock::now() - t_level;
+      if(expired) {
+        // At least twice what it got before the deadline
+        m_level_ms[i] = std::max(m_level_ms[i], 2 * level_ms.count());
+        break;
+      }
+      m_level_ms[i] = level_ms.count();
+      if(!level_ipf) {
+        if(ipf)
+          break;
+        return(0);
+      }
+      delete(ipf);
+      ipf = level_ipf;
+      m_fidelity = level;
+    }
+  }
+
+  chrono::duration<double, milli> used =
+    chrono::steady_clock::now() - t_start;
+  m_build_ms = used.count();
+  if(m_anytime_deadline > 0) {
+    string msg = "level=" + intToString((int)m_fidelity);
+    msg += ",fidelity=" + string(towFidelityName(m_fidelity));
+    msg += ",used_ms=" + doubleToString(m_build_ms, 1);
+    msg += ",deadline_ms=" + doubleToString(m_anytime_deadline, 1);
+    postMessage("TOW_OBS_FIDELITY", msg);
+  }
+
+  // Resize the pieces for the next build from this one's time
+  if(m_resolution.active() && (m_build_info == "")) {
+    double relevance = m_obstacle_relevance;
+    for(unsigned int i=0; i<m_field_members.size(); i++)
+      relevance = std::max(relevance, m_field_members[i].relevance);
+    string msg = "piece_course=" + intToString(m_resolution.pieceCourse());
+    msg += ",piece_speed=" + intToString(m_resolution.pieceSpeed());
+    msg += ",build_ms=" + doubleToString(m_build_ms, 1);
+    msg += ",target_ms=" + doubleToString(m_resolution.getTarget(), 1);
+    postMessage("TOW_OBS_RESOLUTION", msg);
+    m_resolution.update(m_build_ms, relevance);
+  }
+
+  // A joint function carries the weight of its most relevant obstacle
+  if(ipf) {
+    double relevance = m_obstacle_relevance;
+    for(unsigned int i=0; i<m_field_members.size(); i++)
+      relevance = std::max(relevance, m_field_members[i].relevance);
+    ipf->setPWT(relevance * m_priority_wt);
+    postViewablePolygons();
+  }
+
+  // Where this iteration's time went, at most every profile_interval
+  double curr_time = getBufferCurrTime();
+  if(m_profile.endIteration(curr_time))
+    postMessage("TOW_OBS_PROFILE", m_profile.report(curr_time));
+
+  return(ipf);
+}
+
+//-----------------------------------------------------------
+// Procedure: buildOFLevel()
+//   Purpose: Build the objective function at one fidelity level.
+//            With use_deadline, expired is set (and null returned)
+//            if the deadline passed before the build completed.
+
+IvPFunction *BHV_TowObstacleAvoid::buildOFLevel(
+    TowFidelity level, bool use_deadline,
+    chrono::steady_clock::time_point deadline, bool& expired)
 {
   AOF_TowObstacleAvoid aof_avoid(m_domain);
   aof_avoid.setObShipModel(m_obship_model);
@@ -841,9 +1167,22 @@ IvPFunction *BHV_TowObstacleAvoid::buildOF()
     aof_avoid.setTowState(m_towed_x, m_towed_y, towed_vx, towed_vy);
     aof_avoid.setTowDynParams(m_cable_length, m_attach_offset,
                               m_k_spring, m_cd, m_c_tan);
-    aof_avoid.setCableSampleStep(m_cable_sample_step);
     aof_avoid.setCableCheckInterval(m_cable_check_interval);
     aof_avoid.setCableStartNode(m_cable_start_node);
+    aof_avoid.setSweptCheck(m_swept_check);
+    aof_avoid.setAdaptiveStep(m_adaptive_max_dt);
+    aof_avoid.setIntegrator(m_integrator);
+    aof_avoid.setFloatEval(m_aof_float);
+    aof_avoid.setCascade(m_cascade, m_cascade_band);
+    aof_avoid.setSurrogate(m_surrogate);
+    aof_avoid.setSurrogateTolerances(m_surrogate_pos_tol,
+                                     m_surrogate_vel_tol);
+    aof_avoid.setTractrix(m_tractrix);
+    aof_avoid.setTractrixTolerances(m_tractrix_pos_tol, m_tractrix_vel_tol);
+    aof_avoid.setTractrixGate(m_tractrix_min_v0, m_tractrix_cpa_margin,
+                              m_tractrix_spd_margin);
+    aof_avoid.setTrajectoryCache(m_traj_cache, getBufferCurrTime(),
+                                 m_traj_cache_mb);
     aof_avoid.setUseCableDynamics(m_use_refinery);
     //aof_avoid.setUseCableDynamics(true);
 
@@ -855,6 +1194,19 @@ IvPFunction *BHV_TowObstacleAvoid::buildOF()
     // as the vessel moves, which is physically reasonable.
     aof_avoid.setSimParams(m_sim_dt, m_sim_horizon, m_turn_rate_max);
     aof_avoid.setTowSpeedPenalty(m_tow_deployed);
+
+    // Lower fidelity levels shorten the horizon (and for coarse,
+    // lengthen the step and relax the cable)
+    if(level != TOW_FID_FULL) {
+      double horizon = m_sim_horizon;
+      if(horizon <= 0)
+        horizon = m_obship_model.getAllowableTTC();
+      TowFidelityParams fp = towFidelityParams(level, m_sim_dt, horizon,
+                                               m_use_refinery, m_integrator,
+                                               m_k_spring, m_c_tan);
+      aof_avoid.setSimParams(fp.sim_dt, fp.horizon, m_turn_rate_max);
+      aof_avoid.setUseCableDynamics(fp.cable_dynamics);
+    }
   }
   else {
     aof_avoid.setTowEval(false);
@@ -863,14 +1215,41 @@ IvPFunction *BHV_TowObstacleAvoid::buildOF()
 
   aof_avoid.setSideLock(m_side_lock);
 
+  updateDistGrid(m_obship_model.getGutPoly());
+  aof_avoid.setDistanceGrid(m_dist_grid);
+  for(unsigned int i=0; i<m_field_members.size(); i++)
+    aof_avoid.addObstacle(m_field_members[i].gut, m_field_members[i].grid,
+                          m_field_members[i].side_lock);
+
+  // Cached utilities are full fidelity
+  if(m_eval_cache_on && (level == TOW_FID_FULL)) {
+    unsigned int num_crs = m_domain.getVarPoints(m_domain.getIndex("course"));
+    unsigned int num_spd = m_domain.getVarPoints(m_domain.getIndex("speed"));
+    m_eval_cache.beginBuild(evalCacheState(), num_crs, num_spd);
+    aof_avoid.setEvalCache(&m_eval_cache);
+  }
+
+  if(use_deadline)
+    aof_avoid.setDeadline(deadline);
+  aof_avoid.setBuildMemo(m_build_memo);
+
+  TowProfile::Time t_phase = TowProfile::now();
   bool ok_init = aof_avoid.initialize();
+  t_phase = m_profile.add(TOW_PROF_INIT, t_phase);
   if(!ok_init) {
     string aof_msg = aof_avoid.getCatMsgsAOF();
     postWMessage("Unable to init AOF_TowObstacleAvoid:" + aof_msg);
     return(0);
   }
 
-  OF_Reflector reflector(&aof_avoid, 1);
+  // Eval modes bypassed by another mode, reported when they change
+  if(aof_avoid.getModeConflicts() != m_mode_conflicts) {
+    m_mode_conflicts = aof_avoid.getModeConflicts();
+    if(m_mode_conflicts != "")
+      postWMessage("Eval modes: " + m_mode_conflicts);
+  }
+
+  vector<IvPBox> plateau_regions, basin_regions;
 
   // Refine regions: use vessel perspective while approaching, switch
   // to tow perspective once the vessel has passed the obstacle.
@@ -902,41 +1281,126 @@ IvPFunction *BHV_TowObstacleAvoid::buildOF()
 
     refinery.setRefineRegions(refine_model);
 
-    vector<IvPBox> plateau_regions = refinery.getPlateaus();
-    vector<IvPBox> basin_regions   = refinery.getBasins();
+    // Plateaus are clear of this obstacle only, not the others in
+    // a joint build; basins stay valid since the joint utility is
+    // no higher than this obstacle's
+    if(m_field_members.empty())
+      plateau_regions = refinery.getPlateaus();
+    basin_regions = refinery.getBasins();
+  }
 
-    for(unsigned int i=0; i<plateau_regions.size(); i++)
-      reflector.setParam("plateau_region", plateau_regions[i]);
-    for(unsigned int i=0; i<basin_regions.size(); i++)
-      reflector.setParam("basin_region", basin_regions[i]);
+  // Boxes the AOF's interval bounds prove flat, tow and cable
+  // included, so the reflector need not sample their interiors
+  if(m_interval_bounds) {
+    vector<IvPBox> plateaus, basins;
+    aof_avoid.findFlatBoxes(m_interval_min_crs, m_interval_min_spd,
+                            plateaus, basins);
+    plateau_regions.insert(plateau_regions.end(), plateaus.begin(),
+                           plateaus.end());
+    basin_regions.insert(basin_regions.end(), basins.begin(), basins.end());
+  }
+  t_phase = m_profile.add(TOW_PROF_REFINE, t_phase);
+
+  // Parallel build: a dry run notes the points the reflector
+  // samples, the pool evaluates them, and the real run below is
+  // served from the AOF's table
+  bool parallel = (m_eval_threads != 1);
+  if(parallel) {
+    if(!m_work_pool)
+      m_work_pool.reset(new TowWorkPool(m_eval_threads));
+    aof_avoid.setPointRecording(true);
+    OF_Reflector dry_reflector(&aof_avoid, 1);
+    createReflector(dry_reflector, plateau_regions, basin_regions);
+    aof_avoid.evalRecordedPoints(*m_work_pool);
   }
 
-  if(m_build_info != "")
-    reflector.create(m_build_info);
-  else {
-    reflector.setParam("uniform_piece", "discrete@course:3,speed:3");
-    reflector.setParam("uniform_grid",  "discrete@course:9,speed:9");
-    //reflector.setParam("uniform_piece", "discrete@course:6,speed:3"); //play with values to see degredation
-    //reflector.setParam("uniform_grid",  "discrete@course:12,speed:9");
-    reflector.create();
+  OF_Reflector reflector(&aof_avoid, 1);
+  createReflector(reflector, plateau_regions, basin_regions);
+  t_phase = m_profile.add(TOW_PROF_CREATE, t_phase);
+  m_profile.count(aof_avoid.getEvalCalls(), aof_avoid.getSimSteps(),
+                  aof_avoid.getDistQueries());
+
+  if(parallel) {
+    string msg = "threads=" + uintToString(m_work_pool->size());
+    msg += ",points=" + uintToString(aof_avoid.getRecordedPoints());
+    msg += ",served=" + uintToString((unsigned int)aof_avoid.getTableServed());
+    msg += ",steals=" + uintToString((unsigned int)m_work_pool->steals());
+    postMessage("TOW_OBS_THREADS", msg);
+  }
+
+  // Repeated points are what the overlapping refine regions cost
+  if(m_build_memo) {
+    string msg = "calls=" + uintToString((unsigned int)aof_avoid.getEvalCalls());
+    msg += ",dups=" + uintToString((unsigned int)aof_avoid.getEvalDuplicates());
+    msg += ",plateaus=" + uintToString(plateau_regions.size());
+    msg += ",basins=" + uintToString(basin_regions.size());
+    postMessage("TOW_OBS_MEMO", msg);
   }
 
   //add speed to reflector.
 
+  if(m_eval_cache_on && (level == TOW_FID_FULL))
+    postMessage("TOW_OBS_CACHE", m_eval_cache.getReport());
+
+  if(aof_avoid.usingTrajectoryCache()) {
+    ostringstream os;
+    os.setf(ios::fixed);
+    os.precision(1);
+    os << "hits=" << aof_avoid.getTrajectoryHits()
+       << ",misses=" << aof_avoid.getTrajectoryMisses()
+       << ",live=" << aof_avoid.getTrajectoryLive()
+       << ",total_hits=" << TowTrajectoryCache::cacheHits()
+       << ",total_misses=" << TowTrajectoryCache::cacheMisses()
+       << ",sets=" << TowTrajectoryCache::cacheSets()
+       << ",mb=" << TowTrajectoryCache::cacheBytes() / (1024.0 * 1024.0);
+    postMessage("TOW_OBS_TRAJ_CACHE", os.str());
+  }
+
+  expired = aof_avoid.deadlineExpired();
+  if(expired)
+    return(0);
+
   if(!reflector.stateOK()) {
     postWMessage(reflector.getWarnings());
     return(0);
   }
 
+  t_phase = TowProfile::now();
   IvPFunction *ipf = reflector.extractIvPFunction(true);
-  if(ipf) {
-    ipf->setPWT(m_obstacle_relevance * m_priority_wt);
-    postViewablePolygons();
-  }
-
+  m_profile.add(TOW_PROF_EXTRACT, t_phase);
   return(ipf);
 }
 
+//-----------------------------------------------------------
+// Procedure: createReflector()
+//   Purpose: Give the reflector its flat regions and build pieces,
+//            the same for the dry and real runs of a parallel build.
+
+void BHV_TowObstacleAvoid::createReflector(OF_Reflector& reflector,
+                                           const vector<IvPBox>& plateaus,
+                                           const vector<IvPBox>& basins) const
+{
+  for(unsigned int i=0; i<plateaus.size(); i++)
+    reflector.setParam("plateau_region", plateaus[i]);
+  for(unsigned int i=0; i<basins.size(); i++)
+    reflector.setParam("basin_region", basins[i]);
+
+  if(m_build_info != "")
+    reflector.create(m_build_info);
+  else if(m_resolution.active()) {
+    reflector.setParam("uniform_piece", m_resolution.pieceSpec());
+    reflector.setParam("uniform_grid",  m_resolution.gridSpec());
+    reflector.create();
+  }
+  else {
+    reflector.setParam("uniform_piece", "discrete@course:3,speed:3");
+    reflector.setParam("uniform_grid",  "discrete@course:9,speed:9");
+    //reflector.setParam("uniform_piece", "discrete@course:6,speed:3"); //play with values to see degredation
+    //reflector.setParam("uniform_grid",  "discrete@course:12,speed:9");
+    reflector.create();
+  }
+}
+
 //-----------------------------------------------------------
 // Procedure: getRelevance()
 //   Purpose: Compute relevance from tow-aware system range.
@@ -1138,6 +1602,26 @@ double BHV_TowObstacleAvoid::getDoubleInfo(string str)
     return(m_obship_model.getMinUtilCPA());
   else if(str == "max_util_cpa")
     return(m_obship_model.getMaxUtilCPA());
+  else if(str == "cache_hit_rate")
+    return(m_eval_cache.hitRate());
+  else if(str == "cache_saved_ms")
+    return(m_eval_cache.savedMS());
+  else if(str == "fidelity_level")
+    return((double)m_fidelity);
+  else if(str == "build_ms")
+    return(m_build_ms);
+  else if(str == "piece_course")
+    return((double)m_resolution.pieceCourse());
+  else if(str == "piece_speed")
+    return((double)m_resolution.pieceSpeed());
+  else if(str == "build_target_ms")
+    return(m_resolution.getTarget());
+
+  // Phase times and counts of this iteration (see TowProfile.h),
+  // e.g. profile_create_ms or profile_dist_queries
+  double val = 0;
+  if((str.find("profile_") == 0) && m_profile.info(str.substr(8), val))
+    return(val);
 
   return(0);
 }
@@ -1305,66 +1789,95 @@ bool BHV_TowObstacleAvoid::towObstacleAbaftBeam(double deg_abaft) const
   return(fabs(rel_bearing) > (90.0 + deg_abaft));
 }
 
+//------------------------------------------------------------
+// Procedure: updateDistGrid()
+//   Purpose: Fetch the signed-distance raster for the current gut
+//            poly when sdf_cell_size is set. Grids are built on
+//            first use and cached process-wide by polygon, so a
+//            respawned behavior for the same obstacle reuses it.
+
+void BHV_TowObstacleAvoid::updateDistGrid(const XYPolygon& gut_poly)
+{
+  if(m_sdf_cell_size > 0)
+    m_dist_grid = PolySDFGrid::get(gut_poly, m_sdf_cell_size, m_sdf_max_range);
+  else
+    m_dist_grid.reset();
+}
+
+//------------------------------------------------------------
+// Procedure: evalCacheState()
+//   Purpose: State key for the eval cache. The continuous part is
+//            matched within tolerance; everything else that buildOF()
+//            hands the AOF goes in the config string and must match
+//            exactly.
+
+TowEvalState BHV_TowObstacleAvoid::evalCacheState() const
+{
+  TowEvalState state;
+  state.osx = m_obship_model.getOSX();
+  state.osy = m_obship_model.getOSY();
+  state.osh = m_obship_model.getOSH();
+  if(m_tow_pose_valid) {
+    state.tow_x = m_towed_x;
+    state.tow_y = m_towed_y;
+    if(m_towed_vel_valid) {
+      state.tow_vx = m_towed_vx;
+      state.tow_vy = m_towed_vy;
+    }
+  }
+
+  ostringstream os;
+  os.precision(17);
+  os << m_tow_pose_valid << m_tow_deployed << m_use_refinery << ","
+     << m_cable_length << "," << m_attach_offset << "," << m_k_spring
+     << "," << m_cd << "," << m_c_tan << "," << m_sim_dt << ","
+     << m_sim_horizon << "," << m_turn_rate_max << ","
+     << m_cable_check_interval << ","
+     << m_cable_start_node << "," << m_swept_check << ","
+     << m_adaptive_max_dt << "," << (int)m_integrator << ","
+     << m_aof_float << "," << m_cascade << "," << m_cascade_band
+     << "," << m_surrogate_file << "," << m_surrogate_pos_tol << ","
+     << m_surrogate_vel_tol << "," << m_tractrix << ","
+     << m_tractrix_pos_tol << "," << m_tractrix_vel_tol << ","
+     << m_tractrix_min_v0 << "," << m_tractrix_cpa_margin << ","
+     << m_tractrix_spd_margin << ","
+     << m_traj_cache
+     << "," << m_sdf_cell_size << "," << m_sdf_max_range
+     << "," << m_side_lock << ","
+     << m_obship_model.getMinUtilCPA() << ","
+     << m_obship_model.getMaxUtilCPA() << ","
+     << m_obship_model.getAllowableTTC() << ","
+     << m_obship_model.getGutPoly().get_spec_pts(2);
+  for(unsigned int i=0; i<m_field_members.size(); i++)
+    os << ";" << m_field_members[i].id << ","
+       << m_field_members[i].side_lock << ","
+       << m_field_members[i].gut.get_spec_pts(2);
+  state.config = os.str();
+  return(state);
+}
+
 //------------------------------------------------------------
 // Procedure: cableMinDistToPoly()
-//   Purpose: Compute minimum distance from any cable node to
-//            the obstacle polygon using a relaxed cable shape.
-//            Initializes nodes as a straight line from anchor
-//            to tow, then runs spring-damper relaxation passes
-//            (mirroring Cable.cpp / AOF dynamics) to approximate
-//            the true cable curve.
+//   Purpose: Compute minimum distance from the cable to the
+//            obstacle polygon using a relaxed cable shape: a
+//            straight line from anchor to tow pulled to the rest
+//            length by constraint passes (towRelaxCable()), to
+//            approximate the true cable curve. Each segment
+//            between nodes is measured exactly
+//            (PolyFieldDist::segDist()).
 
 double BHV_TowObstacleAvoid::cableMinDistToPoly(
     double ax, double ay,
     double tx, double ty,
-    const XYPolygon &poly,
+    const PolyFieldDist &poly,
     double *start_node_x,
     double *start_node_y) const
 {
-  // Number of cable nodes (same formula as AOF / pCable)
-  int num_nodes;
-  if(m_cable_length < 30.0)
-    num_nodes = 3;
-  else
-    num_nodes = std::max(3, (int)(m_cable_length / 10.0));
+  // Relaxed cable shape, as in the AOF (lib_towdyn)
+  int num_nodes = towCableNodes(m_cable_length);
   double rest_length = m_cable_length / (double)(num_nodes - 1);
-
-  // Initialize nodes as straight line from anchor to tow
   vector<double> nx(num_nodes), ny(num_nodes);
-  for(int i = 0; i < num_nodes; i++) {
-    double frac = (double)i / (double)(num_nodes - 1);
-    nx[i] = ax + frac * (tx - ax);
-    ny[i] = ay + frac * (ty - ay);
-  }
-
-  // Relaxation: run constraint passes to approximate cable drape.
-  // No velocity integration needed — just enforce distance constraints
-  // iteratively from the straight-line initialization.
-  int relax_iters = 4;
-  for(int r = 0; r < relax_iters; r++) {
-    // Forward pass: pull interior nodes toward previous neighbor
-    for(int i = 1; i < num_nodes - 1; i++) {
-      double dx = nx[i-1] - nx[i];
-      double dy = ny[i-1] - ny[i];
-      double dist = hypot(dx, dy);
-      if(dist > rest_length && dist > 1e-9) {
-        double sc = rest_length / dist;
-        nx[i] = nx[i-1] - dx * sc;
-        ny[i] = ny[i-1] - dy * sc;
-      }
-    }
-    // Backward pass: pull interior nodes toward next neighbor
-    for(int i = num_nodes - 2; i >= 1; i--) {
-      double dx = nx[i+1] - nx[i];
-      double dy = ny[i+1] - ny[i];
-      double dist = hypot(dx, dy);
-      if(dist > rest_length && dist > 1e-9) {
-        double sc = rest_length / dist;
-        nx[i] = nx[i+1] - dx * sc;
-        ny[i] = ny[i+1] - dy * sc;
-      }
-    }
-  }
+  towRelaxCable(rest_length, num_nodes, ax, ay, tx, ty, &nx[0], &ny[0]);
 
   // Skip shallow nodes near surface when cable_start_node is set
   int start = std::min(m_cable_start_node, num_nodes - 1);
@@ -1373,41 +1886,15 @@ double BHV_TowObstacleAvoid::cableMinDistToPoly(
   if(start_node_x) *start_node_x = nx[start];
   if(start_node_y) *start_node_y = ny[start];
 
-  // Find minimum distance from cable nodes to the polygon
+  // Exact distance from the cable segments to the polygon, or from
+  // the tow alone if the start node is the last
   double min_dist = 1e9;
-  for(int i = start; i < num_nodes; i++) {
-    double d = poly.dist_to_poly(nx[i], ny[i]);
-    if(d < 0) d = 0;
-    d = std::max(0.0, d - m_tow_pad);
-    if(d < min_dist)
-      min_dist = d;
-    if(min_dist <= 0)
-      return 0;
-  }
-
-  // Interpolate between adjacent relaxed nodes
-  if(m_cable_sample_step > 0.1) {
-    for(int i = start; i + 1 < num_nodes; i++) {
-      double dx = nx[i+1] - nx[i];
-      double dy = ny[i+1] - ny[i];
-      double seg_len = hypot(dx, dy);
-      if(seg_len > m_cable_sample_step) {
-        int samples = (int)ceil(seg_len / m_cable_sample_step);
-        for(int s = 1; s < samples; s++) {
-          double frac = (double)s / (double)samples;
-          double sx = nx[i] + frac * dx;
-          double sy = ny[i] + frac * dy;
-          double d = poly.dist_to_poly(sx, sy);
-          if(d < 0) d = 0;
-          d = std::max(0.0, d - m_tow_pad);
-          if(d < min_dist)
-            min_dist = d;
-          if(min_dist <= 0)
-            return 0;
-        }
-      }
-    }
-  }
+  if(start + 1 >= num_nodes)
+    min_dist = poly.exactDist(nx[start], ny[start]);
+  for(int i = start; i + 1 < num_nodes; i++)
+    min_dist = std::min(min_dist, poly.segDist(nx[i], ny[i], nx[i+1], ny[i+1]));
+  if(min_dist < 0) min_dist = 0;
+  min_dist = std::max(0.0, min_dist - m_tow_pad);
 
   return min_dist;
 }
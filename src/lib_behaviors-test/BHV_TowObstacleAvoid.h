@@ -8,11 +8,25 @@
 #ifndef TowObstacleAvoid_HEADER
 #define TowObstacleAvoid_HEADER
 
+#include <chrono>
 #include "IvPBehavior.h"
+#include "IvPBox.h"
 #include "ObShipModelV24.h"
 #include "XYPolygon.h"
+#include "PolyFieldDist.h"
+#include "PolySDFGrid.h"
+#include "TowIntegrator.h"
+#include "TowEvalCache.h"
+#include "TowFidelity.h"
+#include "TowResolution.h"
+#include "TowProfile.h"
+#include "TowSurrogate.h"
+#include "TowObstacleField.h"
+#include "TowWorkPool.h"
 #include "HintHolder.h"
 
+class OF_Reflector;
+
 class BHV_TowObstacleAvoid : public IvPBehavior {
 public:
   BHV_TowObstacleAvoid(IvPDomain);
@@ -44,6 +58,12 @@ protected: // Local Utility functions
   void   initVisualHints();
   
   IvPFunction* buildOF();
+  IvPFunction* buildOFLevel(TowFidelity level, bool use_deadline,
+                            std::chrono::steady_clock::time_point deadline,
+                            bool& expired);
+  void createReflector(OF_Reflector& reflector,
+                       const std::vector<IvPBox>& plateaus,
+                       const std::vector<IvPBox>& basins) const;
 
   //Tow Specific Utilities
   double computeRangeRelevanceFromRange(double range) const;
@@ -53,9 +73,15 @@ protected: // Local Utility functions
                                                     double tow_vx, double tow_vy,
                                                     double fallback_hdg) const;
   bool towObstacleAbaftBeam(double deg_abaft) const;
+  void updateDistGrid(const XYPolygon& gut_poly);
+  TowEvalState evalCacheState() const;
+
+  // Hook for joint field builds (see BHV_TowObstacleField): true if
+  // another behavior's function covers this obstacle this iteration
+  virtual bool fieldCovered() {return(false);}
   double cableMinDistToPoly(double ax, double ay,
                             double tx, double ty,
-                            const XYPolygon &poly,
+                            const PolyFieldDist &poly,
                             double *start_node_x = nullptr,
                             double *start_node_y = nullptr) const;
 
@@ -85,6 +111,66 @@ protected: // Configuration parameters
   double m_abaft_beam_thresh;  // degrees abaft the beam for bearing-based completion (-1 = disabled)
   bool   m_post_view_points;
 
+  // Optional signed-distance raster for the gut poly (0 = off)
+  double m_sdf_cell_size;
+  double m_sdf_max_range;
+  std::shared_ptr<const PolySDFGrid> m_dist_grid;
+
+  // Cross-iteration eval cache (off by default)
+  bool         m_eval_cache_on;
+  TowEvalCache m_eval_cache;
+
+  // Precomputed tow response table (none by default)
+  std::string  m_surrogate_file;
+  std::shared_ptr<const TowSurrogate> m_surrogate;
+  double       m_surrogate_pos_tol;  // m
+  double       m_surrogate_vel_tol;  // m/s
+
+  // Closed-form tractrix tow model where it holds (off by default)
+  bool         m_tractrix;
+  double       m_tractrix_pos_tol;   // m
+  double       m_tractrix_vel_tol;   // m/s
+  double       m_tractrix_min_v0;    // m/s
+  double       m_tractrix_cpa_margin; // m
+  double       m_tractrix_spd_margin; // m/s
+
+  // Trajectories shared across spawned instances (off by default)
+  bool         m_traj_cache;
+  double       m_traj_cache_mb;
+
+  // Evaluate each domain point at most once per build (on by
+  // default), posting how often the reflector repeats one
+  bool         m_build_memo;
+
+  // Threads evaluating the reflector's points (1 = serial on the
+  // helm thread, 0 = one per hardware thread)
+  unsigned int m_eval_threads;
+  std::shared_ptr<TowWorkPool> m_work_pool;
+
+  // Flat regions from interval bounds on the AOF, given to the
+  // reflector as plateaus and basins (off by default)
+  bool         m_interval_bounds;
+  int          m_interval_min_crs;   // course domain points
+  int          m_interval_min_spd;   // speed domain points
+
+  // Anytime build: wall-clock budget per iteration (0 = off)
+  double       m_anytime_deadline;   // ms
+  double       m_level_ms[3];        // last build time per level
+  TowFidelity  m_fidelity;           // level of the last function
+  double       m_build_ms;           // buildOF() time, last iteration
+
+  // Reflector pieces sized to hold build_target_ms (off by default;
+  // ignored when build_info is given)
+  TowResolutionTuner m_resolution;
+
+  // Per-phase timing and counts of this iteration, posted as
+  // TOW_OBS_PROFILE every profile_interval seconds
+  TowProfile   m_profile;
+
+  // Other obstacles checked in this behavior's forward sim, set by
+  // fieldCovered() for each build (none for a single obstacle)
+  std::vector<TowFieldMember> m_field_members;
+
 protected: // State variables
   double  m_obstacle_relevance;
   bool    m_resolved_pending;
@@ -98,6 +184,7 @@ protected: // State variables
   double  m_cpa_reported;
 
   std::string m_side_lock;
+  std::string m_mode_conflicts;  // last reported by the AOF
 
   // Tow state
   double m_towed_x;
@@ -143,9 +230,14 @@ protected: // State variables
   double m_sim_horizon;
   double m_turn_rate_max;
 
-  double m_cable_sample_step;
   int    m_cable_check_interval;
   int    m_cable_start_node;
+  bool   m_swept_check;      // continuous contact checks between steps
+  double m_adaptive_max_dt;  // 0 for fixed sim steps
+  TowIntegrator m_integrator;
+  bool   m_aof_float;        // single-precision AOF forward sim
+  bool   m_cascade;          // relaxed-cable screening
+  double m_cascade_band;     // m over the measured model gap
 
   bool   m_tow_deployed;
 
@@ -156,8 +248,12 @@ protected:
 
 #define IVP_EXPORT_FUNCTION
 
+// Defined only by the plugin's factory unit; the towobstacle
+// library and subclass plugins are built without it
+#ifndef TOW_OBSTACLE_AVOID_NO_FACTORY
 extern "C" {
   IVP_EXPORT_FUNCTION IvPBehavior * createBehavior(std::string name, IvPDomain domain) 
   {return new BHV_TowObstacleAvoid(domain);}
 }
 #endif
+#endif
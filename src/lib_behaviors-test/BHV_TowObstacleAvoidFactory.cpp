@@ -0,0 +1,13 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: BHV_TowObstacleAvoidFactory.cpp                 */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+// The helm plugin for BHV_TowObstacleAvoid holds only the
+// factory. The behavior itself lives in the shared towobstacle
+// library, so the avoid and field plugins loaded by one helm
+// share its caches and work pool.
+
+#include "BHV_TowObstacleAvoid.h"
@@ -0,0 +1,182 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: BHV_TowObstacleField.cpp                        */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* The builder's function takes, for every candidate, the   */
+/* nearest approach of cable and tow to any member over one */
+/* sim, so the utility is the least over the field under    */
+/* the builder's CPA thresholds, and its weight is that of  */
+/* the most relevant member. Members join a build only if   */
+/* their CPA thresholds, allowable TTC and priority weight  */
+/* match the builder's (fieldConfig()); the others build    */
+/* their own functions.                                     */
+/*                                                          */
+/* The helm runs the members one after another, so the      */
+/* builder sees the members that run after it as they stood */
+/* in the previous iteration: gut poly, grid, side lock and */
+/* relevance one helm iteration old (field_stale bounds the */
+/* age). Obstacle polys move little between iterations, but */
+/* a member whose relevance drops to zero still weighs in   */
+/* for that iteration. A member with no earlier post (new,  */
+/* or back after leaving the field) is not in the build and */
+/* builds its own function.                                 */
+/************************************************************/
+
+#include <cstdlib>
+#include <sstream>
+#include "BHV_TowObstacleField.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Constructor()
+
+BHV_TowObstacleField::BHV_TowObstacleField(IvPDomain gdomain) :
+  BHV_TowObstacleAvoid(gdomain)
+{
+  this->setParam("descriptor", "towobsfield");
+
+  m_field        = "";
+  m_field_stale  = 2.0;
+  m_field_joined = false;
+}
+
+//---------------------------------------------------------------
+// Destructor()
+
+BHV_TowObstacleField::~BHV_TowObstacleField()
+{
+  leaveField();
+}
+
+//---------------------------------------------------------------
+// Procedure: setParam()
+
+bool BHV_TowObstacleField::setParam(string param, string val)
+{
+  if(BHV_TowObstacleAvoid::setParam(param, val))
+    return(true);
+
+  double dval = atof(val.c_str());
+  bool   non_neg_number = (isNumber(val) && (dval >= 0));
+
+  if(param == "field") {
+    m_field = stripBlankEnds(val);
+    return(true);
+  }
+  else if((param == "field_stale") && non_neg_number) {
+    m_field_stale = dval;
+    return(true);
+  }
+
+  return(false);
+}
+
+//---------------------------------------------------------------
+// Procedure: onIdleState()
+
+void BHV_TowObstacleField::onIdleState()
+{
+  BHV_TowObstacleAvoid::onIdleState();
+  leaveField();
+}
+
+//---------------------------------------------------------------
+// Procedure: onCompleteState()
+
+void BHV_TowObstacleField::onCompleteState()
+{
+  BHV_TowObstacleAvoid::onCompleteState();
+  leaveField();
+}
+
+//---------------------------------------------------------------
+// Procedure: onInactiveState()
+
+void BHV_TowObstacleField::onInactiveState()
+{
+  BHV_TowObstacleAvoid::onInactiveState();
+  leaveField();
+}
+
+//---------------------------------------------------------------
+// Procedure: fieldCovered()
+//   Purpose: Post this obstacle to the field, then either claim
+//            the iteration's build (gathering the other members
+//            for it) or, if another member has it, report this
+//            obstacle covered. If that build left this obstacle
+//            out, it builds a function of its own.
+
+bool BHV_TowObstacleField::fieldCovered()
+{
+  m_field_members.clear();
+  if(m_field == "")
+    return(false);
+
+  double curr_time = getBufferCurrTime();
+
+  TowFieldMember self;
+  self.id        = m_descriptor;
+  self.gut       = m_obship_model.getGutPoly();
+  self.grid      = m_dist_grid;
+  self.side_lock = m_side_lock;
+  self.relevance = m_obstacle_relevance;
+  self.stamp     = curr_time;
+  self.config    = fieldConfig();
+  TowObstacleField::update(fieldKey(), self);
+  m_field_joined = true;
+
+  if(!TowObstacleField::claimBuild(fieldKey(), m_descriptor, curr_time,
+                                   curr_time - m_field_stale,
+                                   m_field_members)) {
+    if(!TowObstacleField::covered(fieldKey(), m_descriptor, curr_time))
+      return(false);
+    postViewablePolygons();
+    return(true);
+  }
+
+  string msg = "field=" + m_field + ",builder=" + m_descriptor;
+  msg += ",members=" + uintToString(m_field_members.size() + 1);
+  postMessage("TOW_OBS_FIELD", msg);
+  return(false);
+}
+
+//---------------------------------------------------------------
+// Procedure: leaveField()
+
+void BHV_TowObstacleField::leaveField()
+{
+  m_field_members.clear();
+  if(!m_field_joined)
+    return;
+  TowObstacleField::remove(fieldKey(), m_descriptor);
+  m_field_joined = false;
+}
+
+//---------------------------------------------------------------
+// Procedure: fieldConfig()
+//   Purpose: The settings a joint build applies to every member
+//            in place of the member's own.
+
+string BHV_TowObstacleField::fieldConfig() const
+{
+  ostringstream os;
+  os.precision(17);
+  os << m_obship_model.getMinUtilCPA() << ","
+     << m_obship_model.getMaxUtilCPA() << ","
+     << m_obship_model.getAllowableTTC() << "," << m_priority_wt;
+  return(os.str());
+}
+
+//---------------------------------------------------------------
+// Procedure: fieldKey()
+//   Purpose: Field names are scoped to the vehicle, in case more
+//            than one helm shares the process.
+
+string BHV_TowObstacleField::fieldKey() const
+{
+  return(m_us_name + "/" + m_field);
+}
@@ -0,0 +1,51 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: BHV_TowObstacleField.h                          */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* BHV_TowObstacleAvoid for a field of obstacles, with one  */
+/* forward sim per helm iteration for the whole field       */
+/* instead of one per obstacle. Spawned per obstacle like   */
+/* the base behavior, so ranges, CPA and range flags,       */
+/* completion and view posts stay per obstacle. Instances   */
+/* sharing a field name meet in TowObstacleField; the first */
+/* to run each iteration builds one function against every  */
+/* member, and the members it took in return none.          */
+/************************************************************/
+
+#ifndef TowObstacleField_HEADER
+#define TowObstacleField_HEADER
+
+#include <string>
+#include "BHV_TowObstacleAvoid.h"
+
+class BHV_TowObstacleField : public BHV_TowObstacleAvoid {
+public:
+  BHV_TowObstacleField(IvPDomain);
+  ~BHV_TowObstacleField();
+
+  bool  setParam(std::string, std::string);
+  void  onIdleState();
+  void  onCompleteState();
+  void  onInactiveState();
+
+protected:
+  bool  fieldCovered();
+  void  leaveField();
+  std::string fieldConfig() const;
+  std::string fieldKey() const;
+
+protected: // Configuration parameters
+  std::string m_field;        // field name, empty for a lone obstacle
+  double      m_field_stale;  // s, members older than this are left out
+
+protected: // State variables
+  bool        m_field_joined;
+};
+
+extern "C" {
+  IVP_EXPORT_FUNCTION IvPBehavior * createBehavior(std::string name, IvPDomain domain)
+  {return new BHV_TowObstacleField(domain);}
+}
+#endif
@@ -0,0 +1,607 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: ConvexPolyDist.cpp                              */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "ConvexPolyDist.h"
+#include "PolySDFGrid.h"
+#include "TowSimd.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Constructors
+
+ConvexPolyDist::ConvexPolyDist()
+{
+  m_convex = true;
+  m_closed = false;
+  m_empty  = true;
+}
+
+ConvexPolyDist::ConvexPolyDist(const XYPolygon& poly)
+{
+  m_convex = true;
+  m_closed = false;
+  m_empty  = true;
+  set(poly);
+}
+
+//---------------------------------------------------------------
+// Procedure: set()
+//   Purpose: Prepare the edge tables for a polygon. Repeated
+//            vertices are dropped, and edges are oriented
+//            counter-clockwise so the normals point outward.
+
+bool ConvexPolyDist::set(const XYPolygon& poly)
+{
+  m_ex.clear();
+  m_ey.clear();
+  m_ux.clear();
+  m_uy.clear();
+  m_nx.clear();
+  m_ny.clear();
+  m_len.clear();
+  m_fex.clear();
+  m_fey.clear();
+  m_fux.clear();
+  m_fuy.clear();
+  m_fnx.clear();
+  m_fny.clear();
+  m_flen.clear();
+  m_poly = XYPolygon();
+  m_grid.reset();
+
+  unsigned int vsize = poly.size();
+  m_empty  = (vsize == 0);
+  m_closed = false;
+  m_convex = (vsize < 3) || poly.is_convex();
+  if(!m_convex) {
+    m_poly = poly;
+    return(false);
+  }
+  if(m_empty)
+    return(true);
+
+  // Distinct vertices in order
+  vector<double> vx, vy;
+  for(unsigned int i = 0; i < vsize; i++) {
+    double x = poly.get_vx(i);
+    double y = poly.get_vy(i);
+    if(!vx.empty() && (x == vx.back()) && (y == vy.back()))
+      continue;
+    vx.push_back(x);
+    vy.push_back(y);
+  }
+  while((vx.size() > 1) && (vx.back() == vx[0]) && (vy.back() == vy[0])) {
+    vx.pop_back();
+    vy.pop_back();
+  }
+
+  unsigned int n = vx.size();
+  m_closed = (n >= 3);
+
+  // Shoelace sign gives the winding; reverse clockwise input
+  double area2 = 0;
+  for(unsigned int i = 0; i < n; i++) {
+    unsigned int j = (i + 1) % n;
+    area2 += vx[i] * vy[j] - vx[j] * vy[i];
+  }
+  if(area2 < 0) {
+    reverse(vx.begin(), vx.end());
+    reverse(vy.begin(), vy.end());
+  }
+
+  // A single point is one zero-length edge; a segment is one edge
+  unsigned int num_edges = m_closed ? n : 1;
+  for(unsigned int i = 0; i < num_edges; i++) {
+    unsigned int j = (i + 1) % n;
+    double dx  = vx[j] - vx[i];
+    double dy  = vy[j] - vy[i];
+    double len = sqrt(dx*dx + dy*dy);
+    double ux  = (len > 0) ? dx / len : 0;
+    double uy  = (len > 0) ? dy / len : 0;
+    m_ex.push_back(vx[i]);
+    m_ey.push_back(vy[i]);
+    m_ux.push_back(ux);
+    m_uy.push_back(uy);
+    m_nx.push_back(uy);
+    m_ny.push_back(-ux);
+    m_len.push_back(len);
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: setGrid()
+//   Purpose: Attach a distance raster built for this polygon. Only
+//            accepted for convex polygons; null detaches.
+
+void ConvexPolyDist::setGrid(shared_ptr<const PolySDFGrid> grid)
+{
+  if(m_convex && !m_empty)
+    m_grid = grid;
+  else
+    m_grid.reset();
+}
+
+//---------------------------------------------------------------
+// Procedure: gridError()
+//   Purpose: Worst-case error of dist() due to the grid (0 if none).
+
+double ConvexPolyDist::gridError() const
+{
+  return(m_grid ? m_grid->maxError() : 0);
+}
+
+//---------------------------------------------------------------
+// Procedure: dist()
+//   Purpose: Distance from one point to the polygon, from the grid
+//            when one is attached and covers the point.
+
+double ConvexPolyDist::dist(double px, double py) const
+{
+  double d;
+  if(m_grid && m_grid->lookup(px, py, d))
+    return(d);
+  return(exactDist(px, py));
+}
+
+//---------------------------------------------------------------
+// Procedure: exactDist()
+//   Purpose: Distance from one point to the polygon. For each edge
+//            the projection onto the edge is clamped to [0, len];
+//            the point is inside when no outward normal offset is
+//            positive.
+
+double ConvexPolyDist::exactDist(double px, double py) const
+{
+  if(!m_convex)
+    return(m_poly.dist_to_poly(px, py));
+  if(m_empty)
+    return(-1);
+
+  double min_d2 = 1e300;
+  double max_s  = -1e300;
+  unsigned int num_edges = m_len.size();
+  for(unsigned int i = 0; i < num_edges; i++) {
+    double rx = px - m_ex[i];
+    double ry = py - m_ey[i];
+    double t  = rx * m_ux[i] + ry * m_uy[i];
+    t = min(max(t, 0.0), m_len[i]);
+    double qx = rx - t * m_ux[i];
+    double qy = ry - t * m_uy[i];
+    min_d2 = min(min_d2, qx*qx + qy*qy);
+    max_s  = max(max_s, rx * m_nx[i] + ry * m_ny[i]);
+  }
+  if(m_closed && (max_s <= 0))
+    return(0);
+  return(sqrt(min_d2));
+}
+
+//---------------------------------------------------------------
+// Procedure: setLocalFrame()
+//   Purpose: Prepare float copies of the edge tables with the
+//            edge origins taken relative to (ox,oy). Edges are
+//            short of float range only if far from the origin, so
+//            callers pick an origin near where they will query.
+
+bool ConvexPolyDist::setLocalFrame(double ox, double oy)
+{
+  m_fex.clear();
+  m_fey.clear();
+  m_fux.clear();
+  m_fuy.clear();
+  m_fnx.clear();
+  m_fny.clear();
+  m_flen.clear();
+  if(!m_convex || m_empty)
+    return(false);
+
+  unsigned int num_edges = m_len.size();
+  for(unsigned int i = 0; i < num_edges; i++) {
+    m_fex.push_back((float)(m_ex[i] - ox));
+    m_fey.push_back((float)(m_ey[i] - oy));
+    m_fux.push_back((float)m_ux[i]);
+    m_fuy.push_back((float)m_uy[i]);
+    m_fnx.push_back((float)m_nx[i]);
+    m_fny.push_back((float)m_ny[i]);
+    m_flen.push_back((float)m_len[i]);
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: localDist()
+//   Purpose: exactDist() in single precision on the local frame
+//            tables. Requires a successful setLocalFrame().
+
+float ConvexPolyDist::localDist(float px, float py) const
+{
+  float min_d2 = 3e38f;
+  float max_s  = -3e38f;
+  unsigned int num_edges = m_flen.size();
+  for(unsigned int i = 0; i < num_edges; i++) {
+    float rx = px - m_fex[i];
+    float ry = py - m_fey[i];
+    float t  = rx * m_fux[i] + ry * m_fuy[i];
+    t = min(max(t, 0.0f), m_flen[i]);
+    float qx = rx - t * m_fux[i];
+    float qy = ry - t * m_fuy[i];
+    min_d2 = min(min_d2, qx*qx + qy*qy);
+    max_s  = max(max_s, rx * m_fnx[i] + ry * m_fny[i]);
+  }
+  if(m_closed && (max_s <= 0))
+    return(0);
+  return(sqrt(min_d2));
+}
+
+//---------------------------------------------------------------
+// Procedure: localMinDist()
+//   Purpose: Smallest localDist() over n points. Returns 1e9 when
+//            n is 0, as minDist() does.
+
+float ConvexPolyDist::localMinDist(const float *px, const float *py,
+                                   unsigned int n) const
+{
+  float min_d = 1e9f;
+  for(unsigned int i = 0; i < n; i++) {
+    float d = localDist(px[i], py[i]);
+    if(d < min_d) {
+      min_d = d;
+      if(min_d <= 0)
+        break;
+    }
+  }
+  return(min_d);
+}
+
+//---------------------------------------------------------------
+// Procedure: signedDist()
+//   Purpose: As exactDist(), but inside a closed convex polygon
+//            returns minus the distance to the nearest edge (the
+//            largest, i.e. least negative, normal offset).
+
+double ConvexPolyDist::signedDist(double px, double py) const
+{
+  if(!m_convex || !m_closed)
+    return(exactDist(px, py));
+
+  double max_s = -1e300;
+  unsigned int num_edges = m_len.size();
+  for(unsigned int i = 0; i < num_edges; i++) {
+    double s = (px - m_ex[i]) * m_nx[i] + (py - m_ey[i]) * m_ny[i];
+    max_s = max(max_s, s);
+  }
+  if(max_s <= 0)
+    return(max_s);
+  return(exactDist(px, py));
+}
+
+//---------------------------------------------------------------
+// Procedure: segPointDist()
+//   Purpose: Distance from point (px,py) to segment (x0,y0)-(x1,y1).
+
+static double segPointDist(double x0, double y0, double x1, double y1,
+                           double px, double py)
+{
+  double dx = x1 - x0;
+  double dy = y1 - y0;
+  double rx = px - x0;
+  double ry = py - y0;
+  double l2 = dx*dx + dy*dy;
+  double t  = (l2 > 0) ? (rx * dx + ry * dy) / l2 : 0;
+  t = min(max(t, 0.0), 1.0);
+  double qx = rx - t * dx;
+  double qy = ry - t * dy;
+  return(sqrt(qx*qx + qy*qy));
+}
+
+//---------------------------------------------------------------
+// Procedure: segSegDist()
+//   Purpose: Distance between two segments, 0 if they cross.
+
+static double segSegDist(double ax, double ay, double bx, double by,
+                         double cx, double cy, double dx, double dy)
+{
+  double o1 = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+  double o2 = (bx - ax) * (dy - ay) - (by - ay) * (dx - ax);
+  double o3 = (dx - cx) * (ay - cy) - (dy - cy) * (ax - cx);
+  double o4 = (dx - cx) * (by - cy) - (dy - cy) * (bx - cx);
+  if((((o1 > 0) && (o2 < 0)) || ((o1 < 0) && (o2 > 0))) &&
+     (((o3 > 0) && (o4 < 0)) || ((o3 < 0) && (o4 > 0))))
+    return(0);
+
+  double d = segPointDist(ax, ay, bx, by, cx, cy);
+  d = min(d, segPointDist(ax, ay, bx, by, dx, dy));
+  d = min(d, segPointDist(cx, cy, dx, dy, ax, ay));
+  d = min(d, segPointDist(cx, cy, dx, dy, bx, by));
+  return(d);
+}
+
+//---------------------------------------------------------------
+// Procedure: segDist()
+//   Purpose: Distance from a segment to the polygon. The segment
+//            is clipped against the edge half-planes; if anything
+//            is left it touches the polygon. Otherwise the two
+//            are disjoint convex sets, so the closest pair has an
+//            end point of the segment or a polygon vertex in it.
+
+double ConvexPolyDist::segDist(double x0, double y0,
+                               double x1, double y1) const
+{
+  if(m_empty)
+    return(-1);
+
+  if(!m_convex) {
+    unsigned int vsize = m_poly.size();
+    if(m_poly.contains(x0, y0) || m_poly.contains(x1, y1))
+      return(0);
+    double d = 1e300;
+    for(unsigned int i = 0; i < vsize; i++) {
+      unsigned int j = (i + 1) % vsize;
+      d = min(d, segSegDist(x0, y0, x1, y1,
+                            m_poly.get_vx(i), m_poly.get_vy(i),
+                            m_poly.get_vx(j), m_poly.get_vy(j)));
+    }
+    return(d);
+  }
+
+  unsigned int num_edges = m_len.size();
+  if(!m_closed) {
+    double ex = m_ex[0] + m_len[0] * m_ux[0];
+    double ey = m_ey[0] + m_len[0] * m_uy[0];
+    return(segSegDist(x0, y0, x1, y1, m_ex[0], m_ey[0], ex, ey));
+  }
+
+  // Clip the segment to the polygon (Cyrus-Beck)
+  double dx = x1 - x0;
+  double dy = y1 - y0;
+  double t0 = 0;
+  double t1 = 1;
+  for(unsigned int i = 0; (i < num_edges) && (t0 <= t1); i++) {
+    double s0 = (x0 - m_ex[i]) * m_nx[i] + (y0 - m_ey[i]) * m_ny[i];
+    double ds = dx * m_nx[i] + dy * m_ny[i];
+    if(ds == 0) {
+      if(s0 > 0)
+        t0 = 2;
+    }
+    else if(ds < 0)
+      t0 = max(t0, -s0 / ds);
+    else
+      t1 = min(t1, -s0 / ds);
+  }
+  if(t0 <= t1)
+    return(0);
+
+  double d = min(exactDist(x0, y0), exactDist(x1, y1));
+  for(unsigned int i = 0; i < num_edges; i++)
+    d = min(d, segPointDist(x0, y0, x1, y1, m_ex[i], m_ey[i]));
+  return(d);
+}
+
+//---------------------------------------------------------------
+// Procedure: hull4()
+//   Purpose: Convex hull of four points, counter-clockwise, by
+//            monotone chain. Returns the vertex count (1 to 4);
+//            collinear points are dropped.
+
+static unsigned int hull4(const double *qx, const double *qy,
+                          double *hx, double *hy)
+{
+  unsigned int ix[4] = {0, 1, 2, 3};
+  for(unsigned int i = 1; i < 4; i++) {
+    for(unsigned int j = i; j > 0; j--) {
+      unsigned int a = ix[j-1];
+      unsigned int b = ix[j];
+      if((qx[b] < qx[a]) || ((qx[b] == qx[a]) && (qy[b] < qy[a]))) {
+        ix[j-1] = b;
+        ix[j]   = a;
+      }
+    }
+  }
+
+  unsigned int h[8];
+  unsigned int k = 0;
+  for(unsigned int i = 0; i < 4; i++) {        // lower chain
+    unsigned int p = ix[i];
+    while(k >= 2) {
+      unsigned int a = h[k-2], b = h[k-1];
+      double c = (qx[b]-qx[a]) * (qy[p]-qy[a]) - (qy[b]-qy[a]) * (qx[p]-qx[a]);
+      if(c > 0)
+        break;
+      k--;
+    }
+    h[k++] = p;
+  }
+  unsigned int lower = k + 1;
+  for(int i = 2; i >= 0; i--) {                // upper chain
+    unsigned int p = ix[i];
+    while(k >= lower) {
+      unsigned int a = h[k-2], b = h[k-1];
+      double c = (qx[b]-qx[a]) * (qy[p]-qy[a]) - (qy[b]-qy[a]) * (qx[p]-qx[a]);
+      if(c > 0)
+        break;
+      k--;
+    }
+    h[k++] = p;
+  }
+
+  unsigned int n = (k > 1) ? k - 1 : 1;        // last repeats the first
+  for(unsigned int i = 0; i < n; i++) {
+    hx[i] = qx[h[i]];
+    hy[i] = qy[h[i]];
+  }
+  return(n);
+}
+
+//---------------------------------------------------------------
+// Procedure: sweptDist()
+//   Purpose: Distance from the region a segment sweeps while its
+//            end points move linearly from a0,b0 to a1,b1. The
+//            region lies in the convex hull of the four points,
+//            which is what is measured, so the result never
+//            exceeds the true swept distance.
+//
+//   For a closed convex polygon the hull and polygon are tested
+//   for a separating axis among the edge normals of both; if none
+//   exists they overlap. Otherwise the closest pair has a vertex
+//   of one of them in it, so the distance is the smaller of the
+//   hull vertices to the polygon and the polygon vertices to the
+//   hull edges.
+
+double ConvexPolyDist::sweptDist(double ax0, double ay0,
+                                 double bx0, double by0,
+                                 double ax1, double ay1,
+                                 double bx1, double by1) const
+{
+  if(m_empty)
+    return(-1);
+
+  double qx[4] = {ax0, bx0, bx1, ax1};
+  double qy[4] = {ay0, by0, by1, ay1};
+  double hx[4], hy[4];
+  unsigned int hn = hull4(qx, qy, hx, hy);
+
+  if(hn == 1)
+    return(exactDist(hx[0], hy[0]));
+  if(hn == 2)
+    return(segDist(hx[0], hy[0], hx[1], hy[1]));
+
+  if(!m_convex || !m_closed) {
+    double d = 1e300;
+    for(unsigned int i = 0; i < hn; i++) {
+      unsigned int j = (i + 1) % hn;
+      d = min(d, segDist(hx[i], hy[i], hx[j], hy[j]));
+    }
+    // Polygon inside the hull: test one of its vertices
+    double vx = m_convex ? m_ex[0] : m_poly.get_vx(0);
+    double vy = m_convex ? m_ey[0] : m_poly.get_vy(0);
+    bool inside = true;
+    for(unsigned int i = 0; (i < hn) && inside; i++) {
+      unsigned int j = (i + 1) % hn;
+      if((hx[j]-hx[i]) * (vy-hy[i]) - (hy[j]-hy[i]) * (vx-hx[i]) < 0)
+        inside = false;
+    }
+    return(inside ? 0 : d);
+  }
+
+  unsigned int num_edges = m_len.size();
+  bool separated = false;
+
+  // Polygon edge normals: all hull vertices outside one edge
+  for(unsigned int i = 0; (i < num_edges) && !separated; i++) {
+    double min_s = 1e300;
+    for(unsigned int k = 0; k < hn; k++)
+      min_s = min(min_s, (hx[k] - m_ex[i]) * m_nx[i] + (hy[k] - m_ey[i]) * m_ny[i]);
+    separated = (min_s > 0);
+  }
+
+  // Hull edge normals: all polygon vertices outside one hull edge
+  for(unsigned int i = 0; (i < hn) && !separated; i++) {
+    unsigned int j = (i + 1) % hn;
+    double nx = hy[j] - hy[i];
+    double ny = hx[i] - hx[j];
+    double min_s = 1e300;
+    for(unsigned int k = 0; k < num_edges; k++)
+      min_s = min(min_s, (m_ex[k] - hx[i]) * nx + (m_ey[k] - hy[i]) * ny);
+    separated = (min_s > 0);
+  }
+
+  if(!separated)
+    return(0);
+
+  double d = 1e300;
+  for(unsigned int i = 0; i < hn; i++) {
+    unsigned int j = (i + 1) % hn;
+    d = min(d, exactDist(hx[i], hy[i]));
+    for(unsigned int k = 0; k < num_edges; k++)
+      d = min(d, segPointDist(hx[i], hy[i], hx[j], hy[j], m_ex[k], m_ey[k]));
+  }
+  return(d);
+}
+
+//---------------------------------------------------------------
+// Procedure: dist()
+//   Purpose: Distances from n points to the polygon, four per pass.
+
+void ConvexPolyDist::dist(const double *px, const double *py,
+                          unsigned int n, double *d) const
+{
+  if(!m_convex || m_empty || m_grid) {
+    for(unsigned int k = 0; k < n; k++)
+      d[k] = dist(px[k], py[k]);
+    return;
+  }
+
+  unsigned int k = 0;
+  for(; k + 4 <= n; k += 4)
+    dist4(px + k, py + k, d + k);
+  for(; k < n; k++)
+    d[k] = dist(px[k], py[k]);
+}
+
+//---------------------------------------------------------------
+// Procedure: minDist()
+//   Purpose: Smallest distance from n points to the polygon.
+//            Returns 1e9 when n is 0.
+
+double ConvexPolyDist::minDist(const double *px, const double *py,
+                               unsigned int n) const
+{
+  double min_d = 1e9;
+  if(!m_convex || m_empty || m_grid) {
+    for(unsigned int k = 0; k < n; k++)
+      min_d = min(min_d, dist(px[k], py[k]));
+    return(min_d);
+  }
+
+  double d4[4];
+  unsigned int k = 0;
+  for(; k + 4 <= n; k += 4) {
+    dist4(px + k, py + k, d4);
+    min_d = min(min_d, min(min(d4[0], d4[1]), min(d4[2], d4[3])));
+    if(min_d <= 0)
+      return(min_d);
+  }
+  for(; k < n; k++)
+    min_d = min(min_d, dist(px[k], py[k]));
+  return(min_d);
+}
+
+//---------------------------------------------------------------
+// Procedure: dist4()
+//   Purpose: Four-lane version of dist(). Same operations in the
+//            same order, so each lane equals the scalar result.
+
+void ConvexPolyDist::dist4(const double *px, const double *py, double *d) const
+{
+  TowVec4d vpx = TowVec4d::load(px);
+  TowVec4d vpy = TowVec4d::load(py);
+  TowVec4d min_d2(1e300);
+  TowVec4d max_s(-1e300);
+  TowVec4d zero(0.0);
+
+  unsigned int num_edges = m_len.size();
+  for(unsigned int i = 0; i < num_edges; i++) {
+    TowVec4d ux(m_ux[i]);
+    TowVec4d uy(m_uy[i]);
+    TowVec4d rx = vpx - TowVec4d(m_ex[i]);
+    TowVec4d ry = vpy - TowVec4d(m_ey[i]);
+    TowVec4d t  = rx * ux + ry * uy;
+    t = towMin(towMax(t, zero), TowVec4d(m_len[i]));
+    TowVec4d qx = rx - t * ux;
+    TowVec4d qy = ry - t * uy;
+    min_d2 = towMin(min_d2, qx*qx + qy*qy);
+    max_s  = towMax(max_s, rx * TowVec4d(m_nx[i]) + ry * TowVec4d(m_ny[i]));
+  }
+
+  TowVec4d res = towSqrt(min_d2);
+  if(m_closed)
+    res = towSelect(max_s <= zero, zero, res);
+  res.store(d);
+}
@@ -0,0 +1,113 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: ConvexPolyDist.h                                */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Prepared point-to-convex-polygon distance. Edge origins, */
+/* unit directions, outward normals and lengths are         */
+/* computed once in set(); each query is then a fixed,      */
+/* branch-free pass over the edges (clamped projection for  */
+/* the distance, signed normal offset for containment).     */
+/* The batched forms evaluate four points per pass using    */
+/* TowVec4d (see TowSimd.h).                                */
+/*                                                          */
+/* Results follow XYPolygon::dist_to_poly(): 0 for points   */
+/* inside, -1 for an empty polygon. A polygon that is not   */
+/* convex is kept as an XYPolygon and queried through       */
+/* dist_to_poly(), so callers can use this unconditionally. */
+/*                                                          */
+/* An optional PolySDFGrid can be attached with setGrid();  */
+/* queries inside the grid are then answered by bilinear    */
+/* lookup (error <= grid->maxError()), the rest by edges.   */
+/*                                                          */
+/* segDist() and sweptDist() are exact edge-kernel queries  */
+/* for a segment and for a segment moving between two       */
+/* positions (the convex hull of its four end points). They */
+/* ignore any attached grid.                                */
+/*                                                          */
+/* setLocalFrame() prepares single-precision copies of the  */
+/* edge tables relative to an origin near the query points, */
+/* so localDist() keeps float resolution where it matters.  */
+/* Convex polygons only; also ignores the grid.             */
+/************************************************************/
+
+#ifndef CONVEX_POLY_DIST_HEADER
+#define CONVEX_POLY_DIST_HEADER
+
+#include <vector>
+#include <memory>
+#include "XYPolygon.h"
+
+class PolySDFGrid;
+
+class ConvexPolyDist {
+public:
+  ConvexPolyDist();
+  ConvexPolyDist(const XYPolygon& poly);
+  ~ConvexPolyDist() {}
+
+  // Returns true if the prepared convex kernel is in use
+  bool   set(const XYPolygon& poly);
+
+  double dist(double px, double py) const;
+  void   dist(const double *px, const double *py, unsigned int n,
+              double *d) const;
+  double minDist(const double *px, const double *py, unsigned int n) const;
+
+  // Edge kernel only, ignoring any attached grid
+  double exactDist(double px, double py) const;
+  // Signed distance, negative inside (convex polygons only)
+  double signedDist(double px, double py) const;
+
+  // Segment (x0,y0)-(x1,y1) to the polygon, 0 if they touch
+  double segDist(double x0, double y0, double x1, double y1) const;
+  // Region swept by segment a0-b0 moving to a1-b1, 0 if touching
+  double sweptDist(double ax0, double ay0, double bx0, double by0,
+                   double ax1, double ay1, double bx1, double by1) const;
+
+  // Float edge tables about (ox,oy), false if not available
+  bool   setLocalFrame(double ox, double oy);
+  bool   hasLocalFrame() const {return(!m_flen.empty());}
+  // Points relative to the local frame origin
+  float  localDist(float px, float py) const;
+  float  localMinDist(const float *px, const float *py, unsigned int n) const;
+
+  void   setGrid(std::shared_ptr<const PolySDFGrid> grid);
+  double gridError() const;
+
+  bool   isConvex() const    {return(m_convex);}
+  unsigned int edges() const {return(m_len.size());}
+
+ private:
+  void   dist4(const double *px, const double *py, double *d) const;
+
+ private:
+  bool   m_convex;
+  bool   m_closed;    // three or more distinct vertices
+  bool   m_empty;
+
+  // Per-edge data, edge i runs from (m_ex[i],m_ey[i])
+  std::vector<double> m_ex;
+  std::vector<double> m_ey;
+  std::vector<double> m_ux;   // unit direction
+  std::vector<double> m_uy;
+  std::vector<double> m_nx;   // outward unit normal
+  std::vector<double> m_ny;
+  std::vector<double> m_len;
+
+  // Single-precision edge tables relative to the local frame
+  std::vector<float>  m_fex;
+  std::vector<float>  m_fey;
+  std::vector<float>  m_fux;
+  std::vector<float>  m_fuy;
+  std::vector<float>  m_fnx;
+  std::vector<float>  m_fny;
+  std::vector<float>  m_flen;
+
+  XYPolygon m_poly;           // fallback for non-convex input
+
+  std::shared_ptr<const PolySDFGrid> m_grid;
+};
+
+#endif
@@ -0,0 +1,304 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PolyFieldDist.cpp                               */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "PolyFieldDist.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Procedure: set()
+//   Purpose: Make the field a single polygon. The member is kept
+//            even if the polygon is empty, so a one-member field
+//            answers exactly as a ConvexPolyDist would.
+
+bool PolyFieldDist::set(const XYPolygon& poly)
+{
+  m_polys.clear();
+  m_cx.clear();
+  m_cy.clear();
+  m_rad.clear();
+  m_gerr.clear();
+
+  m_polys.push_back(ConvexPolyDist());
+  bool ok = m_polys[0].set(poly);
+  addBounds(poly);
+  return(ok);
+}
+
+//---------------------------------------------------------------
+// Procedure: setGrid()
+
+void PolyFieldDist::setGrid(shared_ptr<const PolySDFGrid> grid)
+{
+  if(m_polys.empty())
+    return;
+  m_polys[0].setGrid(grid);
+  m_gerr[0] = m_polys[0].gridError();
+}
+
+//---------------------------------------------------------------
+// Procedure: add()
+//   Purpose: Add a member. Empty polygons are ignored, and an empty
+//            first member (from set()) is replaced.
+
+void PolyFieldDist::add(const XYPolygon& poly,
+                        shared_ptr<const PolySDFGrid> grid)
+{
+  if(poly.size() == 0)
+    return;
+  if((m_polys.size() == 1) && (m_rad[0] < 0)) {
+    set(poly);
+    setGrid(grid);
+    return;
+  }
+
+  m_polys.push_back(ConvexPolyDist());
+  m_polys.back().set(poly);
+  m_polys.back().setGrid(grid);
+  addBounds(poly);
+  m_gerr.back() = m_polys.back().gridError();
+}
+
+//---------------------------------------------------------------
+// Procedure: addBounds()
+//   Purpose: Bounding circle about the vertex mean. A negative
+//            radius marks an empty polygon.
+
+void PolyFieldDist::addBounds(const XYPolygon& poly)
+{
+  unsigned int vsize = poly.size();
+  double cx = 0;
+  double cy = 0;
+  for(unsigned int i = 0; i < vsize; i++) {
+    cx += poly.get_vx(i);
+    cy += poly.get_vy(i);
+  }
+  double rad = -1;
+  if(vsize > 0) {
+    cx /= (double)vsize;
+    cy /= (double)vsize;
+    rad = 0;
+    for(unsigned int i = 0; i < vsize; i++)
+      rad = max(rad, hypot(poly.get_vx(i) - cx, poly.get_vy(i) - cy));
+  }
+  m_cx.push_back(cx);
+  m_cy.push_back(cy);
+  m_rad.push_back(rad);
+  m_gerr.push_back(0);
+}
+
+//---------------------------------------------------------------
+// Procedure: dist()
+//   Purpose: Range from one point to the nearest member. A member
+//            is skipped when its bounding circle, less its grid
+//            error, is no nearer than the best range so far.
+
+double PolyFieldDist::dist(double px, double py) const
+{
+  m_queries++;
+  unsigned int num = m_polys.size();
+  if(num == 0)
+    return(-1);
+  if(num == 1)
+    return(m_polys[0].dist(px, py));
+
+  double best = 1e300;
+  for(unsigned int i = 0; i < num; i++) {
+    double lb = hypot(px - m_cx[i], py - m_cy[i]) - m_rad[i] - m_gerr[i];
+    if(lb >= best)
+      continue;
+    best = min(best, m_polys[i].dist(px, py));
+    if(best <= 0)
+      break;
+  }
+  return(best);
+}
+
+//---------------------------------------------------------------
+// Procedure: dist()
+//   Purpose: Ranges from n points to the nearest member.
+
+void PolyFieldDist::dist(const double *px, const double *py,
+                         unsigned int n, double *d) const
+{
+  m_queries += n;
+  unsigned int num = m_polys.size();
+  if(num == 0) {
+    for(unsigned int k = 0; k < n; k++)
+      d[k] = -1;
+    return;
+  }
+
+  m_polys[0].dist(px, py, n, d);
+  if(num == 1)
+    return;
+
+  if(m_scratch.size() < n)
+    m_scratch.resize(n);
+  for(unsigned int i = 1; i < num; i++) {
+    m_polys[i].dist(px, py, n, &m_scratch[0]);
+    for(unsigned int k = 0; k < n; k++)
+      d[k] = min(d[k], m_scratch[k]);
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: minDist()
+//   Purpose: Smallest range from n points to any member.
+
+double PolyFieldDist::minDist(const double *px, const double *py,
+                              unsigned int n) const
+{
+  m_queries += n;
+  unsigned int num = m_polys.size();
+  if(num == 0)
+    return(-1);
+  if(num == 1)
+    return(m_polys[0].minDist(px, py, n));
+
+  double best = 1e9;
+  for(unsigned int i = 0; (i < num) && (best > 0); i++)
+    best = min(best, m_polys[i].minDist(px, py, n));
+  return(best);
+}
+
+//---------------------------------------------------------------
+// Procedure: exactDist()
+
+double PolyFieldDist::exactDist(double px, double py) const
+{
+  m_queries++;
+  unsigned int num = m_polys.size();
+  if(num == 0)
+    return(-1);
+  if(num == 1)
+    return(m_polys[0].exactDist(px, py));
+
+  double best = 1e300;
+  for(unsigned int i = 0; i < num; i++) {
+    if(hypot(px - m_cx[i], py - m_cy[i]) - m_rad[i] >= best)
+      continue;
+    best = min(best, m_polys[i].exactDist(px, py));
+    if(best <= 0)
+      break;
+  }
+  return(best);
+}
+
+//---------------------------------------------------------------
+// Procedure: segDist()
+
+double PolyFieldDist::segDist(double x0, double y0,
+                              double x1, double y1) const
+{
+  m_queries++;
+  unsigned int num = m_polys.size();
+  if(num == 0)
+    return(-1);
+  if(num == 1)
+    return(m_polys[0].segDist(x0, y0, x1, y1));
+
+  double best = 1e300;
+  for(unsigned int i = 0; (i < num) && (best > 0); i++)
+    best = min(best, m_polys[i].segDist(x0, y0, x1, y1));
+  return(best);
+}
+
+//---------------------------------------------------------------
+// Procedure: sweptDist()
+
+double PolyFieldDist::sweptDist(double ax0, double ay0,
+                                double bx0, double by0,
+                                double ax1, double ay1,
+                                double bx1, double by1) const
+{
+  m_queries++;
+  unsigned int num = m_polys.size();
+  if(num == 0)
+    return(-1);
+  if(num == 1)
+    return(m_polys[0].sweptDist(ax0, ay0, bx0, by0, ax1, ay1, bx1, by1));
+
+  double best = 1e300;
+  for(unsigned int i = 0; (i < num) && (best > 0); i++)
+    best = min(best, m_polys[i].sweptDist(ax0, ay0, bx0, by0,
+                                          ax1, ay1, bx1, by1));
+  return(best);
+}
+
+//---------------------------------------------------------------
+// Procedure: setLocalFrame()
+
+bool PolyFieldDist::setLocalFrame(double ox, double oy)
+{
+  if(m_polys.empty())
+    return(false);
+
+  bool ok = true;
+  for(unsigned int i = 0; i < m_polys.size(); i++)
+    ok = m_polys[i].setLocalFrame(ox, oy) && ok;
+  return(ok);
+}
+
+//---------------------------------------------------------------
+// Procedure: hasLocalFrame()
+
+bool PolyFieldDist::hasLocalFrame() const
+{
+  if(m_polys.empty())
+    return(false);
+  for(unsigned int i = 0; i < m_polys.size(); i++)
+    if(!m_polys[i].hasLocalFrame())
+      return(false);
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: localDist()
+
+float PolyFieldDist::localDist(float px, float py) const
+{
+  m_queries++;
+  unsigned int num = m_polys.size();
+  if(num == 1)
+    return(m_polys[0].localDist(px, py));
+
+  float best = 3e38f;
+  for(unsigned int i = 0; (i < num) && (best > 0); i++)
+    best = min(best, m_polys[i].localDist(px, py));
+  return(best);
+}
+
+//---------------------------------------------------------------
+// Procedure: localMinDist()
+
+float PolyFieldDist::localMinDist(const float *px, const float *py,
+                                  unsigned int n) const
+{
+  m_queries += n;
+  unsigned int num = m_polys.size();
+  if(num == 1)
+    return(m_polys[0].localMinDist(px, py, n));
+
+  float best = 1e9f;
+  for(unsigned int i = 0; (i < num) && (best > 0); i++)
+    best = min(best, m_polys[i].localMinDist(px, py, n));
+  return(best);
+}
+
+//---------------------------------------------------------------
+// Procedure: gridError()
+
+double PolyFieldDist::gridError() const
+{
+  double err = 0;
+  for(unsigned int i = 0; i < m_gerr.size(); i++)
+    err = max(err, m_gerr[i]);
+  return(err);
+}
@@ -0,0 +1,82 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PolyFieldDist.h                                 */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Distance to the nearest of a field of obstacle polygons, */
+/* with the query interface of ConvexPolyDist so the AOF's  */
+/* range checks serve one obstacle or many unchanged. Each  */
+/* member is a ConvexPolyDist with its own optional grid.   */
+/*                                                          */
+/* With one member every query is passed straight through,  */
+/* so single-obstacle results are bit-identical. With more, */
+/* a query returns the smallest member result, and scalar   */
+/* point queries skip members whose bounding circle (less   */
+/* their grid error) is already beyond the best range.      */
+/*                                                          */
+/* Empty polygons are not added, so an empty field answers  */
+/* -1 like an empty ConvexPolyDist.                         */
+/************************************************************/
+
+#ifndef POLY_FIELD_DIST_HEADER
+#define POLY_FIELD_DIST_HEADER
+
+#include <vector>
+#include <memory>
+#include "ConvexPolyDist.h"
+
+class PolyFieldDist {
+public:
+  PolyFieldDist() {m_queries = 0;}
+  ~PolyFieldDist() {}
+
+  // Replace the field with a single polygon (ConvexPolyDist::set())
+  bool   set(const XYPolygon& poly);
+  // Grid for the first member, as ConvexPolyDist::setGrid()
+  void   setGrid(std::shared_ptr<const PolySDFGrid> grid);
+  // Add a member with its own grid (may be null)
+  void   add(const XYPolygon& poly, std::shared_ptr<const PolySDFGrid> grid);
+
+  double dist(double px, double py) const;
+  void   dist(const double *px, const double *py, unsigned int n,
+              double *d) const;
+  double minDist(const double *px, const double *py, unsigned int n) const;
+  double exactDist(double px, double py) const;
+
+  double segDist(double x0, double y0, double x1, double y1) const;
+  double sweptDist(double ax0, double ay0, double bx0, double by0,
+                   double ax1, double ay1, double bx1, double by1) const;
+
+  // True only if every member has a local frame
+  bool   setLocalFrame(double ox, double oy);
+  bool   hasLocalFrame() const;
+  float  localDist(float px, float py) const;
+  float  localMinDist(const float *px, const float *py, unsigned int n) const;
+
+  // Largest member grid error
+  double gridError() const;
+
+  unsigned int size() const {return(m_polys.size());}
+
+  // Points and segments queried, for profiling
+  unsigned long queries() const {return(m_queries);}
+  void          clearQueries()  {m_queries = 0;}
+
+ private:
+  void   addBounds(const XYPolygon& poly);
+
+ private:
+  std::vector<ConvexPolyDist> m_polys;
+
+  // Bounding circle of each member, and its grid error
+  std::vector<double> m_cx;
+  std::vector<double> m_cy;
+  std::vector<double> m_rad;
+  std::vector<double> m_gerr;
+
+  mutable std::vector<double> m_scratch;
+  mutable unsigned long       m_queries;
+};
+
+#endif
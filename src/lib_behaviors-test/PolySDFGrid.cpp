@@ -0,0 +1,176 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PolySDFGrid.cpp                                 */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <algorithm>
+#include "PolySDFGrid.h"
+#include "ConvexPolyDist.h"
+
+using namespace std;
+
+namespace {
+
+// Process-wide grid cache, most recently used first
+typedef pair<string, shared_ptr<const PolySDFGrid> > GridEntry;
+
+const unsigned int  MAX_CACHED_GRIDS = 16;
+const unsigned long MAX_GRID_NODES   = 4000000;
+
+mutex            g_grid_mutex;
+list<GridEntry>  g_grid_cache;
+unsigned int     g_grid_hits   = 0;
+unsigned int     g_grid_misses = 0;
+
+}
+
+//---------------------------------------------------------------
+// Constructor()
+
+PolySDFGrid::PolySDFGrid()
+{
+  m_cell     = 0;
+  m_range    = 0;
+  m_x0       = 0;
+  m_y0       = 0;
+  m_inv_cell = 0;
+  m_cols     = 0;
+  m_rows     = 0;
+}
+
+//---------------------------------------------------------------
+// Procedure: get()
+//   Purpose: Return the cached grid for this polygon, cell size
+//            and range, building (and caching) it on first use.
+
+shared_ptr<const PolySDFGrid> PolySDFGrid::get(const XYPolygon& poly,
+                                               double cell_size,
+                                               double max_range)
+{
+  if(!(cell_size > 0) || !(max_range >= 0) || (poly.size() < 3))
+    return(shared_ptr<const PolySDFGrid>());
+
+  ostringstream key;
+  key.precision(17);
+  key << cell_size << "/" << max_range;
+  for(unsigned int i = 0; i < poly.size(); i++)
+    key << ":" << poly.get_vx(i) << "," << poly.get_vy(i);
+
+  lock_guard<mutex> lock(g_grid_mutex);
+
+  list<GridEntry>::iterator p;
+  for(p = g_grid_cache.begin(); p != g_grid_cache.end(); p++) {
+    if(p->first == key.str()) {
+      g_grid_hits++;
+      g_grid_cache.splice(g_grid_cache.begin(), g_grid_cache, p);
+      return(g_grid_cache.front().second);
+    }
+  }
+
+  g_grid_misses++;
+  shared_ptr<PolySDFGrid> grid(new PolySDFGrid());
+  if(!grid->build(poly, cell_size, max_range))
+    return(shared_ptr<const PolySDFGrid>());
+
+  g_grid_cache.push_front(GridEntry(key.str(), grid));
+  if(g_grid_cache.size() > MAX_CACHED_GRIDS)
+    g_grid_cache.pop_back();
+  return(grid);
+}
+
+//---------------------------------------------------------------
+// Procedure: build()
+//   Purpose: Sample the exact signed distance at every node of a
+//            grid covering the bounding box grown by max_range.
+
+bool PolySDFGrid::build(const XYPolygon& poly, double cell_size,
+                        double max_range)
+{
+  ConvexPolyDist pdist(poly);
+  if(!pdist.isConvex())
+    return(false);
+
+  double xmin = poly.get_vx(0);
+  double xmax = xmin;
+  double ymin = poly.get_vy(0);
+  double ymax = ymin;
+  for(unsigned int i = 1; i < poly.size(); i++) {
+    xmin = min(xmin, poly.get_vx(i));
+    xmax = max(xmax, poly.get_vx(i));
+    ymin = min(ymin, poly.get_vy(i));
+    ymax = max(ymax, poly.get_vy(i));
+  }
+
+  m_cell     = cell_size;
+  m_range    = max_range;
+  m_inv_cell = 1.0 / cell_size;
+  m_x0       = xmin - max_range;
+  m_y0       = ymin - max_range;
+  m_cols = (unsigned int)ceil((xmax + max_range - m_x0) / cell_size) + 1;
+  m_rows = (unsigned int)ceil((ymax + max_range - m_y0) / cell_size) + 1;
+  if((unsigned long)m_cols * m_rows > MAX_GRID_NODES)
+    return(false);
+
+  m_sd.resize(m_cols * m_rows);
+  for(unsigned int j = 0; j < m_rows; j++) {
+    double y = m_y0 + j * cell_size;
+    for(unsigned int i = 0; i < m_cols; i++)
+      m_sd[j * m_cols + i] = pdist.signedDist(m_x0 + i * cell_size, y);
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: lookup()
+//   Purpose: Bilinear distance at (px,py), clamped at 0. Returns
+//            false if the point is outside the grid.
+
+bool PolySDFGrid::lookup(double px, double py, double& dist) const
+{
+  double fx = (px - m_x0) * m_inv_cell;
+  double fy = (py - m_y0) * m_inv_cell;
+  if(!(fx >= 0) || !(fy >= 0))
+    return(false);
+  if((fx >= (double)(m_cols - 1)) || (fy >= (double)(m_rows - 1)))
+    return(false);
+
+  unsigned int i = (unsigned int)fx;
+  unsigned int j = (unsigned int)fy;
+  double u = fx - i;
+  double v = fy - j;
+
+  const double *r0 = &m_sd[j * m_cols + i];
+  const double *r1 = r0 + m_cols;
+  double d = (1 - v) * ((1 - u) * r0[0] + u * r0[1]) +
+    v * ((1 - u) * r1[0] + u * r1[1]);
+
+  dist = (d > 0) ? d : 0;
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedures: cacheHits(), cacheMisses(), cacheSize()
+
+unsigned int PolySDFGrid::cacheHits()
+{
+  lock_guard<mutex> lock(g_grid_mutex);
+  return(g_grid_hits);
+}
+
+unsigned int PolySDFGrid::cacheMisses()
+{
+  lock_guard<mutex> lock(g_grid_mutex);
+  return(g_grid_misses);
+}
+
+unsigned int PolySDFGrid::cacheSize()
+{
+  lock_guard<mutex> lock(g_grid_mutex);
+  return(g_grid_cache.size());
+}
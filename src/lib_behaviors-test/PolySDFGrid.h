@@ -0,0 +1,75 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: PolySDFGrid.h                                   */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Signed-distance raster around a convex obstacle polygon. */
+/* Nodes hold the exact signed distance (negative inside)   */
+/* on a square grid covering the polygon's bounding box     */
+/* grown by max_range. A query inside the grid is one       */
+/* bilinear lookup, clamped at 0 to match dist_to_poly();   */
+/* a query outside returns false so the caller can use the  */
+/* exact edge kernel.                                       */
+/*                                                          */
+/* Worst-case error: the signed distance of a convex poly   */
+/* is 1-Lipschitz, and bilinear weights satisfy             */
+/*   sum w_i |p - c_i|^2 = (u(1-u) + v(1-v)) h^2 <= h^2/2,  */
+/* so |lookup - dist_to_poly| <= h/sqrt(2) for cell size h. */
+/* maxError() returns this bound; keep the min/max util     */
+/* CPA margins larger than it.                              */
+/*                                                          */
+/* Grids are built on first use by get() and held in a      */
+/* small process-wide cache keyed on the vertex list, cell  */
+/* size and range, so a respawned behavior for the same     */
+/* obstacle reuses the grid.                                */
+/************************************************************/
+
+#ifndef POLY_SDF_GRID_HEADER
+#define POLY_SDF_GRID_HEADER
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "XYPolygon.h"
+
+class PolySDFGrid {
+public:
+  ~PolySDFGrid() {}
+
+  // Cached grid for this polygon, built if absent. Returns null if
+  // the polygon is not convex, or the grid would be too large.
+  static std::shared_ptr<const PolySDFGrid> get(const XYPolygon& poly,
+                                                double cell_size,
+                                                double max_range);
+
+  bool   lookup(double px, double py, double& dist) const;
+
+  double maxError() const  {return(m_cell * 0.7071067811865476);}
+  double cellSize() const  {return(m_cell);}
+  double maxRange() const  {return(m_range);}
+  unsigned int cols() const {return(m_cols);}
+  unsigned int rows() const {return(m_rows);}
+
+  // Cache statistics
+  static unsigned int cacheHits();
+  static unsigned int cacheMisses();
+  static unsigned int cacheSize();
+
+ private:
+  PolySDFGrid();
+  bool   build(const XYPolygon& poly, double cell_size, double max_range);
+
+ private:
+  double m_cell;
+  double m_range;
+  double m_x0;       // lower-left node
+  double m_y0;
+  double m_inv_cell;
+  unsigned int m_cols;
+  unsigned int m_rows;
+
+  std::vector<double> m_sd;  // [row * m_cols + col]
+};
+
+#endif
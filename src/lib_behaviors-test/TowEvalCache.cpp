@@ -0,0 +1,174 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowEvalCache.cpp                                */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <cmath>
+#include <sstream>
+#include "TowEvalCache.h"
+#include "AngleUtils.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Constructor()
+
+TowEvalCache::TowEvalCache()
+{
+  m_pos_tol = 0.5;
+  m_hdg_tol = 1.0;
+  m_vel_tol = 0.1;
+
+  m_have_state = false;
+  m_num_crs    = 0;
+  m_num_spd    = 0;
+  m_gen        = 1;
+
+  m_hits          = 0;
+  m_misses        = 0;
+  m_resets        = 0;
+  m_build_hits0   = 0;
+  m_build_misses0 = 0;
+  m_miss_ms       = 0;
+  m_saved_ms      = 0;
+}
+
+//---------------------------------------------------------------
+// Procedure: setTolerances()
+//   Purpose: Negative values are ignored. A tolerance of 0 keeps
+//            entries only while that component is unchanged.
+
+void TowEvalCache::setTolerances(double pos_tol, double hdg_tol,
+                                 double vel_tol)
+{
+  if(pos_tol >= 0) m_pos_tol = pos_tol;
+  if(hdg_tol >= 0) m_hdg_tol = hdg_tol;
+  if(vel_tol >= 0) m_vel_tol = vel_tol;
+}
+
+//---------------------------------------------------------------
+// Procedure: beginBuild()
+//   Purpose: Keep the entries if the domain is unchanged and the
+//            state is within tolerance of the one they were
+//            computed in; otherwise drop them and take state as
+//            the new reference.
+
+bool TowEvalCache::beginBuild(const TowEvalState& state,
+                              unsigned int num_crs, unsigned int num_spd)
+{
+  m_build_hits0   = m_hits;
+  m_build_misses0 = m_misses;
+
+  bool keep = m_have_state && (num_crs == m_num_crs) &&
+    (num_spd == m_num_spd) && withinTolerance(state);
+  if(keep)
+    return(true);
+
+  if(m_have_state)
+    m_resets++;
+  m_have_state = true;
+  m_state   = state;
+  m_num_crs = num_crs;
+  m_num_spd = num_spd;
+
+  unsigned int size = num_crs * num_spd;
+  if(m_utils.size() != size) {
+    m_utils.assign(size, 0);
+    m_stamp.assign(size, 0);
+  }
+  m_gen++;
+  if(m_gen == 0) {
+    m_stamp.assign(size, 0);
+    m_gen = 1;
+  }
+  return(false);
+}
+
+//---------------------------------------------------------------
+// Procedure: withinTolerance()
+
+bool TowEvalCache::withinTolerance(const TowEvalState& state) const
+{
+  if(state.config != m_state.config)
+    return(false);
+  if(hypot(state.osx - m_state.osx, state.osy - m_state.osy) > m_pos_tol)
+    return(false);
+  if(fabs(angleDiff(state.osh, m_state.osh)) > m_hdg_tol)
+    return(false);
+  if(hypot(state.tow_x - m_state.tow_x,
+           state.tow_y - m_state.tow_y) > m_pos_tol)
+    return(false);
+  if(hypot(state.tow_vx - m_state.tow_vx,
+           state.tow_vy - m_state.tow_vy) > m_vel_tol)
+    return(false);
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: lookup()
+
+bool TowEvalCache::lookup(unsigned int crs_ix, unsigned int spd_ix,
+                          double& util)
+{
+  if((crs_ix >= m_num_crs) || (spd_ix >= m_num_spd))
+    return(false);
+
+  unsigned int key = crs_ix * m_num_spd + spd_ix;
+  if(m_stamp[key] != m_gen)
+    return(false);
+
+  util = m_utils[key];
+  m_hits++;
+  if(m_misses > 0)
+    m_saved_ms += m_miss_ms / (double)m_misses;
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: store()
+//   Purpose: Record a computed utility and the time it took.
+
+void TowEvalCache::store(unsigned int crs_ix, unsigned int spd_ix,
+                         double util, double eval_ms)
+{
+  m_misses++;
+  m_miss_ms += eval_ms;
+  if((crs_ix >= m_num_crs) || (spd_ix >= m_num_spd))
+    return;
+
+  unsigned int key = crs_ix * m_num_spd + spd_ix;
+  m_utils[key] = util;
+  m_stamp[key] = m_gen;
+}
+
+//---------------------------------------------------------------
+// Procedure: hitRate()
+
+double TowEvalCache::hitRate() const
+{
+  unsigned long total = m_hits + m_misses;
+  if(total == 0)
+    return(0);
+  return((double)m_hits / (double)total);
+}
+
+//---------------------------------------------------------------
+// Procedure: getReport()
+//   Purpose: One-line summary for posting: totals, the last
+//            build's hits and misses, time saved and resets.
+
+string TowEvalCache::getReport() const
+{
+  ostringstream os;
+  os.setf(ios::fixed);
+  os.precision(3);
+  os << "hits=" << m_hits << ",misses=" << m_misses
+     << ",hit_rate=" << hitRate()
+     << ",build_hits=" << buildHits()
+     << ",build_misses=" << buildMisses();
+  os.precision(1);
+  os << ",saved_ms=" << m_saved_ms << ",resets=" << m_resets;
+  return(os.str());
+}
@@ -0,0 +1,99 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowEvalCache.h                                  */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Evaluation cache kept by BHV_TowObstacleAvoid across     */
+/* helm iterations. Between iterations ownship and the tow  */
+/* move only centimeters, so utilities from the previous    */
+/* build are still good to within the tolerances given.     */
+/*                                                          */
+/* Entries are keyed by the candidate box (its course and   */
+/* speed domain indices, as evalBox() reads them) under a   */
+/* state key: the continuous state (ownship pose, tow pose  */
+/* and velocity) plus a config string for everything that  */
+/* must match exactly (cable and sim params, obstacle spec, */
+/* flags). beginBuild() compares the new state with the     */
+/* state the entries were computed in and drops them all    */
+/* when any component has drifted past its tolerance or the */
+/* config differs. Drift is measured from that state, not   */
+/* from the last iteration, so it cannot accumulate.        */
+/*                                                          */
+/* A generation stamp per entry makes the drop O(1).        */
+/************************************************************/
+
+#ifndef TOW_EVAL_CACHE_HEADER
+#define TOW_EVAL_CACHE_HEADER
+
+#include <string>
+#include <vector>
+
+struct TowEvalState {
+  double osx, osy, osh;         // ownship pose
+  double tow_x, tow_y;          // tow pose
+  double tow_vx, tow_vy;        // tow velocity
+  std::string config;           // compared exactly
+
+  TowEvalState() : osx(0), osy(0), osh(0), tow_x(0), tow_y(0),
+                   tow_vx(0), tow_vy(0) {}
+};
+
+class TowEvalCache {
+public:
+  TowEvalCache();
+  ~TowEvalCache() {}
+
+  // Largest drift that keeps entries: meters, degrees, m/s
+  void   setTolerances(double pos_tol, double hdg_tol, double vel_tol);
+
+  // Start a build over a domain of num_crs x num_spd points.
+  // Returns true if entries from earlier builds are kept.
+  bool   beginBuild(const TowEvalState& state, unsigned int num_crs,
+                    unsigned int num_spd);
+
+  bool   lookup(unsigned int crs_ix, unsigned int spd_ix,
+                double& util);
+  void   store(unsigned int crs_ix, unsigned int spd_ix,
+               double util, double eval_ms);
+
+  // Totals since construction
+  unsigned long hits() const   {return(m_hits);}
+  unsigned long misses() const {return(m_misses);}
+  unsigned long resets() const {return(m_resets);}
+  double hitRate() const;
+  double savedMS() const       {return(m_saved_ms);}
+
+  // Since the last beginBuild()
+  unsigned long buildHits() const   {return(m_hits - m_build_hits0);}
+  unsigned long buildMisses() const {return(m_misses - m_build_misses0);}
+
+  std::string getReport() const;
+
+private:
+  bool   withinTolerance(const TowEvalState& state) const;
+
+private:
+  double m_pos_tol;
+  double m_hdg_tol;
+  double m_vel_tol;
+
+  bool         m_have_state;
+  TowEvalState m_state;         // state the entries were computed in
+  unsigned int m_num_crs;
+  unsigned int m_num_spd;
+
+  std::vector<double>       m_utils;
+  std::vector<unsigned int> m_stamp;   // entry valid if == m_gen
+  unsigned int              m_gen;
+
+  unsigned long m_hits;
+  unsigned long m_misses;
+  unsigned long m_resets;
+  unsigned long m_build_hits0;
+  unsigned long m_build_misses0;
+  double        m_miss_ms;       // eval time spent on misses
+  double        m_saved_ms;      // hits x mean miss cost at the time
+};
+
+#endif
@@ -0,0 +1,74 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowFidelity.h                                   */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Fidelity levels for the anytime build of the tow         */
+/* obstacle objective function. The behavior builds in      */
+/* level order until its per-iteration deadline and keeps   */
+/* the last function completed. Header-only, like           */
+/* TowIntegrator.h.                                         */
+/*                                                          */
+/*   coarse  Quarter horizon, sim step doubled (up to the   */
+/*           integrator's stable step) and the quasi-static */
+/*           relaxed cable: about 1/8 the cost of full.     */
+/*   short   Half horizon at the configured step and cable  */
+/*           model.                                         */
+/*   full    The configured forward simulation.             */
+/************************************************************/
+
+#ifndef TOW_FIDELITY_HEADER
+#define TOW_FIDELITY_HEADER
+
+#include <algorithm>
+#include "TowIntegrator.h"
+
+enum TowFidelity {
+  TOW_FID_COARSE = 0,
+  TOW_FID_SHORT,
+  TOW_FID_FULL
+};
+
+inline const char* towFidelityName(TowFidelity f)
+{
+  if(f == TOW_FID_COARSE) return("coarse");
+  if(f == TOW_FID_SHORT)  return("short");
+  return("full");
+}
+
+struct TowFidelityParams {
+  double sim_dt;
+  double horizon;
+  bool   cable_dynamics;
+};
+
+//----------------------------------------------------------------
+// towFidelityParams(): sim step, horizon (seconds, > 0) and cable
+// model for a level, given the configured ones.
+
+inline TowFidelityParams towFidelityParams(TowFidelity f, double sim_dt,
+                                           double horizon,
+                                           bool cable_dynamics,
+                                           TowIntegrator m, double k_spring,
+                                           double c_tan)
+{
+  TowFidelityParams p;
+  p.sim_dt = sim_dt;
+  p.horizon = horizon;
+  p.cable_dynamics = cable_dynamics;
+  if(f == TOW_FID_SHORT)
+    p.horizon = std::max(horizon / 2, 2 * sim_dt);
+  else if(f == TOW_FID_COARSE) {
+    p.horizon = std::max(horizon / 4, 2 * sim_dt);
+    p.cable_dynamics = false;
+    double dt = 2 * sim_dt;
+    double h_stable = towStableStep(m, k_spring, c_tan);
+    if(h_stable > 0)
+      dt = std::min(dt, h_stable);
+    p.sim_dt = std::max(dt, sim_dt);
+  }
+  return(p);
+}
+
+#endif
@@ -0,0 +1,115 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowObstacleField.cpp                            */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <map>
+#include <mutex>
+#include <set>
+#include "TowObstacleField.h"
+
+using namespace std;
+
+namespace {
+
+struct FieldEntry {
+  map<string, TowFieldMember> members;
+  string builder;           // member that claimed build_stamp
+  double build_stamp;
+  set<string> covered;      // members the builder took in
+
+  FieldEntry() : build_stamp(-1) {}
+};
+
+mutex                    g_field_mutex;
+map<string, FieldEntry>  g_fields;
+
+}
+
+//---------------------------------------------------------------
+// Procedure: update()
+
+void TowObstacleField::update(const string& field, const TowFieldMember& m)
+{
+  lock_guard<mutex> lock(g_field_mutex);
+  g_fields[field].members[m.id] = m;
+}
+
+//---------------------------------------------------------------
+// Procedure: remove()
+//   Purpose: Drop a member, and the field once it is empty.
+
+void TowObstacleField::remove(const string& field, const string& id)
+{
+  lock_guard<mutex> lock(g_field_mutex);
+  map<string, FieldEntry>::iterator p = g_fields.find(field);
+  if(p == g_fields.end())
+    return;
+  p->second.members.erase(id);
+  if(p->second.members.empty())
+    g_fields.erase(p);
+}
+
+//---------------------------------------------------------------
+// Procedure: claimBuild()
+//   Purpose: The first member to ask at a new helm time gets the
+//            build; the same member may ask again. The members are
+//            gathered under the same lock that records them as
+//            covered, so covered() agrees with what was built.
+//            Members configured unlike the builder are left out.
+
+bool TowObstacleField::claimBuild(const string& field, const string& id,
+                                  double stamp, double since,
+                                  vector<TowFieldMember>& members)
+{
+  members.clear();
+
+  lock_guard<mutex> lock(g_field_mutex);
+  FieldEntry& entry = g_fields[field];
+  if((entry.build_stamp == stamp) && (entry.builder != id))
+    return(false);
+  entry.builder     = id;
+  entry.build_stamp = stamp;
+  entry.covered.clear();
+
+  string config;
+  map<string, TowFieldMember>::const_iterator q = entry.members.find(id);
+  if(q != entry.members.end())
+    config = q->second.config;
+
+  for(q = entry.members.begin(); q != entry.members.end(); q++) {
+    if((q->first != id) && (q->second.stamp >= since) &&
+       (q->second.config == config)) {
+      members.push_back(q->second);
+      entry.covered.insert(q->first);
+    }
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: covered()
+
+bool TowObstacleField::covered(const string& field, const string& id,
+                               double stamp)
+{
+  lock_guard<mutex> lock(g_field_mutex);
+  map<string, FieldEntry>::const_iterator p = g_fields.find(field);
+  if((p == g_fields.end()) || (p->second.build_stamp != stamp))
+    return(false);
+  return(p->second.covered.count(id) > 0);
+}
+
+//---------------------------------------------------------------
+// Procedure: fieldSize()
+
+unsigned int TowObstacleField::fieldSize(const string& field)
+{
+  lock_guard<mutex> lock(g_field_mutex);
+  map<string, FieldEntry>::const_iterator p = g_fields.find(field);
+  if(p == g_fields.end())
+    return(0);
+  return(p->second.members.size());
+}
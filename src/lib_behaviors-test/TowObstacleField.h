@@ -0,0 +1,66 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowObstacleField.h                              */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Process-wide registry of the obstacles in a tow obstacle */
+/* field, shared by the BHV_TowObstacleField instances the  */
+/* helm spawns (one per obstacle). Each instance posts its  */
+/* gut poly, grid, side lock and relevance every iteration, */
+/* and one of them per helm iteration claims the build: it  */
+/* runs a single forward sim against every member, and the  */
+/* members it took in contribute no objective function of   */
+/* their own. A member the build left out (new to the field */
+/* or back after leaving it) builds its own.                */
+/*                                                          */
+/* Fields are keyed by name; members by id (the behavior's  */
+/* descriptor). Stamps are helm times, so a member posted   */
+/* in an earlier iteration is seen with that iteration's    */
+/* state. A build takes in only members whose config string */
+/* matches the builder's. All calls are thread-safe.        */
+/************************************************************/
+
+#ifndef TOW_OBSTACLE_FIELD_HEADER
+#define TOW_OBSTACLE_FIELD_HEADER
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "XYPolygon.h"
+#include "PolySDFGrid.h"
+
+struct TowFieldMember {
+  std::string id;
+  XYPolygon   gut;
+  std::shared_ptr<const PolySDFGrid> grid;
+  std::string side_lock;
+  double      relevance;
+  double      stamp;        // helm time of the last update
+  std::string config;       // what a joint build must share
+
+  TowFieldMember() : relevance(0), stamp(0) {}
+};
+
+class TowObstacleField {
+public:
+  // Add or refresh a member
+  static void update(const std::string& field, const TowFieldMember& m);
+  static void remove(const std::string& field, const std::string& id);
+
+  // Claim the build for helm time stamp. False if another member
+  // has already claimed it. Otherwise members gets the members
+  // other than id updated at or after since with id's config,
+  // which the build then covers.
+  static bool claimBuild(const std::string& field, const std::string& id,
+                         double stamp, double since,
+                         std::vector<TowFieldMember>& members);
+
+  // True if the build claimed for stamp took in member id
+  static bool covered(const std::string& field, const std::string& id,
+                      double stamp);
+
+  static unsigned int fieldSize(const std::string& field);
+};
+
+#endif
@@ -0,0 +1,171 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowProfile.h                                    */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Per-iteration timing of BHV_TowObstacleAvoid, by phase:  */
+/*                                                          */
+/*   range    onEveryState() tow and cable range checks     */
+/*   init     AOF initialize()                              */
+/*   refine   refinery and interval-bound region boxes      */
+/*   create   reflector create, parallel evaluation too     */
+/*   extract  IvP function extraction                       */
+/*                                                          */
+/* with the AOF's evalBox() calls, cable sim steps and      */
+/* obstacle distance queries. Anytime levels add up. The    */
+/* behavior posts report() as TOW_OBS_PROFILE no more often */
+/* than the interval, with the slowest iteration since the  */
+/* last post as peak_ms. Header-only, like TowFidelity.h.   */
+/************************************************************/
+
+#ifndef TOW_PROFILE_HEADER
+#define TOW_PROFILE_HEADER
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+enum TowProfPhase {
+  TOW_PROF_RANGE = 0,
+  TOW_PROF_INIT,
+  TOW_PROF_REFINE,
+  TOW_PROF_CREATE,
+  TOW_PROF_EXTRACT,
+  TOW_PROF_PHASES
+};
+
+inline const char* towProfPhaseName(TowProfPhase p)
+{
+  if(p == TOW_PROF_RANGE)  return("range");
+  if(p == TOW_PROF_INIT)   return("init");
+  if(p == TOW_PROF_REFINE) return("refine");
+  if(p == TOW_PROF_CREATE) return("create");
+  return("extract");
+}
+
+class TowProfile {
+public:
+  typedef std::chrono::steady_clock::time_point Time;
+
+  TowProfile()
+  {
+    m_interval  = 1;
+    m_last_post = -1;
+    m_peak_ms   = 0;
+    m_iters     = 0;
+    beginIteration();
+  }
+
+  // Seconds between posts (0 = never post)
+  void   setInterval(double s) { m_interval = (s > 0) ? s : 0; }
+  double getInterval() const   { return(m_interval); }
+
+  static Time now() { return(std::chrono::steady_clock::now()); }
+
+  void beginIteration()
+  {
+    for(int i = 0; i < TOW_PROF_PHASES; i++)
+      m_ms[i] = 0;
+    m_evals = 0;
+    m_steps = 0;
+    m_dists = 0;
+  }
+
+  // Add the time since t to phase p; returns the time now so the
+  // next phase can start from it
+  Time add(TowProfPhase p, Time t)
+  {
+    Time t_now = now();
+    std::chrono::duration<double, std::milli> ms = t_now - t;
+    m_ms[p] += ms.count();
+    return(t_now);
+  }
+
+  void count(unsigned long evals, unsigned long steps, unsigned long dists)
+  {
+    m_evals += evals;
+    m_steps += steps;
+    m_dists += dists;
+  }
+  void countDist(unsigned long dists) { m_dists += dists; }
+
+  double phaseMS(TowProfPhase p) const { return(m_ms[p]); }
+  double totalMS() const
+  {
+    double total = 0;
+    for(int i = 0; i < TOW_PROF_PHASES; i++)
+      total += m_ms[i];
+    return(total);
+  }
+  unsigned long evals() const       { return(m_evals); }
+  unsigned long simSteps() const    { return(m_steps); }
+  unsigned long distQueries() const { return(m_dists); }
+
+  //--------------------------------------------------------------
+  // info(): getDoubleInfo() values, keyed range_ms ... extract_ms,
+  // total_ms, evals, sim_steps and dist_queries. False if unknown.
+
+  bool info(const std::string& key, double& val) const
+  {
+    for(int i = 0; i < TOW_PROF_PHASES; i++) {
+      if(key == std::string(towProfPhaseName((TowProfPhase)i)) + "_ms") {
+        val = m_ms[i];
+        return(true);
+      }
+    }
+    if(key == "total_ms")          val = totalMS();
+    else if(key == "evals")        val = (double)m_evals;
+    else if(key == "sim_steps")    val = (double)m_steps;
+    else if(key == "dist_queries") val = (double)m_dists;
+    else
+      return(false);
+    return(true);
+  }
+
+  // Close the iteration; true if a report is due at time t_now (s)
+  bool endIteration(double t_now)
+  {
+    m_peak_ms = std::max(m_peak_ms, totalMS());
+    m_iters++;
+    if(m_interval <= 0)
+      return(false);
+    return((m_last_post < 0) || (t_now - m_last_post >= m_interval));
+  }
+
+  //--------------------------------------------------------------
+  // report(): this iteration's phases (ms), the slowest iteration
+  // and iterations since the last report, and the counts. Starts
+  // a new reporting interval at t_now.
+
+  std::string report(double t_now)
+  {
+    std::ostringstream os;
+    os.setf(std::ios::fixed);
+    os.precision(2);
+    for(int i = 0; i < TOW_PROF_PHASES; i++)
+      os << towProfPhaseName((TowProfPhase)i) << "=" << m_ms[i] << ",";
+    os << "total=" << totalMS() << ",peak_ms=" << m_peak_ms
+       << ",iters=" << m_iters << ",evals=" << m_evals
+       << ",steps=" << m_steps << ",dist=" << m_dists;
+
+    m_last_post = t_now;
+    m_peak_ms   = 0;
+    m_iters     = 0;
+    return(os.str());
+  }
+
+private:
+  double m_interval;
+  double m_last_post;
+  double m_peak_ms;
+  unsigned int m_iters;
+
+  double        m_ms[TOW_PROF_PHASES];
+  unsigned long m_evals;
+  unsigned long m_steps;
+  unsigned long m_dists;
+};
+
+#endif
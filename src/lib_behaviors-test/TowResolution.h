@@ -0,0 +1,119 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowResolution.h                                 */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Reflector resolution controller for the tow obstacle     */
+/* objective function. The uniform pieces are sized (in     */
+/* course and speed domain points) to hold the behavior's   */
+/* build time near a target, the uniform grid three pieces  */
+/* on a side as in the hand-tuned course:3,speed:3 and      */
+/* course:9,speed:9. Header-only, like TowFidelity.h.       */
+/*                                                          */
+/* Build time goes roughly with the number of pieces, so    */
+/* after each build the piece area is scaled by the ratio   */
+/* of measured to target time, square-rooted per side and   */
+/* damped by half, within a 10% deadband; pieces are made   */
+/* finer only when the time predicted for the rounded sizes */
+/* is inside the deadband. The target is scaled by          */
+/* relevance from half at zero to all of it at one, so      */
+/* resolution rises as the obstacle matters more.           */
+/************************************************************/
+
+#ifndef TOW_RESOLUTION_HEADER
+#define TOW_RESOLUTION_HEADER
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <sstream>
+
+class TowResolutionTuner {
+public:
+  TowResolutionTuner()
+  {
+    m_target_ms = 0;
+    m_crs_min = 2;  m_crs_max = 12;
+    m_spd_min = 1;  m_spd_max = 7;
+    m_crs = 3;
+    m_spd = 3;
+  }
+
+  // Build time to hold, ms (0 = off: course:3,speed:3 pieces)
+  void   setTarget(double ms) { m_target_ms = (ms > 0) ? ms : 0; }
+  double getTarget() const    { return(m_target_ms); }
+  bool   active() const       { return(m_target_ms > 0); }
+
+  // Piece sizes allowed, in domain points
+  void setCourseBounds(int lo, int hi)
+  { if((lo > 0) && (hi >= lo)) { m_crs_min = lo; m_crs_max = hi; } }
+  void setSpeedBounds(int lo, int hi)
+  { if((lo > 0) && (hi >= lo)) { m_spd_min = lo; m_spd_max = hi; } }
+
+  //--------------------------------------------------------------
+  // update(): Resize the pieces after a build of build_ms at the
+  // given relevance (0 to 1).
+
+  void update(double build_ms, double relevance)
+  {
+    if(!active() || !(build_ms > 0))
+      return;
+    relevance = std::min(1.0, std::max(0.0, relevance));
+    double target = m_target_ms * (0.5 + 0.5 * relevance);
+
+    double ratio = build_ms / target;
+    if(fabs(ratio - 1) < 0.1)
+      return;
+    ratio = std::min(2.0, std::max(0.5, ratio));
+    double side = pow(ratio, 0.25);
+    double crs = std::min((double)m_crs_max,
+                          std::max((double)m_crs_min, m_crs * side));
+    double spd = std::min((double)m_spd_max,
+                          std::max((double)m_spd_min, m_spd * side));
+
+    // Refine only if the rounded pieces are predicted to fit, else
+    // rounding makes it hunt between two sizes either side
+    if(ratio < 1) {
+      double now  = pieceCourse() * pieceSpeed();
+      double next = clampInt(crs, m_crs_min, m_crs_max) *
+        clampInt(spd, m_spd_min, m_spd_max);
+      if(build_ms * now / next > 1.1 * target)
+        return;
+    }
+    m_crs = crs;
+    m_spd = spd;
+  }
+
+  // Piece and grid sizes in domain points
+  int pieceCourse() const
+  { return(clampInt(m_crs, m_crs_min, m_crs_max)); }
+  int pieceSpeed() const
+  { return(clampInt(m_spd, m_spd_min, m_spd_max)); }
+
+  // Reflector uniform_piece and uniform_grid values
+  std::string pieceSpec() const
+  { return(spec(pieceCourse(), pieceSpeed())); }
+  std::string gridSpec() const
+  { return(spec(3 * pieceCourse(), 3 * pieceSpeed())); }
+
+private:
+  static int clampInt(double v, int lo, int hi)
+  { return(std::min(hi, std::max(lo, (int)floor(v + 0.5)))); }
+
+  static std::string spec(int crs, int spd)
+  {
+    std::ostringstream os;
+    os << "discrete@course:" << crs << ",speed:" << spd;
+    return(os.str());
+  }
+
+private:
+  double m_target_ms;
+  int    m_crs_min, m_crs_max;
+  int    m_spd_min, m_spd_max;
+  double m_crs;     // piece size, course points (continuous)
+  double m_spd;     // piece size, speed points
+};
+
+#endif
@@ -0,0 +1,292 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowSurrogate.cpp                                */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include "TowSurrogate.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char     SURR_MAGIC[8]  = {'T','O','W','S','U','R','R','\0'};
+const uint32_t SURR_VERSION   = 1;
+const uint32_t SURR_ENDIAN    = 0x01020304;
+
+// Process-wide table cache keyed on path, most recently used first
+typedef pair<string, shared_ptr<const TowSurrogate> > SurrEntry;
+
+const unsigned int MAX_CACHED_TABLES = 4;
+
+mutex            g_surr_mutex;
+list<SurrEntry>  g_surr_cache;
+
+bool sameParam(double a, double b)
+{
+  return(fabs(a - b) <= 1e-9 * (1 + fabs(a)));
+}
+
+}
+
+//---------------------------------------------------------------
+// Constructor()
+
+TowSurrogate::TowSurrogate()
+{
+  memset(&m_hdr, 0, sizeof(m_hdr));
+  m_map  = 0;
+  m_size = 0;
+  m_data = 0;
+  m_rec_stride = 0;
+}
+
+//---------------------------------------------------------------
+// Destructor()
+
+TowSurrogate::~TowSurrogate()
+{
+#ifndef _WIN32
+  if(m_map)
+    munmap(m_map, m_size);
+#endif
+}
+
+//---------------------------------------------------------------
+// Procedure: open()
+//   Purpose: Return the mapping for this path, mapping (and
+//            caching) it on first use.
+
+shared_ptr<const TowSurrogate> TowSurrogate::open(const string& path,
+                                                  string& err)
+{
+  lock_guard<mutex> lock(g_surr_mutex);
+
+  list<SurrEntry>::iterator p;
+  for(p = g_surr_cache.begin(); p != g_surr_cache.end(); p++) {
+    if(p->first == path) {
+      g_surr_cache.splice(g_surr_cache.begin(), g_surr_cache, p);
+      return(g_surr_cache.front().second);
+    }
+  }
+
+  shared_ptr<TowSurrogate> table(new TowSurrogate());
+  if(!table->map(path, err))
+    return(shared_ptr<const TowSurrogate>());
+
+  g_surr_cache.push_front(SurrEntry(path, table));
+  if(g_surr_cache.size() > MAX_CACHED_TABLES)
+    g_surr_cache.pop_back();
+  return(table);
+}
+
+//---------------------------------------------------------------
+// Procedure: map()
+//   Purpose: Map the file read-only and check the header against
+//            the file size.
+
+bool TowSurrogate::map(const string& path, string& err)
+{
+#ifdef _WIN32
+  err = "surrogate tables are not supported on this platform";
+  return(false);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0) {
+    err = "cannot open " + path;
+    return(false);
+  }
+  struct stat st;
+  if((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(m_hdr))) {
+    ::close(fd);
+    err = path + " is not a surrogate table";
+    return(false);
+  }
+
+  size_t size = (size_t)st.st_size;
+  void *addr = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(addr == MAP_FAILED) {
+    err = "cannot map " + path;
+    return(false);
+  }
+  m_map  = addr;
+  m_size = size;
+  memcpy(&m_hdr, addr, sizeof(m_hdr));
+
+  if((memcmp(m_hdr.magic, SURR_MAGIC, sizeof(SURR_MAGIC)) != 0) ||
+     (m_hdr.endian != SURR_ENDIAN)) {
+    err = path + " is not a surrogate table (or has other byte order)";
+    return(false);
+  }
+  if(m_hdr.version != SURR_VERSION) {
+    err = path + " has an unsupported table version";
+    return(false);
+  }
+  if((m_hdr.rec_floats != recFloats((int)m_hdr.num_nodes)) ||
+     (m_hdr.steps == 0) || (m_hdr.n_off < 2) || (m_hdr.n_spd < 2) ||
+     (m_hdr.n_v0 < 1) || !(m_hdr.spd_max > 0) || !(m_hdr.v0_max >= 0)) {
+    err = path + " has a malformed header";
+    return(false);
+  }
+
+  m_rec_stride = (size_t)m_hdr.steps * m_hdr.rec_floats;
+  size_t floats = (size_t)m_hdr.n_v0 * m_hdr.n_spd * m_hdr.n_off *
+    m_rec_stride;
+  if(size != sizeof(m_hdr) + floats * sizeof(float)) {
+    err = path + " is truncated";
+    return(false);
+  }
+  m_data = (const float*)((const char*)addr + sizeof(m_hdr));
+  return(true);
+#endif
+}
+
+//---------------------------------------------------------------
+// Procedure: write()
+
+bool TowSurrogate::write(const string& path, const TowSurrogateConfig& cfg,
+                         const TowSurrogateGrid& grid,
+                         const vector<float>& data, string& err)
+{
+  TowSurrogateHeader hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, SURR_MAGIC, sizeof(SURR_MAGIC));
+  hdr.version    = SURR_VERSION;
+  hdr.endian     = SURR_ENDIAN;
+  hdr.num_nodes  = (uint32_t)cfg.num_nodes;
+  hdr.steps      = (uint32_t)cfg.steps;
+  hdr.rec_floats = recFloats(cfg.num_nodes);
+  hdr.integrator = (uint32_t)cfg.integrator;
+  hdr.n_off      = grid.n_off;
+  hdr.n_spd      = grid.n_spd;
+  hdr.n_v0       = grid.n_v0;
+  hdr.sim_dt        = cfg.sim_dt;
+  hdr.turn_rate     = cfg.turn_rate;
+  hdr.cable_length  = cfg.cable_length;
+  hdr.attach_offset = cfg.attach_offset;
+  hdr.k_spring      = cfg.k_spring;
+  hdr.cd            = cfg.cd;
+  hdr.c_tan         = cfg.c_tan;
+  hdr.spd_max       = grid.spd_max;
+  hdr.v0_max        = grid.v0_max;
+
+  size_t floats = (size_t)grid.n_v0 * grid.n_spd * grid.n_off *
+    hdr.steps * hdr.rec_floats;
+  if(data.size() != floats) {
+    err = "table data does not match its grid";
+    return(false);
+  }
+
+  FILE *f = fopen(path.c_str(), "wb");
+  if(!f) {
+    err = "cannot write " + path;
+    return(false);
+  }
+  bool ok = (fwrite(&hdr, sizeof(hdr), 1, f) == 1);
+  if(ok && (floats > 0))
+    ok = (fwrite(&data[0], sizeof(float), floats, f) == floats);
+  if(fclose(f) != 0)
+    ok = false;
+  if(!ok)
+    err = "error writing " + path;
+  return(ok);
+}
+
+//---------------------------------------------------------------
+// Procedure: matches()
+//   Purpose: True if the table was generated for this config and
+//            covers at least cfg.steps sim steps.
+
+bool TowSurrogate::matches(const TowSurrogateConfig& cfg) const
+{
+  if(!m_data)
+    return(false);
+  if(((int)m_hdr.num_nodes != cfg.num_nodes) ||
+     ((int)m_hdr.steps < cfg.steps) ||
+     (m_hdr.integrator != (uint32_t)cfg.integrator))
+    return(false);
+
+  return(sameParam(m_hdr.sim_dt, cfg.sim_dt) &&
+         sameParam(m_hdr.turn_rate, cfg.turn_rate) &&
+         sameParam(m_hdr.cable_length, cfg.cable_length) &&
+         sameParam(m_hdr.attach_offset, cfg.attach_offset) &&
+         sameParam(m_hdr.k_spring, cfg.k_spring) &&
+         sameParam(m_hdr.cd, cfg.cd) &&
+         sameParam(m_hdr.c_tan, cfg.c_tan));
+}
+
+//---------------------------------------------------------------
+// Procedure: cell()
+//   Purpose: Trilinear corners of (crs_off, spd, v0). The course
+//            offset wraps; speed and v0 must lie in the table.
+//            Corners of zero weight are dropped.
+
+bool TowSurrogate::cell(double crs_off, double spd, double v0,
+                        TowSurrogateCell& c) const
+{
+  c.n = 0;
+  if(!m_data)
+    return(false);
+  if((spd < 0) || (spd > m_hdr.spd_max) || (v0 < 0) ||
+     (v0 > m_hdr.v0_max))
+    return(false);
+
+  // Course offset: n_off points around the circle
+  double fo = crs_off * (double)m_hdr.n_off / 360.0;
+  fo -= floor(fo / m_hdr.n_off) * m_hdr.n_off;
+  unsigned int o0 = (unsigned int)fo;
+  if(o0 >= m_hdr.n_off)
+    o0 = 0;
+  unsigned int o1 = (o0 + 1) % m_hdr.n_off;
+  double wo = fo - floor(fo);
+
+  // Speed and v0 clamped into the last cell
+  double fs = spd / m_hdr.spd_max * (m_hdr.n_spd - 1);
+  unsigned int s0 = std::min((unsigned int)fs, m_hdr.n_spd - 2);
+  double ws = fs - s0;
+
+  unsigned int v0_ix = 0, v1_ix = 0;
+  double wv = 0;
+  if((m_hdr.n_v0 > 1) && (m_hdr.v0_max > 0)) {
+    double fv = v0 / m_hdr.v0_max * (m_hdr.n_v0 - 1);
+    v0_ix = std::min((unsigned int)fv, m_hdr.n_v0 - 2);
+    v1_ix = v0_ix + 1;
+    wv = fv - v0_ix;
+  }
+
+  unsigned int oi[2] = {o0, o1};
+  unsigned int si[2] = {s0, s0 + 1};
+  unsigned int vi[2] = {v0_ix, v1_ix};
+  double ow[2] = {1 - wo, wo};
+  double sw[2] = {1 - ws, ws};
+  double vw[2] = {1 - wv, wv};
+  for(unsigned int a = 0; a < 2; a++) {
+    for(unsigned int b = 0; b < 2; b++) {
+      for(unsigned int d = 0; d < 2; d++) {
+        double w = vw[a] * sw[b] * ow[d];
+        if(w <= 0)
+          continue;
+        size_t ix = ((size_t)vi[a] * m_hdr.n_spd + si[b]) * m_hdr.n_off +
+          oi[d];
+        c.rec[c.n] = m_data + ix * m_rec_stride;
+        c.w[c.n]   = w;
+        c.n++;
+      }
+    }
+  }
+  return(c.n > 0);
+}
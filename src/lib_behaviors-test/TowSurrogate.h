@@ -0,0 +1,152 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowSurrogate.h                                  */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Precomputed tow response table, memory-mapped read-only. */
+/* The forward sim of AOF_TowObstacleAvoid is invariant to  */
+/* translation and rotation, so in the frame of the initial */
+/* ownship pose (x forward, y to port) the tow and cable    */
+/* trajectories depend only on the candidate's course       */
+/* offset from ownship heading, its speed, the initial tow  */
+/* state and the fixed config (cable, drag and damping      */
+/* params, turn rate, sim step, integrator).                */
+/*                                                          */
+/* The table is generated offline (app_tow_surrogate) for   */
+/* one config and a tow trailing taut, straight astern of   */
+/* the attach point at the cable length, at speed v0. Each  */
+/* record is one trajectory over a grid of                  */
+/*   course offset  [0,360) deg, wrapping                   */
+/*   speed          [0,spd_max]                             */
+/*   v0             [0,v0_max]                              */
+/* holding per sim step: tow x, y, vx, vy, then x, y of     */
+/* each interior cable node (floats), all relative to       */
+/* ownship's position and velocity at that step. These vary */
+/* far more smoothly across the grid than the absolute      */
+/* track. cell() returns the nonzero-weight corner records  */
+/* for trilinear blending.                                  */
+/*                                                          */
+/* File layout: TowSurrogateHeader, then records ordered    */
+/* [v0][speed][offset][step][field]. Tables are opened once */
+/* per path and shared process-wide, like PolySDFGrid. Not  */
+/* available on Windows: open() returns null there.         */
+/************************************************************/
+
+#ifndef TOW_SURROGATE_HEADER
+#define TOW_SURROGATE_HEADER
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "TowIntegrator.h"
+
+// Everything the trajectories depend on besides the grid axes.
+// matches() requires these to agree with the table's.
+struct TowSurrogateConfig {
+  int    num_nodes;
+  int    steps;           // table covers at least this many
+  TowIntegrator integrator;
+  double sim_dt;
+  double turn_rate;       // deg/s, 0 for instant turns
+  double cable_length;
+  double attach_offset;
+  double k_spring;
+  double cd;
+  double c_tan;
+
+  TowSurrogateConfig() : num_nodes(0), steps(0),
+    integrator(TOW_INT_EULER), sim_dt(0), turn_rate(0),
+    cable_length(0), attach_offset(0), k_spring(0), cd(0), c_tan(0) {}
+};
+
+struct TowSurrogateGrid {
+  unsigned int n_off;     // course offsets, 360/n_off deg apart
+  unsigned int n_spd;     // speeds over [0,spd_max]
+  double       spd_max;
+  unsigned int n_v0;      // initial tow speeds over [0,v0_max]
+  double       v0_max;
+
+  TowSurrogateGrid() : n_off(72), n_spd(13), spd_max(3),
+                       n_v0(7), v0_max(3) {}
+};
+
+// Corner records of one candidate and their blend weights
+struct TowSurrogateCell {
+  unsigned int n;
+  const float *rec[8];
+  double       w[8];
+};
+
+struct TowSurrogateHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t endian;        // 0x01020304 as written
+  uint32_t num_nodes;
+  uint32_t steps;
+  uint32_t rec_floats;
+  uint32_t integrator;
+  uint32_t n_off;
+  uint32_t n_spd;
+  uint32_t n_v0;
+  uint32_t reserved;
+  double   sim_dt;
+  double   turn_rate;
+  double   cable_length;
+  double   attach_offset;
+  double   k_spring;
+  double   cd;
+  double   c_tan;
+  double   spd_max;
+  double   v0_max;
+};
+
+class TowSurrogate {
+public:
+  ~TowSurrogate();
+
+  // Shared mapping of a table file. Returns null (and sets err) if
+  // the file cannot be mapped or is not a valid table.
+  static std::shared_ptr<const TowSurrogate> open(const std::string& path,
+                                                  std::string& err);
+
+  // Write a table. data holds n_v0*n_spd*n_off*steps*rec_floats
+  // floats in file order.
+  static bool write(const std::string& path, const TowSurrogateConfig& cfg,
+                    const TowSurrogateGrid& grid,
+                    const std::vector<float>& data, std::string& err);
+
+  static unsigned int recFloats(int num_nodes)
+  {return(4 + 2 * (unsigned int)std::max(0, num_nodes - 2));}
+
+  bool matches(const TowSurrogateConfig& cfg) const;
+
+  // Corners for a course offset (deg), speed and v0. False if
+  // speed or v0 is outside the table.
+  bool cell(double crs_off, double spd, double v0,
+            TowSurrogateCell& c) const;
+
+  unsigned int recFloats() const {return(m_hdr.rec_floats);}
+  unsigned int steps() const     {return(m_hdr.steps);}
+  double spdMax() const          {return(m_hdr.spd_max);}
+  double v0Max() const           {return(m_hdr.v0_max);}
+  size_t bytes() const           {return(m_size);}
+  const TowSurrogateHeader& header() const {return(m_hdr);}
+
+ private:
+  TowSurrogate();
+  TowSurrogate(const TowSurrogate&);
+  TowSurrogate& operator=(const TowSurrogate&);
+  bool   map(const std::string& path, std::string& err);
+
+ private:
+  TowSurrogateHeader m_hdr;
+  void        *m_map;
+  size_t       m_size;
+  const float *m_data;
+  size_t       m_rec_stride;   // floats per trajectory
+};
+
+#endif
@@ -0,0 +1,94 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowSurrogateGen.cpp                             */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include "TowSurrogateGen.h"
+#include "AOF_TowObstacleAvoid.h"
+#include "IvPDomain.h"
+#include "AngleUtils.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Procedure: towSurrogateGenerate()
+
+bool towSurrogateGenerate(TowSurrogateConfig& cfg, double horizon,
+                          const TowSurrogateGrid& grid,
+                          vector<float>& data, string& err)
+{
+  data.clear();
+  if((grid.n_off < 2) || (grid.n_spd < 2) || (grid.n_v0 < 1) ||
+     !(grid.spd_max > 0) || !(grid.v0_max >= 0)) {
+    err = "invalid table grid";
+    return(false);
+  }
+  if(!(cfg.cable_length > 0) || !(cfg.sim_dt > 0) || !(horizon > 0)) {
+    err = "cable length, sim step and horizon must be positive";
+    return(false);
+  }
+
+  IvPDomain domain;
+  domain.addDomain("course", 0, 359, 360);
+  domain.addDomain("speed", 0, grid.spd_max, grid.n_spd);
+
+  // Ownship at the origin heading 090: +x forward, +y to port. The
+  // obstacle is far enough away never to stop a trajectory.
+  ObShipModelV24 obm;
+  obm.setPose(0, 0, 90);
+  obm.setMinUtilCPA(1);
+  obm.setMaxUtilCPA(2);
+  obm.setAllowableTTC(horizon);
+  XYPolygon obs;
+  obs.add_vertex(1e5,     1e5);
+  obs.add_vertex(1e5 + 1, 1e5);
+  obs.add_vertex(1e5 + 1, 1e5 + 1);
+  obs.add_vertex(1e5,     1e5 + 1);
+  obm.setGutPoly(obs);
+  obm.setCachedVals(true);
+
+  AOF_TowObstacleAvoid aof(domain);
+  aof.setObShipModel(obm);
+  aof.setTowEval(true);
+  aof.setTowOnly(true);
+  aof.setTowDynParams(cfg.cable_length, cfg.attach_offset, cfg.k_spring,
+                      cfg.cd, cfg.c_tan);
+  aof.setSimParams(cfg.sim_dt, horizon, cfg.turn_rate);
+  aof.setUseCableDynamics(true);
+  aof.setReachPrune(false);
+  aof.setIntegrator(cfg.integrator);
+
+  vector<float> rec;
+  double tow_x = -cfg.attach_offset - cfg.cable_length;
+  for(unsigned int iv = 0; iv < grid.n_v0; iv++) {
+    double v0 = 0;
+    if(grid.n_v0 > 1)
+      v0 = grid.v0_max * iv / (grid.n_v0 - 1);
+    aof.setTowState(tow_x, 0, v0, 0);
+    if(!aof.initialize()) {
+      err = "AOF initialize() failed";
+      return(false);
+    }
+    if(data.empty()) {
+      cfg.num_nodes = aof.getCableNodes();
+      cfg.steps     = aof.getSimStepCount();
+      data.reserve((size_t)grid.n_v0 * grid.n_spd * grid.n_off *
+                   cfg.steps * TowSurrogate::recFloats(cfg.num_nodes));
+    }
+
+    for(unsigned int is = 0; is < grid.n_spd; is++) {
+      double spd = grid.spd_max * is / (grid.n_spd - 1);
+      for(unsigned int io = 0; io < grid.n_off; io++) {
+        double crs = angle360(90 + 360.0 * io / grid.n_off);
+        if(!aof.recordTrajectory(crs, spd, rec)) {
+          err = "trajectory stopped early";
+          return(false);
+        }
+        data.insert(data.end(), rec.begin(), rec.end());
+      }
+    }
+  }
+  return(true);
+}
@@ -0,0 +1,30 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowSurrogateGen.h                               */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Offline generation of TowSurrogate tables. Each record   */
+/* is produced by AOF_TowObstacleAvoid::recordTrajectory()  */
+/* with ownship at the origin heading 090 (so world and     */
+/* table frames coincide) and the tow taut astern at the    */
+/* record's v0, so the table reproduces the live sim at its */
+/* grid points. Used by app_tow_surrogate and the bench;    */
+/* not part of the behavior library.                        */
+/************************************************************/
+
+#ifndef TOW_SURROGATE_GEN_HEADER
+#define TOW_SURROGATE_GEN_HEADER
+
+#include <string>
+#include <vector>
+#include "TowSurrogate.h"
+
+// Tabulate trajectories over grid for cfg's params and a horizon
+// in seconds. Sets cfg.num_nodes and cfg.steps, and fills data in
+// TowSurrogate file order.
+bool towSurrogateGenerate(TowSurrogateConfig& cfg, double horizon,
+                          const TowSurrogateGrid& grid,
+                          std::vector<float>& data, std::string& err);
+
+#endif
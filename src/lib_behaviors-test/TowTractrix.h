@@ -0,0 +1,116 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowTractrix.h                                   */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Tractrix of a tow held at a fixed cable length L from an */
+/* anchor: the limit of the tow model when the cable is     */
+/* taut and the tow's motion across the cable is damped out */
+/* at once, so the tow only ever moves along the cable.     */
+/* Header-only, like TowIntegrator.h.                       */
+/*                                                          */
+/* With theta the angle from the anchor's track to the      */
+/* cable (tow to anchor), a straight anchor move of length  */
+/* s takes u = tan(theta/2) to u*exp(-s/L), and turning the */
+/* reference track by a takes theta to theta-a. Both are    */
+/* Mobius maps of u, so any run of identical steps (a       */
+/* straight leg, or a turn at a constant rate) is a power   */
+/* of one 2x2 matrix, which towMobiusPow() gives in closed  */
+/* form: O(1) per run instead of per sim step.              */
+/*                                                          */
+/* The model holds while |theta| < 90 deg. Past that the    */
+/* anchor closes on the tow and a real cable goes slack.    */
+/************************************************************/
+
+#ifndef TOW_TRACTRIX_HEADER
+#define TOW_TRACTRIX_HEADER
+
+#include <cmath>
+
+// u -> (a*u + b) / (c*u + d), kept at determinant 1
+struct TowMobius {
+  double a, b, c, d;
+};
+
+inline double towMobiusApply(const TowMobius& m, double u)
+{
+  return((m.a * u + m.b) / (m.c * u + m.d));
+}
+
+//----------------------------------------------------------------
+// towTractrixStep(): one sim step of the anchor. The reference
+// track first turns by dalpha (rad, counterclockwise), then the
+// anchor moves s along it, for a cable of length L.
+
+inline TowMobius towTractrixStep(double s, double L, double dalpha)
+{
+  double g  = exp(-0.5 * s / L);
+  double ch = cos(0.5 * dalpha);
+  double sh = sin(0.5 * dalpha);
+
+  TowMobius m;
+  m.a =  g * ch;
+  m.b = -g * sh;
+  m.c =  sh / g;
+  m.d =  ch / g;
+  return(m);
+}
+
+//----------------------------------------------------------------
+// towMobiusHalfTrace(): half the trace, sign-normalized. Above 1
+// the map has two fixed points and u moves monotonically toward
+// the attracting one; below 1 it rotates u by 2*acos() of it per
+// step and has no fixed point.
+
+inline double towMobiusHalfTrace(const TowMobius& m)
+{
+  return(0.5 * fabs(m.a + m.d));
+}
+
+//----------------------------------------------------------------
+// towMobiusPow(): m^n for n >= 0 by Cayley-Hamilton,
+//   m^n = U(n-1) m - U(n-2) I
+// with U the Chebyshev polynomials of the second kind at half the
+// trace, evaluated in closed form.
+
+inline TowMobius towMobiusPow(TowMobius m, int n)
+{
+  TowMobius r = {1, 0, 0, 1};
+  if(n <= 0)
+    return(r);
+  if(n == 1)
+    return(m);
+
+  // Same map with a non-negative trace
+  if(m.a + m.d < 0) {
+    m.a = -m.a;  m.b = -m.b;
+    m.c = -m.c;  m.d = -m.d;
+  }
+
+  double x = 0.5 * (m.a + m.d);
+  double u1 = n;          // U(n-1)
+  double u2 = n - 1;      // U(n-2)
+  if(x > 1) {
+    double phi = acosh(x);
+    if(phi > 0) {
+      u1 = sinh(n * phi) / sinh(phi);
+      u2 = sinh((n - 1) * phi) / sinh(phi);
+    }
+  }
+  else if(x < 1) {
+    double phi = acos(x);
+    if(phi > 0) {
+      u1 = sin(n * phi) / sin(phi);
+      u2 = sin((n - 1) * phi) / sin(phi);
+    }
+  }
+
+  r.a = u1 * m.a - u2;
+  r.b = u1 * m.b;
+  r.c = u1 * m.c;
+  r.d = u1 * m.d - u2;
+  return(r);
+}
+
+#endif
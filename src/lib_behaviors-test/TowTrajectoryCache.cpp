@@ -0,0 +1,246 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowTrajectoryCache.cpp                          */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <list>
+#include "TowTrajectoryCache.h"
+
+using namespace std;
+
+namespace {
+
+// Process-wide sets, most recently used first. Several builds can
+// be live in one iteration (anytime levels have their own steps).
+struct TrajEntry {
+  string key;
+  double stamp;
+  shared_ptr<TowTrajectorySet> set;
+};
+
+mutex            g_traj_mutex;
+list<TrajEntry>  g_traj_sets;
+unsigned long    g_traj_hits   = 0;
+unsigned long    g_traj_misses = 0;
+
+}
+
+//---------------------------------------------------------------
+// Constructor()
+
+TowTrajectorySet::TowTrajectorySet(unsigned int num_cands, int steps,
+                                   int interval, unsigned int pts,
+                                   size_t max_bytes)
+{
+  m_steps    = (steps > 0) ? steps : 0;
+  m_interval = (interval > 0) ? interval : 1;
+  m_checks   = (m_steps + m_interval - 1) / m_interval;
+  m_pts      = pts;
+  m_block    = blockFloats(steps, interval, pts);
+
+  m_capacity = 0;
+  if(m_block > 0) {
+    size_t fit = max_bytes / (m_block * sizeof(float));
+    m_capacity = (fit < num_cands) ? (unsigned int)fit : num_cands;
+  }
+
+  m_slot.assign(num_cands, -1);
+  m_ready.assign(num_cands, 0);
+  m_blocks.reserve(m_capacity);
+}
+
+//---------------------------------------------------------------
+// Procedure: blockFloats()
+//   Purpose: Floats per candidate: tow x, y and speed per step,
+//            and x and y of the points at every check step.
+
+size_t TowTrajectorySet::blockFloats(int steps, int interval,
+                                     unsigned int pts)
+{
+  if(steps <= 0)
+    return(0);
+  if(interval <= 0)
+    interval = 1;
+  size_t checks = (steps + interval - 1) / interval;
+  return((size_t)steps * 3 + checks * pts * 2);
+}
+
+//---------------------------------------------------------------
+// Procedure: viewOf()
+//   Purpose: Pointers into a block: tow x, y and speed per step,
+//            then check-step x and y.
+
+TowTrajView TowTrajectorySet::viewOf(float *b) const
+{
+  size_t n = (size_t)m_checks * m_pts;
+
+  TowTrajView v;
+  v.tx  = b;
+  v.ty  = b + m_steps;
+  v.spd = b + 2 * (size_t)m_steps;
+  v.cx  = b + 3 * (size_t)m_steps;
+  v.cy  = v.cx + n;
+  return(v);
+}
+
+//---------------------------------------------------------------
+// Procedure: find()
+
+bool TowTrajectorySet::find(unsigned int c, TowTrajView& v) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  if((c >= m_slot.size()) || !m_ready[c])
+    return(false);
+  v = viewOf(&m_blocks[m_slot[c]][0]);
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: reserve()
+//   Purpose: Hand out a block for a candidate. Blocks are
+//            allocated one at a time and never move, so pointers
+//            stay valid while the set is held.
+
+bool TowTrajectorySet::reserve(unsigned int c, TowTrajView& v)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if((c >= m_slot.size()) || (m_slot[c] >= 0))
+    return(false);
+  if(m_blocks.size() >= m_capacity)
+    return(false);
+
+  m_slot[c] = m_blocks.size();
+  m_blocks.push_back(vector<float>(m_block, 0));
+  v = viewOf(&m_blocks[m_slot[c]][0]);
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: commit()
+
+void TowTrajectorySet::commit(unsigned int c)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if((c < m_slot.size()) && (m_slot[c] >= 0))
+    m_ready[c] = 1;
+}
+
+//---------------------------------------------------------------
+// Procedure: bytes()
+
+size_t TowTrajectorySet::bytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return(m_blocks.size() * m_block * sizeof(float));
+}
+
+//---------------------------------------------------------------
+// Procedure: budget()
+//   Purpose: Bytes the set may grow to, fixed at construction.
+
+size_t TowTrajectorySet::budget() const
+{
+  return((size_t)m_capacity * m_block * sizeof(float));
+}
+
+//---------------------------------------------------------------
+// Procedure: get()
+//   Purpose: Find or create the set for key. A new set first drops
+//            the sets of earlier iterations, then the least
+//            recently used ones until its full size fits in
+//            max_bytes with the budgets of the sets kept.
+
+shared_ptr<TowTrajectorySet> TowTrajectoryCache::get(const string& key,
+                                                     double stamp,
+                                                     unsigned int num_cands,
+                                                     int steps, int interval,
+                                                     unsigned int pts,
+                                                     size_t max_bytes)
+{
+  lock_guard<mutex> lock(g_traj_mutex);
+
+  list<TrajEntry>::iterator p;
+  for(p = g_traj_sets.begin(); p != g_traj_sets.end(); p++) {
+    if(p->key == key) {
+      g_traj_sets.splice(g_traj_sets.begin(), g_traj_sets, p);
+      return(g_traj_sets.front().set);
+    }
+  }
+
+  p = g_traj_sets.begin();
+  while(p != g_traj_sets.end()) {
+    if(p->stamp < stamp)
+      p = g_traj_sets.erase(p);
+    else
+      p++;
+  }
+
+  size_t need = TowTrajectorySet::blockFloats(steps, interval, pts);
+  need *= sizeof(float) * num_cands;
+  if(need > max_bytes)
+    need = max_bytes;
+
+  size_t held = 0;
+  for(p = g_traj_sets.begin(); p != g_traj_sets.end(); p++)
+    held += p->set->budget();
+  while(!g_traj_sets.empty() && (held + need > max_bytes)) {
+    held -= g_traj_sets.back().set->budget();
+    g_traj_sets.pop_back();
+  }
+
+  TrajEntry entry;
+  entry.key   = key;
+  entry.stamp = stamp;
+  entry.set.reset(new TowTrajectorySet(num_cands, steps, interval, pts,
+                                       max_bytes - held));
+  g_traj_sets.push_front(entry);
+  return(entry.set);
+}
+
+//---------------------------------------------------------------
+// Procedures: countHit(), countMiss()
+
+void TowTrajectoryCache::countHit()
+{
+  lock_guard<mutex> lock(g_traj_mutex);
+  g_traj_hits++;
+}
+
+void TowTrajectoryCache::countMiss()
+{
+  lock_guard<mutex> lock(g_traj_mutex);
+  g_traj_misses++;
+}
+
+//---------------------------------------------------------------
+// Procedures: cacheHits(), cacheMisses(), cacheSets(), cacheBytes()
+
+unsigned long TowTrajectoryCache::cacheHits()
+{
+  lock_guard<mutex> lock(g_traj_mutex);
+  return(g_traj_hits);
+}
+
+unsigned long TowTrajectoryCache::cacheMisses()
+{
+  lock_guard<mutex> lock(g_traj_mutex);
+  return(g_traj_misses);
+}
+
+unsigned int TowTrajectoryCache::cacheSets()
+{
+  lock_guard<mutex> lock(g_traj_mutex);
+  return(g_traj_sets.size());
+}
+
+size_t TowTrajectoryCache::cacheBytes()
+{
+  lock_guard<mutex> lock(g_traj_mutex);
+  size_t total = 0;
+  list<TrajEntry>::const_iterator p;
+  for(p = g_traj_sets.begin(); p != g_traj_sets.end(); p++)
+    total += p->set->bytes();
+  return(total);
+}
@@ -0,0 +1,109 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowTrajectoryCache.h                            */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Process-wide cache of forward-simulated tow trajectories */
+/* shared by the BHV_TowObstacleAvoid instances the helm    */
+/* spawns, one per obstacle. Their forward sims differ only */
+/* in the obstacle, which the sim never feeds back into the */
+/* dynamics, so in one helm iteration each candidate's      */
+/* trajectory is simulated by the first instance to need    */
+/* it and the others run only their range checks over it.   */
+/*                                                          */
+/* A TowTrajectorySet holds one iteration's trajectories,   */
+/* keyed by the helm time and everything the dynamics       */
+/* depend on (see AOF_TowObstacleTrajCache.cpp). For each   */
+/* candidate it stores, as floats relative to an origin     */
+/* near ownship in structure-of-arrays form, what the range */
+/* checks read: the tow position and speed at every step,   */
+/* and at every cable check step the cable nodes from       */
+/* cable_start_node to the tow (the anchor alone for the    */
+/* relaxed cable, which is rebuilt from it and the tow).    */
+/*                                                          */
+/* Memory is bounded: the sets kept share one byte budget.  */
+/* A new set drops the sets of earlier iterations, then the */
+/* least recently used ones until it fits. A set takes      */
+/* candidates until its share is used, later ones are       */
+/* recorded into the AOF's own scratch (so a utility does   */
+/* not depend on whether its candidate found room). All     */
+/* calls are thread-safe.                                   */
+/************************************************************/
+
+#ifndef TOW_TRAJECTORY_CACHE_HEADER
+#define TOW_TRAJECTORY_CACHE_HEADER
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One candidate's record. Check step i (sim step i*interval) has
+// its points at cx/cy[i*pts ...].
+struct TowTrajView {
+  float *tx, *ty, *spd;     // per sim step
+  float *cx, *cy;           // per check step
+};
+
+class TowTrajectorySet {
+public:
+  TowTrajectorySet(unsigned int num_cands, int steps, int interval,
+                   unsigned int pts, size_t max_bytes);
+  ~TowTrajectorySet() {}
+
+  // Record of candidate c, false if not cached
+  bool   find(unsigned int c, TowTrajView& v) const;
+
+  // Storage for candidate c, false if the set is full or c is
+  // cached or being filled. Call commit() once filled.
+  bool   reserve(unsigned int c, TowTrajView& v);
+  void   commit(unsigned int c);
+
+  // A record laid out in a caller's buffer of blockFloats()
+  TowTrajView  viewOf(float *block) const;
+  size_t       blockFloats() const {return(m_block);}
+  static size_t blockFloats(int steps, int interval, unsigned int pts);
+
+  int          steps() const    {return(m_steps);}
+  int          interval() const {return(m_interval);}
+  unsigned int points() const   {return(m_pts);}
+  size_t       bytes() const;
+  size_t       budget() const;
+
+ private:
+  mutable std::mutex m_mutex;
+
+  int           m_steps;
+  int           m_interval;   // sim steps per cable check
+  int           m_checks;     // check steps over the horizon
+  unsigned int  m_pts;        // points per check step
+  size_t        m_block;      // floats per candidate
+  unsigned int  m_capacity;   // candidates within the budget
+
+  std::vector<int>           m_slot;   // block per candidate, -1 none
+  std::vector<unsigned char> m_ready;
+  mutable std::vector<std::vector<float> > m_blocks;
+};
+
+class TowTrajectoryCache {
+public:
+  // The set for key, created if absent. Sets stamped before stamp
+  // are then dropped, and all sets kept fit in max_bytes.
+  static std::shared_ptr<TowTrajectorySet> get(const std::string& key,
+                                               double stamp,
+                                               unsigned int num_cands,
+                                               int steps, int interval,
+                                               unsigned int pts,
+                                               size_t max_bytes);
+
+  // Statistics over all sets
+  static void countHit();
+  static void countMiss();
+  static unsigned long cacheHits();
+  static unsigned long cacheMisses();
+  static unsigned int  cacheSets();
+  static size_t        cacheBytes();
+};
+
+#endif
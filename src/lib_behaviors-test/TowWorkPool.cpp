@@ -0,0 +1,184 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowWorkPool.cpp                                 */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include <algorithm>
+#include "TowWorkPool.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Constructor()
+
+TowWorkPool::TowWorkPool(unsigned int workers) :
+  m_workers(workers ? workers : max(1u, thread::hardware_concurrency())),
+  m_ranges(m_workers)
+{
+  m_generation = 0;
+  m_busy       = 0;
+  m_quit       = false;
+  m_task       = 0;
+  m_steals     = 0;
+
+  for(unsigned int w = 0; w < m_workers; w++) {
+    m_ranges[w].lo = 0;
+    m_ranges[w].hi = 0;
+  }
+  for(unsigned int w = 1; w < m_workers; w++)
+    m_threads.push_back(thread(&TowWorkPool::threadLoop, this, w));
+}
+
+//---------------------------------------------------------------
+// Destructor()
+
+TowWorkPool::~TowWorkPool()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_start_cv.notify_all();
+  for(unsigned int i = 0; i < m_threads.size(); i++)
+    m_threads[i].join();
+}
+
+//---------------------------------------------------------------
+// Procedure: run()
+
+void TowWorkPool::run(unsigned int n, TowWorkTask& task)
+{
+  if(n == 0)
+    return;
+
+  m_task = &task;
+  for(unsigned int w = 0; w < m_workers; w++) {
+    lock_guard<mutex> lock(m_ranges[w].mutex);
+    m_ranges[w].lo = (unsigned int)((unsigned long)n * w / m_workers);
+    m_ranges[w].hi = (unsigned int)((unsigned long)n * (w+1) / m_workers);
+  }
+
+  if(m_workers == 1) {
+    work(0);
+    return;
+  }
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_busy = m_workers - 1;
+    m_generation++;
+  }
+  m_start_cv.notify_all();
+
+  work(0);
+
+  unique_lock<mutex> lock(m_mutex);
+  while(m_busy > 0)
+    m_done_cv.wait(lock);
+}
+
+//---------------------------------------------------------------
+// Procedure: threadLoop()
+//   Purpose: Helper thread body: wait for a run, work until no
+//            index is left anywhere, report done.
+
+void TowWorkPool::threadLoop(unsigned int worker)
+{
+  unsigned long seen = 0;
+  while(true) {
+    {
+      unique_lock<mutex> lock(m_mutex);
+      while(!m_quit && (m_generation == seen))
+        m_start_cv.wait(lock);
+      if(m_quit)
+        return;
+      seen = m_generation;
+    }
+
+    work(worker);
+
+    lock_guard<mutex> lock(m_mutex);
+    m_busy--;
+    if(m_busy == 0)
+      m_done_cv.notify_all();
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: work()
+
+void TowWorkPool::work(unsigned int worker)
+{
+  unsigned int ix = 0;
+  while(next(worker, ix))
+    (*m_task)(ix, worker);
+}
+
+//---------------------------------------------------------------
+// Procedure: next()
+//   Purpose: Front index of the worker's own range, stealing when
+//            it is empty. False once every range is empty.
+
+bool TowWorkPool::next(unsigned int worker, unsigned int& ix)
+{
+  while(true) {
+    {
+      Range& own = m_ranges[worker];
+      lock_guard<mutex> lock(own.mutex);
+      if(own.lo < own.hi) {
+        ix = own.lo++;
+        return(true);
+      }
+    }
+    if(!steal(worker))
+      return(false);
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: steal()
+//   Purpose: Move the back half of the largest other range into
+//            the worker's own. Only one range lock is held at a
+//            time; a victim that shrank meanwhile is retried.
+
+bool TowWorkPool::steal(unsigned int worker)
+{
+  while(true) {
+    unsigned int victim = worker;
+    unsigned int most   = 0;
+    for(unsigned int w = 0; w < m_workers; w++) {
+      if(w == worker)
+        continue;
+      lock_guard<mutex> lock(m_ranges[w].mutex);
+      unsigned int left = m_ranges[w].hi - m_ranges[w].lo;
+      if(left > most) {
+        most   = left;
+        victim = w;
+      }
+    }
+    if(most == 0)
+      return(false);
+
+    unsigned int lo = 0, hi = 0;
+    {
+      Range& r = m_ranges[victim];
+      lock_guard<mutex> lock(r.mutex);
+      if(r.lo < r.hi) {
+        hi   = r.hi;
+        lo   = r.lo + (r.hi - r.lo) / 2;
+        r.hi = lo;
+      }
+    }
+    if(lo == hi)
+      continue;
+
+    Range& own = m_ranges[worker];
+    lock_guard<mutex> lock(own.mutex);
+    own.lo = lo;
+    own.hi = hi;
+    m_steals++;
+    return(true);
+  }
+}
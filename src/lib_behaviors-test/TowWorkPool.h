@@ -0,0 +1,79 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowWorkPool.h                                   */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Small work-stealing thread pool for the parallel build   */
+/* of BHV_TowObstacleAvoid. run() splits n task indices     */
+/* into one contiguous range per worker; a worker takes     */
+/* indices from the front of its own range and, once it is  */
+/* empty, steals the back half of the largest range left.   */
+/* The calling thread is worker 0, so a pool of size 1 runs */
+/* everything inline with no threads started.               */
+/*                                                          */
+/* Which worker runs an index varies from run to run, so    */
+/* tasks must write only their own index's results and give */
+/* the same result on any worker for the output to be       */
+/* deterministic.                                           */
+/************************************************************/
+
+#ifndef TOW_WORK_POOL_HEADER
+#define TOW_WORK_POOL_HEADER
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TowWorkTask {
+public:
+  virtual ~TowWorkTask() {}
+  virtual void operator()(unsigned int ix, unsigned int worker) = 0;
+};
+
+class TowWorkPool {
+public:
+  // Number of workers, 0 for one per hardware thread
+  TowWorkPool(unsigned int workers);
+  ~TowWorkPool();
+
+  // Run task(ix, worker) for ix in [0, n), returning when all are
+  // done. Not reentrant: one run at a time per pool.
+  void run(unsigned int n, TowWorkTask& task);
+
+  unsigned int  size() const   {return(m_workers);}
+  unsigned long steals() const {return(m_steals);}
+
+private:
+  // One worker's remaining indices [lo, hi)
+  struct Range {
+    std::mutex   mutex;
+    unsigned int lo;
+    unsigned int hi;
+  };
+
+  void threadLoop(unsigned int worker);
+  void work(unsigned int worker);
+  bool next(unsigned int worker, unsigned int& ix);
+  bool steal(unsigned int worker);
+
+private:
+  unsigned int m_workers;
+
+  std::vector<std::thread> m_threads;
+  std::vector<Range>       m_ranges;
+
+  std::mutex              m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  unsigned long           m_generation;  // bumped per run()
+  unsigned int            m_busy;        // helper threads still working
+  bool                    m_quit;
+
+  TowWorkTask  *m_task;
+  std::atomic<unsigned long> m_steals;   // since construction
+};
+
+#endif
@@ -0,0 +1,71 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowCableKernel.cpp                              */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include "TowCableKernel.h"
+
+namespace {
+
+template<typename T>
+struct TowCableKernelEntry {
+  typename TowCableFns<T>::Step  step;
+  typename TowCableFns<T>::Relax relax;
+};
+
+// Step entries up to TOW_CABLE_STEP_MAX_N only, where the fixed
+// step beats towCableStepN()
+#define TOW_CABLE_STEP_ENTRY(T, n) {&towCableStep<T, n>, &towCableRelax<T, n>}
+#define TOW_CABLE_ENTRY(T, n) {0, &towCableRelax<T, n>}
+#define TOW_CABLE_TABLE(T)                                             \
+  TOW_CABLE_STEP_ENTRY(T, 3), TOW_CABLE_ENTRY(T, 4), TOW_CABLE_ENTRY(T, 5), \
+  TOW_CABLE_ENTRY(T, 6),  TOW_CABLE_ENTRY(T, 7),  TOW_CABLE_ENTRY(T, 8),  \
+  TOW_CABLE_ENTRY(T, 9),  TOW_CABLE_ENTRY(T, 10), TOW_CABLE_ENTRY(T, 11), \
+  TOW_CABLE_ENTRY(T, 12), TOW_CABLE_ENTRY(T, 13), TOW_CABLE_ENTRY(T, 14), \
+  TOW_CABLE_ENTRY(T, 15), TOW_CABLE_ENTRY(T, 16)
+
+// Indexed by num_nodes - TOW_CABLE_MIN_N
+const TowCableKernelEntry<double> g_cable_kernels_d[] = {
+  TOW_CABLE_TABLE(double)
+};
+const TowCableKernelEntry<float> g_cable_kernels_f[] = {
+  TOW_CABLE_TABLE(float)
+};
+
+#undef TOW_CABLE_TABLE
+#undef TOW_CABLE_ENTRY
+#undef TOW_CABLE_STEP_ENTRY
+
+template<typename T>
+bool lookupKernels(const TowCableKernelEntry<T> *table, int num_nodes,
+                   typename TowCableFns<T>::Step& step,
+                   typename TowCableFns<T>::Relax& relax)
+{
+  if((num_nodes < TOW_CABLE_MIN_N) || (num_nodes > TOW_CABLE_MAX_N)) {
+    step  = 0;
+    relax = 0;
+    return(false);
+  }
+  step  = table[num_nodes - TOW_CABLE_MIN_N].step;
+  relax = table[num_nodes - TOW_CABLE_MIN_N].relax;
+  return(true);
+}
+
+}
+
+//----------------------------------------------------------------
+// Procedure: towCableKernels()
+
+bool towCableKernels(int num_nodes, TowCableFns<double>::Step& step,
+                     TowCableFns<double>::Relax& relax)
+{
+  return(lookupKernels(g_cable_kernels_d, num_nodes, step, relax));
+}
+
+bool towCableKernels(int num_nodes, TowCableFns<float>::Step& step,
+                     TowCableFns<float>::Relax& relax)
+{
+  return(lookupKernels(g_cable_kernels_f, num_nodes, step, relax));
+}
@@ -0,0 +1,431 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowCableKernel.h                                */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* The tow body and cable model shared by pTowing, pCable,  */
+/* the AOF forward simulation and the behavior: Euler step  */
+/* of the tow body, Euler step of the cable's interior      */
+/* nodes, the rigid constraint passes, the position-only    */
+/* relaxation and the node-count rule. Templated on the     */
+/* scalar type (T = float serves the AOF's float mode).     */
+/*                                                          */
+/* The node count follows from the cable length (3 under    */
+/* 30 m, else length/10), so only a handful of values       */
+/* occur. For N in [TOW_CABLE_MIN_N, TOW_CABLE_MAX_N] the   */
+/* relaxation also comes specialized, on fixed-size stack   */
+/* arrays with compile-time loop bounds so the passes       */
+/* unroll; towCableKernels() looks it up. The step is       */
+/* specialized only up to TOW_CABLE_STEP_MAX_N, the node    */
+/* counts where it was measured faster than the runtime-n   */
+/* step (10-40% for the relaxation at every N, the step     */
+/* only at N = 3; slower at 5 to 10). The runtime-n forms   */
+/* run the same node routines in the same order on the      */
+/* caller's arrays, so the two are bit-identical.           */
+/* TowDynamics.h adds the other integrators.                */
+/************************************************************/
+
+#ifndef TOW_CABLE_KERNEL_HEADER
+#define TOW_CABLE_KERNEL_HEADER
+
+#include <algorithm>
+#include "TowSimd.h"
+
+#define TOW_CABLE_MIN_N 3
+#define TOW_CABLE_MAX_N 16
+#define TOW_CABLE_STEP_MAX_N 3
+
+// Loop unrolling hint for the fixed-bound loops below
+#if defined(__clang__)
+#define TOW_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && (__GNUC__ >= 8)
+#define TOW_UNROLL _Pragma("GCC unroll 16")
+#else
+#define TOW_UNROLL
+#endif
+
+// Node routines are forced inline so the fixed-N kernels keep
+// their compile-time bounds
+#if defined(__GNUC__) || defined(__clang__)
+#define TOW_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define TOW_FORCE_INLINE inline
+#endif
+
+template<typename T>
+struct TowCableParamsT {
+  T k_spring;
+  T cd;
+  T c_tan;
+  T rest_length;     // per cable segment
+  T cable_length;    // anchor to tow body
+};
+
+template<typename T>
+struct TowCableFns {
+  typedef void (*Step)(const TowCableParamsT<T>& p,
+                       T ax, T ay, T tx, T ty, T dt,
+                       T *nx, T *ny, T *nvx, T *nvy);
+  typedef void (*Relax)(T rest_length, T ax, T ay, T tx, T ty,
+                        T *nx, T *ny);
+};
+
+//----------------------------------------------------------------
+// towCableNodes(): node count for a cable of the given length,
+// the anchor and tow body included
+
+inline int towCableNodes(double cable_length)
+{
+  if(cable_length < 30.0)
+    return(3);
+  return(std::max(3, (int)(cable_length / 10.0)));
+}
+
+typedef TowCableParamsT<double>     TowCableParams;
+typedef TowCableFns<double>::Step   TowCableStepFn;
+typedef TowCableFns<double>::Relax  TowCableRelaxFn;
+
+// Kernels for num_nodes, or false (and nulls) if not specialized.
+// The step is null past TOW_CABLE_STEP_MAX_N: use towCableStepN()
+bool towCableKernels(int num_nodes, TowCableFns<double>::Step& step,
+                     TowCableFns<double>::Relax& relax);
+bool towCableKernels(int num_nodes, TowCableFns<float>::Step& step,
+                     TowCableFns<float>::Relax& relax);
+
+//----------------------------------------------------------------
+// towClampToCable<T>(): rigid cable clamp. Project the tow back
+// onto the cable radius and remove outward radial velocity.
+
+template<typename T>
+void towClampToCable(T cable_length, T ax, T ay, T& tx, T& ty,
+                     T& tvx, T& tvy)
+{
+  T sx = ax - tx;
+  T sy = ay - ty;
+  T dist_a = towHypot(sx, sy);
+
+  if((dist_a > cable_length) && (dist_a > T(1e-9))) {
+    T sc = cable_length / dist_a;
+    tx = ax - sx * sc;
+    ty = ay - sy * sc;
+
+    // Remove outward radial velocity component
+    T urx = sx / dist_a;
+    T ury = sy / dist_a;
+    T vrad = tvx * urx + tvy * ury;
+    if(vrad < 0) {
+      tvx -= vrad * urx;
+      tvy -= vrad * ury;
+    }
+  }
+}
+
+//----------------------------------------------------------------
+// towBodyStep<T>(): one Euler step of the tow body toward the
+// anchor (ax,ay): spring when overstretched, quadratic drag,
+// tangential damping, then the rigid clamp. Requires
+// cable_length > 0 and dt already clamped.
+
+template<typename T>
+void towBodyStep(const TowCableParamsT<T>& p, T ax, T ay, T dt,
+                 T& tx, T& ty, T& tvx, T& tvy)
+{
+  // Vector from tow body to anchor point
+  T dx = ax - tx;
+  T dy = ay - ty;
+  T distance = towHypot(dx, dy);
+
+  // If tow is essentially co-located with anchor, apply drag only
+  if(distance <= T(0.01)) {
+    T spd = towHypot(tvx, tvy);
+    if((spd > T(1e-6)) && (p.cd > 0)) {
+      tvx += -p.cd * tvx * spd * dt;
+      tvy += -p.cd * tvy * spd * dt;
+    }
+    tx += tvx * dt;
+    ty += tvy * dt;
+    return;
+  }
+
+  // Unit vector along cable (tow -> anchor)
+  T d_dir = towHypot(dx, dy);
+  if(d_dir < T(1e-6))
+    d_dir = 1;
+  T ux = dx / d_dir;
+  T uy = dy / d_dir;
+
+  // Tangential unit vector (perpendicular to cable)
+  T nx = -uy;
+  T ny =  ux;
+
+  // Spring tension when cable is overstretched
+  if((distance > p.cable_length) && (p.k_spring > 0)) {
+    T overshoot = distance - p.cable_length;
+    tvx += p.k_spring * overshoot * ux * dt;
+    tvy += p.k_spring * overshoot * uy * dt;
+  }
+
+  // Quadratic drag
+  T speed = towHypot(tvx, tvy);
+  if((speed > T(1e-6)) && (p.cd > 0)) {
+    tvx += -p.cd * tvx * speed * dt;
+    tvy += -p.cd * tvy * speed * dt;
+  }
+
+  // Tangential damping (penalizes sideways motion)
+  if(p.c_tan > 0) {
+    T vt = tvx * nx + tvy * ny;
+    tvx += (-p.c_tan * vt) * nx * dt;
+    tvy += (-p.c_tan * vt) * ny * dt;
+  }
+
+  // Euler position integration
+  tx += tvx * dt;
+  ty += tvy * dt;
+
+  towClampToCable(p.cable_length, ax, ay, tx, ty, tvx, tvy);
+}
+
+//----------------------------------------------------------------
+// towCableNodeEuler<T>(): one Euler step of interior node i, its
+// neighbors where the sweep has left them: springs to both when
+// overstretched, quadratic drag, damping across the neighbor to
+// neighbor direction, then position.
+
+template<typename T>
+TOW_FORCE_INLINE void towCableNodeEuler(const TowCableParamsT<T>& p, T dt,
+                                        int i, T *x, T *y, T *vx, T *vy)
+{
+  const T k = p.k_spring;
+  const T rest_length = p.rest_length;
+
+  T dx_prev = x[i-1] - x[i];
+  T dy_prev = y[i-1] - y[i];
+  T dist_prev = towHypot(dx_prev, dy_prev);
+  if(dist_prev > T(0.01) && dist_prev > rest_length && k > 0) {
+    T ux = dx_prev / dist_prev;
+    T uy = dy_prev / dist_prev;
+    T overshoot = dist_prev - rest_length;
+    vx[i] += k * overshoot * ux * dt;
+    vy[i] += k * overshoot * uy * dt;
+  }
+
+  T dx_next = x[i+1] - x[i];
+  T dy_next = y[i+1] - y[i];
+  T dist_next = towHypot(dx_next, dy_next);
+  if(dist_next > T(0.01) && dist_next > rest_length && k > 0) {
+    T ux = dx_next / dist_next;
+    T uy = dy_next / dist_next;
+    T overshoot = dist_next - rest_length;
+    vx[i] += k * overshoot * ux * dt;
+    vy[i] += k * overshoot * uy * dt;
+  }
+
+  T speed = towHypot(vx[i], vy[i]);
+  if(speed > T(1e-6) && p.cd > 0) {
+    vx[i] += -p.cd * vx[i] * speed * dt;
+    vy[i] += -p.cd * vy[i] * speed * dt;
+  }
+
+  if(p.c_tan > 0) {
+    T cx   = x[i+1] - x[i-1];
+    T cy   = y[i+1] - y[i-1];
+    T clen = towHypot(cx, cy);
+    if(clen > T(1e-6)) {
+      T utx = cx / clen;
+      T uty = cy / clen;
+      T perpx = -uty;
+      T perpy =  utx;
+      T vn = vx[i] * perpx + vy[i] * perpy;
+      vx[i] += (-p.c_tan * vn) * perpx * dt;
+      vy[i] += (-p.c_tan * vn) * perpy * dt;
+    }
+  }
+
+  x[i] += vx[i] * dt;
+  y[i] += vy[i] * dt;
+}
+
+//----------------------------------------------------------------
+// towCableConstrain<T>(): rigid constraint passes over the n-node
+// cable, forward then backward. A node further than rest_length
+// from its neighbor is pulled back to it and loses the velocity
+// carrying it away.
+
+template<typename T>
+TOW_FORCE_INLINE void towCableConstrain(T rest_length, int n,
+                                        T *x, T *y, T *vx, T *vy)
+{
+  TOW_UNROLL
+  for(int i = 1; i < n - 1; i++) {
+    T dx   = x[i-1] - x[i];
+    T dy   = y[i-1] - y[i];
+    T dist = towHypot(dx, dy);
+    if(dist > rest_length && dist > T(1e-9)) {
+      T sc = rest_length / dist;
+      x[i] = x[i-1] - dx * sc;
+      y[i] = y[i-1] - dy * sc;
+      T urx = dx / dist;
+      T ury = dy / dist;
+      T vrad = vx[i] * urx + vy[i] * ury;
+      if(vrad < 0) {
+        vx[i] -= vrad * urx;
+        vy[i] -= vrad * ury;
+      }
+    }
+  }
+
+  TOW_UNROLL
+  for(int i = n - 2; i >= 1; i--) {
+    T dx   = x[i+1] - x[i];
+    T dy   = y[i+1] - y[i];
+    T dist = towHypot(dx, dy);
+    if(dist > rest_length && dist > T(1e-9)) {
+      T sc = rest_length / dist;
+      x[i] = x[i+1] - dx * sc;
+      y[i] = y[i+1] - dy * sc;
+      T urx = dx / dist;
+      T ury = dy / dist;
+      T vrad = vx[i] * urx + vy[i] * ury;
+      if(vrad < 0) {
+        vx[i] -= vrad * urx;
+        vy[i] -= vrad * ury;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------
+// towCableSweep<T>(): Euler step of the interior nodes in
+// Gauss-Seidel order, then the constraint passes. End nodes are
+// taken as pinned where they are.
+
+template<typename T>
+TOW_FORCE_INLINE void towCableSweep(const TowCableParamsT<T>& p, int n, T dt,
+                                    T *x, T *y, T *vx, T *vy)
+{
+  for(int i = 1; i < n - 1; i++)
+    towCableNodeEuler(p, dt, i, x, y, vx, vy);
+  towCableConstrain(p.rest_length, n, x, y, vx, vy);
+}
+
+//----------------------------------------------------------------
+// towCableRelaxSweep<T>(): straight line from anchor to tow, then
+// four forward/backward position-only constraint passes.
+
+template<typename T>
+TOW_FORCE_INLINE void towCableRelaxSweep(T rest_length, int n,
+                                         T ax, T ay, T tx, T ty,
+                                         T *x, T *y)
+{
+  TOW_UNROLL
+  for(int i = 0; i < n; i++) {
+    T frac = (T)i / (T)(n - 1);
+    x[i] = ax + frac * (tx - ax);
+    y[i] = ay + frac * (ty - ay);
+  }
+
+  for(int r = 0; r < 4; r++) {
+    TOW_UNROLL
+    for(int i = 1; i < n - 1; i++) {
+      T dx = x[i-1] - x[i];
+      T dy = y[i-1] - y[i];
+      T dist = towHypot(dx, dy);
+      if(dist > rest_length && dist > T(1e-9)) {
+        T sc = rest_length / dist;
+        x[i] = x[i-1] - dx * sc;
+        y[i] = y[i-1] - dy * sc;
+      }
+    }
+    TOW_UNROLL
+    for(int i = n - 2; i >= 1; i--) {
+      T dx = x[i+1] - x[i];
+      T dy = y[i+1] - y[i];
+      T dist = towHypot(dx, dy);
+      if(dist > rest_length && dist > T(1e-9)) {
+        T sc = rest_length / dist;
+        x[i] = x[i+1] - dx * sc;
+        y[i] = y[i+1] - dy * sc;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------
+// towCableStepN<T>(): one Euler step of an n-node cable in the
+// caller's arrays, anchor (node 0) and tow (node n-1) pinned. dt
+// is already clamped.
+
+template<typename T>
+void towCableStepN(const TowCableParamsT<T>& p, int n,
+                   T ax, T ay, T tx, T ty, T dt,
+                   T *nx_arr, T *ny_arr, T *nvx_arr, T *nvy_arr)
+{
+  nx_arr[0]  = ax;  ny_arr[0]  = ay;
+  nvx_arr[0] = 0;   nvy_arr[0] = 0;
+  nx_arr[n-1]  = tx;  ny_arr[n-1]  = ty;
+  nvx_arr[n-1] = 0;   nvy_arr[n-1] = 0;
+  towCableSweep(p, n, dt, nx_arr, ny_arr, nvx_arr, nvy_arr);
+}
+
+//----------------------------------------------------------------
+// towCableRelaxN<T>(): relaxed n-node cable shape
+
+template<typename T>
+void towCableRelaxN(T rest_length, int n, T ax, T ay, T tx, T ty,
+                    T *nx_arr, T *ny_arr)
+{
+  towCableRelaxSweep(rest_length, n, ax, ay, tx, ty, nx_arr, ny_arr);
+}
+
+//----------------------------------------------------------------
+// towCableStep<N>(): towCableStepN() on stack copies, N fixed
+
+template<typename T, int N>
+void towCableStep(const TowCableParamsT<T>& p,
+                  T ax, T ay, T tx, T ty, T dt,
+                  T *nx_arr, T *ny_arr, T *nvx_arr, T *nvy_arr)
+{
+  T x[N], y[N], vx[N], vy[N];
+  x[0]  = ax;  y[0]  = ay;
+  vx[0] = 0;   vy[0] = 0;
+  x[N-1]  = tx;  y[N-1]  = ty;
+  vx[N-1] = 0;   vy[N-1] = 0;
+  TOW_UNROLL
+  for(int i = 1; i < N - 1; i++) {
+    x[i]  = nx_arr[i];
+    y[i]  = ny_arr[i];
+    vx[i] = nvx_arr[i];
+    vy[i] = nvy_arr[i];
+  }
+
+  towCableSweep(p, N, dt, x, y, vx, vy);
+
+  TOW_UNROLL
+  for(int i = 0; i < N; i++) {
+    nx_arr[i]  = x[i];
+    ny_arr[i]  = y[i];
+    nvx_arr[i] = vx[i];
+    nvy_arr[i] = vy[i];
+  }
+}
+
+//----------------------------------------------------------------
+// towCableRelax<N>(): towCableRelaxN() on stack copies, N fixed
+
+template<typename T, int N>
+void towCableRelax(T rest_length, T ax, T ay, T tx, T ty,
+                   T *nx_arr, T *ny_arr)
+{
+  T x[N], y[N];
+  towCableRelaxSweep(rest_length, N, ax, ay, tx, ty, x, y);
+
+  TOW_UNROLL
+  for(int i = 0; i < N; i++) {
+    nx_arr[i] = x[i];
+    ny_arr[i] = y[i];
+  }
+}
+
+#endif
@@ -0,0 +1,115 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowDynamics.cpp                                 */
+/*    DATE: Apr 2026                                        */
+/************************************************************/
+
+#include "TowDynamics.h"
+
+//----------------------------------------------------------------
+// Procedure: towAdvanceBody()
+
+void towAdvanceBody(TowIntegrator m, const TowCableParams& p,
+                    double ax, double ay, double dt,
+                    double& tx, double& ty, double& tvx, double& tvy)
+{
+  if(!(p.cable_length > 0)) {
+    double spd = towHypot(tvx, tvy);
+    if((spd > 1e-6) && (p.cd > 0)) {
+      tvx += -p.cd * tvx * spd * dt;
+      tvy += -p.cd * tvy * spd * dt;
+    }
+    tx += tvx * dt;
+    ty += tvy * dt;
+    return;
+  }
+
+  if(m == TOW_INT_EULER) {
+    towBodyStep(p, ax, ay, dt, tx, ty, tvx, tvy);
+    return;
+  }
+
+  TowForceModel f = towBodyModel(ax, ay, p.cable_length,
+                                 p.k_spring, p.cd, p.c_tan);
+  towIntegrateStep(m, f, dt, tx, ty, tvx, tvy);
+  towClampToCable(p.cable_length, ax, ay, tx, ty, tvx, tvy);
+}
+
+//----------------------------------------------------------------
+// Procedure: towAdvanceCable()
+
+void towAdvanceCable(TowIntegrator m, const TowCableParams& p, int n,
+                     double ax, double ay, double tx, double ty, double dt,
+                     double *nx, double *ny, double *nvx, double *nvy)
+{
+  if(m == TOW_INT_EULER) {
+    TowCableStepFn  step  = 0;
+    TowCableRelaxFn relax = 0;
+    if(towCableKernels(n, step, relax) && step) {
+      step(p, ax, ay, tx, ty, dt, nx, ny, nvx, nvy);
+      return;
+    }
+  }
+  towAdvanceCableN(m, p, n, ax, ay, tx, ty, dt, nx, ny, nvx, nvy);
+}
+
+//----------------------------------------------------------------
+// Procedure: towAdvanceCableN()
+//   Purpose: Non-Euler methods advance each interior node in turn,
+//            neighbors held where the sweep has left them and the
+//            damping normal across the neighbor-to-neighbor
+//            direction, as in the Euler update.
+
+void towAdvanceCableN(TowIntegrator m, const TowCableParams& p, int n,
+                      double ax, double ay, double tx, double ty, double dt,
+                      double *nx, double *ny, double *nvx, double *nvy)
+{
+  if(m == TOW_INT_EULER) {
+    towCableStepN(p, n, ax, ay, tx, ty, dt, nx, ny, nvx, nvy);
+    return;
+  }
+
+  nx[0]  = ax;  ny[0]  = ay;
+  nvx[0] = 0;   nvy[0] = 0;
+  nx[n-1]  = tx;  ny[n-1]  = ty;
+  nvx[n-1] = 0;   nvy[n-1] = 0;
+
+  for(int i = 1; i < n - 1; i++) {
+    TowForceModel f;
+    f.springs  = 2;
+    f.sx[0]    = nx[i-1];
+    f.sy[0]    = ny[i-1];
+    f.sx[1]    = nx[i+1];
+    f.sy[1]    = ny[i+1];
+    f.rest     = p.rest_length;
+    f.k_spring = p.k_spring;
+    f.cd       = p.cd;
+    f.c_tan    = p.c_tan;
+
+    double cx   = nx[i+1] - nx[i-1];
+    double cy   = ny[i+1] - ny[i-1];
+    double clen = towHypot(cx, cy);
+    if(clen > 1e-6) {
+      f.tnx = -cy / clen;
+      f.tny =  cx / clen;
+    }
+    towIntegrateStep(m, f, dt, nx[i], ny[i], nvx[i], nvy[i]);
+  }
+  towCableConstrain(p.rest_length, n, nx, ny, nvx, nvy);
+}
+
+//----------------------------------------------------------------
+// Procedure: towRelaxCable()
+
+void towRelaxCable(double rest_length, int n,
+                   double ax, double ay, double tx, double ty,
+                   double *nx, double *ny)
+{
+  TowCableStepFn  step  = 0;
+  TowCableRelaxFn relax = 0;
+  if(towCableKernels(n, step, relax))
+    relax(rest_length, ax, ay, tx, ty, nx, ny);
+  else
+    towCableRelaxN(rest_length, n, ax, ay, tx, ty, nx, ny);
+}
@@ -0,0 +1,48 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowDynamics.h                                   */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Entry points of lib_towdyn: one step of the tow body or  */
+/* the cable with any TowIntegrator, and the relaxed cable  */
+/* shape. pTowing, pCable, the AOF forward simulation and   */
+/* BHV_TowObstacleAvoid all advance the model through these */
+/* (or, in the AOF's hot loop, the kernels they dispatch    */
+/* to), so a change to the physics lands in all four.       */
+/*                                                          */
+/* Euler is the sequential update of TowCableKernel.h,      */
+/* fixed-N where the node count allows. Other integrators   */
+/* step each body with the force model of TowIntegrator.h   */
+/* and are followed by the same rigid clamp or constraint   */
+/* passes. Callers clamp dt.                                */
+/************************************************************/
+
+#ifndef TOW_DYNAMICS_HEADER
+#define TOW_DYNAMICS_HEADER
+
+#include "TowIntegrator.h"
+#include "TowCableKernel.h"
+
+// Tow body toward the anchor (ax,ay). A cable length that is not
+// positive leaves drag only.
+void towAdvanceBody(TowIntegrator m, const TowCableParams& p,
+                    double ax, double ay, double dt,
+                    double& tx, double& ty, double& tvx, double& tvy);
+
+// n-node cable, anchor (node 0) and tow (node n-1) pinned
+void towAdvanceCable(TowIntegrator m, const TowCableParams& p, int n,
+                     double ax, double ay, double tx, double ty, double dt,
+                     double *nx, double *ny, double *nvx, double *nvy);
+
+// As towAdvanceCable(), never taking the fixed-N kernels
+void towAdvanceCableN(TowIntegrator m, const TowCableParams& p, int n,
+                      double ax, double ay, double tx, double ty, double dt,
+                      double *nx, double *ny, double *nvx, double *nvy);
+
+// Relaxed n-node shape between anchor and tow
+void towRelaxCable(double rest_length, int n,
+                   double ax, double ay, double tx, double ty,
+                   double *nx, double *ny);
+
+#endif
@@ -0,0 +1,281 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowIntegrator.h                                 */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Time integrators for the tow body and the interior cable */
+/* nodes, shared by pTowing, pCable and the AOF forward     */
+/* simulation so all three advance the same model the same  */
+/* way. Header-only, like TowSimd.h.                        */
+/*                                                          */
+/* A body sees up to two springs (pulling when stretched    */
+/* past their rest length), quadratic drag and damping of   */
+/* its velocity across the cable. The tow's cable direction */
+/* is to its anchor; a cable node's is fixed for the step   */
+/* (neighbor to neighbor). Other bodies are held fixed      */
+/* during a step, as in the existing Gauss-Seidel sweep.    */
+/*                                                          */
+/*   euler          Existing sequential update: each force  */
+/*                  term in turn, then position with the    */
+/*                  new velocity. Kept in the callers so    */
+/*                  the default is bit-identical.           */
+/*                  Stable for h < ~2/sqrt(k_eff), h*c_tan  */
+/*                  < 2, h*cd*|v| < 2.                      */
+/*   semi_implicit  Same sequence with each term linearly   */
+/*                  implicit: spring against the end-of-    */
+/*                  step stretch, drag and damping divide   */
+/*                  rather than subtract. No step limit     */
+/*                  from k, cd or c_tan; first order.       */
+/*   rk2            Explicit midpoint. Second order,        */
+/*                  similar step limit to euler.            */
+/*   rk4            Classic Runge-Kutta. Fourth order,      */
+/*                  step limit ~2.8/sqrt(k_eff), 2.8/c_tan. */
+/*                                                          */
+/* The rigid clamp / constraint passes stay with the        */
+/* callers and follow every integrator.                     */
+/************************************************************/
+
+#ifndef TOW_INTEGRATOR_HEADER
+#define TOW_INTEGRATOR_HEADER
+
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "TowSimd.h"
+
+enum TowIntegrator {
+  TOW_INT_EULER = 0,
+  TOW_INT_SEMI_IMPLICIT,
+  TOW_INT_RK2,
+  TOW_INT_RK4
+};
+
+inline const char* towIntegratorName(TowIntegrator m)
+{
+  if(m == TOW_INT_SEMI_IMPLICIT) return("semi_implicit");
+  if(m == TOW_INT_RK2)           return("rk2");
+  if(m == TOW_INT_RK4)           return("rk4");
+  return("euler");
+}
+
+inline bool towIntegratorFromString(const std::string& s, TowIntegrator& m)
+{
+  if(s == "euler")              m = TOW_INT_EULER;
+  else if(s == "semi_implicit") m = TOW_INT_SEMI_IMPLICIT;
+  else if(s == "rk2")           m = TOW_INT_RK2;
+  else if(s == "rk4")           m = TOW_INT_RK4;
+  else
+    return(false);
+  return(true);
+}
+
+//----------------------------------------------------------------
+// TowForceModel: what acts on one body during a step
+
+struct TowForceModel {
+  int    springs;          // 0, 1 or 2
+  double sx[2], sy[2];     // spring far ends
+  double rest;             // spring rest length
+  double k_spring;
+  double cd;
+  double c_tan;
+  bool   tan_to_anchor;    // damping normal from the body to sx[0]
+  double tnx, tny;         // fixed damping normal (unit, or 0,0)
+
+  TowForceModel() : springs(0), rest(0), k_spring(0), cd(0), c_tan(0),
+                    tan_to_anchor(false), tnx(0), tny(0)
+  {sx[0] = sx[1] = sy[0] = sy[1] = 0;}
+};
+
+// Tow body pulled toward the anchor (ax,ay) by a cable of length len
+inline TowForceModel towBodyModel(double ax, double ay, double len,
+                                  double k, double cd, double c_tan)
+{
+  TowForceModel f;
+  f.springs = 1;
+  f.sx[0] = ax;
+  f.sy[0] = ay;
+  f.rest = len;
+  f.k_spring = k;
+  f.cd = cd;
+  f.c_tan = c_tan;
+  f.tan_to_anchor = true;
+  return(f);
+}
+
+//----------------------------------------------------------------
+// towDampNormal(): unit damping normal at (x,y), false if undefined
+
+inline bool towDampNormal(const TowForceModel& f, double x, double y,
+                          double& nx, double& ny)
+{
+  if(!f.tan_to_anchor) {
+    nx = f.tnx;
+    ny = f.tny;
+    return((nx != 0) || (ny != 0));
+  }
+  double dx = f.sx[0] - x;
+  double dy = f.sy[0] - y;
+  double d = towHypot(dx, dy);
+  if(d <= 0.01)
+    return(false);
+  nx = -dy / d;
+  ny =  dx / d;
+  return(true);
+}
+
+//----------------------------------------------------------------
+// towAccel(): acceleration of a body at (x,y) moving at (vx,vy)
+
+inline void towAccel(const TowForceModel& f, double x, double y,
+                     double vx, double vy, double& fx, double& fy)
+{
+  fx = 0;
+  fy = 0;
+  if(f.k_spring > 0) {
+    for(int i = 0; i < f.springs; i++) {
+      double dx = f.sx[i] - x;
+      double dy = f.sy[i] - y;
+      double d = towHypot(dx, dy);
+      if((d > 0.01) && (d > f.rest)) {
+        double s = f.k_spring * (d - f.rest) / d;
+        fx += s * dx;
+        fy += s * dy;
+      }
+    }
+  }
+
+  double spd = towHypot(vx, vy);
+  if((spd > 1e-6) && (f.cd > 0)) {
+    fx -= f.cd * vx * spd;
+    fy -= f.cd * vy * spd;
+  }
+
+  double nx, ny;
+  if((f.c_tan > 0) && towDampNormal(f, x, y, nx, ny)) {
+    double vt = vx * nx + vy * ny;
+    fx -= f.c_tan * vt * nx;
+    fy -= f.c_tan * vt * ny;
+  }
+}
+
+//----------------------------------------------------------------
+// towSemiImplicitStep(): the euler sequence, each term linearly
+// implicit. Spring: the radial speed toward the far end satisfies
+//   vr' = vr + h*k*(stretch - h*vr'),
+// drag uses v' = v / (1 + h*cd*|v|), damping vt' = vt / (1 + h*c_tan).
+
+inline void towSemiImplicitStep(const TowForceModel& f, double h,
+                                double& x, double& y,
+                                double& vx, double& vy)
+{
+  if(f.k_spring > 0) {
+    for(int i = 0; i < f.springs; i++) {
+      double dx = f.sx[i] - x;
+      double dy = f.sy[i] - y;
+      double d = towHypot(dx, dy);
+      if((d > 0.01) && (d > f.rest)) {
+        double ux = dx / d;
+        double uy = dy / d;
+        double vr = vx * ux + vy * uy;
+        double vr_new = (vr + h * f.k_spring * (d - f.rest)) /
+          (1 + h * h * f.k_spring);
+        vx += (vr_new - vr) * ux;
+        vy += (vr_new - vr) * uy;
+      }
+    }
+  }
+
+  double spd = towHypot(vx, vy);
+  if((spd > 1e-6) && (f.cd > 0)) {
+    double sc = 1.0 / (1 + h * f.cd * spd);
+    vx *= sc;
+    vy *= sc;
+  }
+
+  double nx, ny;
+  if((f.c_tan > 0) && towDampNormal(f, x, y, nx, ny)) {
+    double vt = vx * nx + vy * ny;
+    double dvt = vt / (1 + h * f.c_tan) - vt;
+    vx += dvt * nx;
+    vy += dvt * ny;
+  }
+
+  x += vx * h;
+  y += vy * h;
+}
+
+//----------------------------------------------------------------
+// towIntegrateStep(): advance (x,y,vx,vy) by h with method m.
+// Euler stays in the callers' own sequential update; it is taken
+// as semi_implicit here.
+
+inline void towIntegrateStep(TowIntegrator m, const TowForceModel& f,
+                             double h, double& x, double& y,
+                             double& vx, double& vy)
+{
+  if(m == TOW_INT_RK2) {
+    double ax1, ay1;
+    towAccel(f, x, y, vx, vy, ax1, ay1);
+    double hh = 0.5 * h;
+    double mx  = x  + hh * vx;
+    double my  = y  + hh * vy;
+    double mvx = vx + hh * ax1;
+    double mvy = vy + hh * ay1;
+    double ax2, ay2;
+    towAccel(f, mx, my, mvx, mvy, ax2, ay2);
+    x  += h * mvx;
+    y  += h * mvy;
+    vx += h * ax2;
+    vy += h * ay2;
+  }
+  else if(m == TOW_INT_RK4) {
+    double hh = 0.5 * h;
+    double ax1, ay1, ax2, ay2, ax3, ay3, ax4, ay4;
+    towAccel(f, x, y, vx, vy, ax1, ay1);
+    double vx2 = vx + hh * ax1;
+    double vy2 = vy + hh * ay1;
+    towAccel(f, x + hh * vx, y + hh * vy, vx2, vy2, ax2, ay2);
+    double vx3 = vx + hh * ax2;
+    double vy3 = vy + hh * ay2;
+    towAccel(f, x + hh * vx2, y + hh * vy2, vx3, vy3, ax3, ay3);
+    double vx4 = vx + h * ax3;
+    double vy4 = vy + h * ay3;
+    towAccel(f, x + h * vx3, y + h * vy3, vx4, vy4, ax4, ay4);
+    double h6 = h / 6.0;
+    x  += h6 * (vx + 2 * vx2 + 2 * vx3 + vx4);
+    y  += h6 * (vy + 2 * vy2 + 2 * vy3 + vy4);
+    vx += h6 * (ax1 + 2 * ax2 + 2 * ax3 + ax4);
+    vy += h6 * (ay1 + 2 * ay2 + 2 * ay3 + ay4);
+  }
+  else
+    towSemiImplicitStep(f, h, x, y, vx, vy);
+}
+
+//----------------------------------------------------------------
+// towStableStep(): largest step the method keeps stable for the
+// stiffest linear terms (k_eff = 2k for an interior cable node),
+// with the safety factor the adaptive stepper has always used for
+// euler. 0 means no limit.
+
+inline double towStableStep(TowIntegrator m, double k_spring, double c_tan)
+{
+  if(m == TOW_INT_SEMI_IMPLICIT)
+    return(0);
+  double ks = 1.5, kc = 1.0;
+  if(m == TOW_INT_RK4) {
+    ks = 2.0;
+    kc = 1.4;
+  }
+  double h = 0;
+  if(k_spring > 0)
+    h = ks / sqrt(2.0 * k_spring);
+  if(c_tan > 0) {
+    double hc = kc / c_tan;
+    h = (h > 0) ? std::min(h, hc) : hc;
+  }
+  return(h);
+}
+
+#endif
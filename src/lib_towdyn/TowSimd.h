@@ -0,0 +1,254 @@
+/************************************************************/
+/*    NAME: Tom Monaghan                                    */
+/*    ORGN: MIT                                             */
+/*    FILE: TowSimd.h                                       */
+/*    DATE: Apr 2026                                        */
+/*                                                          */
+/* Minimal 4-lane double vector used by the batched tow     */
+/* forward simulation (AOF_TowObstacleAvoid::evalBatch) and */
+/* the batched polygon distance kernel (ConvexPolyDist).    */
+/* Three interchangeable implementations are selected at    */
+/* compile time: AVX (one 256-bit register), SSE2 (two      */
+/* 128-bit registers) and a plain scalar fallback.          */
+/*                                                          */
+/* Only IEEE-exact operations are provided (+ - * / sqrt,   */
+/* compares, blends), so a lane computes exactly what the   */
+/* scalar code computes when the operation order matches    */
+/* and the compiler does not contract a*b+c into an FMA.    */
+/* Define TOW_SIMD_SCALAR to force the scalar fallback.     */
+/************************************************************/
+
+#ifndef TOW_SIMD_HEADER
+#define TOW_SIMD_HEADER
+
+#include <cmath>
+
+#if defined(TOW_SIMD_SCALAR)
+// Scalar fallback requested explicitly
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define TOW_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TOW_SIMD_SSE2 1
+#endif
+
+//----------------------------------------------------------------
+// towHypot(): sqrt(x*x + y*y). Used in place of std::hypot by the
+// AOF kernels so scalar and vector lanes round identically. The
+// magnitudes involved (meters, m/s) cannot overflow.
+
+inline double towHypot(double x, double y)
+{
+  return(std::sqrt(x*x + y*y));
+}
+
+inline float towHypot(float x, float y)
+{
+  return(std::sqrt(x*x + y*y));
+}
+
+#if defined(TOW_SIMD_AVX)
+
+//================================================================
+// AVX implementation
+//================================================================
+
+struct TowMask4d {
+  __m256d m;
+  TowMask4d() {}
+  TowMask4d(__m256d v) : m(v) {}
+  TowMask4d operator&(const TowMask4d& o) const {return(_mm256_and_pd(m, o.m));}
+  TowMask4d operator|(const TowMask4d& o) const {return(_mm256_or_pd(m, o.m));}
+  TowMask4d andNot(const TowMask4d& o) const {return(_mm256_andnot_pd(o.m, m));}
+  bool any() const {return(_mm256_movemask_pd(m) != 0);}
+};
+
+struct TowVec4d {
+  __m256d v;
+  TowVec4d() {}
+  TowVec4d(__m256d x) : v(x) {}
+  TowVec4d(double x) : v(_mm256_set1_pd(x)) {}
+  static TowVec4d load(const double *p) {return(_mm256_loadu_pd(p));}
+  void store(double *p) const {_mm256_storeu_pd(p, v);}
+
+  TowVec4d operator-() const {return(_mm256_xor_pd(v, _mm256_set1_pd(-0.0)));}
+  TowVec4d operator+(const TowVec4d& o) const {return(_mm256_add_pd(v, o.v));}
+  TowVec4d operator-(const TowVec4d& o) const {return(_mm256_sub_pd(v, o.v));}
+  TowVec4d operator*(const TowVec4d& o) const {return(_mm256_mul_pd(v, o.v));}
+  TowVec4d operator/(const TowVec4d& o) const {return(_mm256_div_pd(v, o.v));}
+
+  TowMask4d operator>(const TowVec4d& o) const  {return(_mm256_cmp_pd(v, o.v, _CMP_GT_OQ));}
+  TowMask4d operator<(const TowVec4d& o) const  {return(_mm256_cmp_pd(v, o.v, _CMP_LT_OQ));}
+  TowMask4d operator<=(const TowVec4d& o) const {return(_mm256_cmp_pd(v, o.v, _CMP_LE_OQ));}
+};
+
+inline TowVec4d towSqrt(const TowVec4d& a) {return(_mm256_sqrt_pd(a.v));}
+inline TowVec4d towMin(const TowVec4d& a, const TowVec4d& b) {return(_mm256_min_pd(a.v, b.v));}
+inline TowVec4d towMax(const TowVec4d& a, const TowVec4d& b) {return(_mm256_max_pd(a.v, b.v));}
+
+// select(): lanes where mask is set take a, others take b
+inline TowVec4d towSelect(const TowMask4d& m, const TowVec4d& a, const TowVec4d& b)
+{
+  return(_mm256_blendv_pd(b.v, a.v, m.m));
+}
+
+inline const char* towSimdPath() {return("avx");}
+
+#elif defined(TOW_SIMD_SSE2)
+
+//================================================================
+// SSE2 implementation (two 128-bit halves)
+//================================================================
+
+struct TowMask4d {
+  __m128d lo, hi;
+  TowMask4d() {}
+  TowMask4d(__m128d l, __m128d h) : lo(l), hi(h) {}
+  TowMask4d operator&(const TowMask4d& o) const
+  {return(TowMask4d(_mm_and_pd(lo, o.lo), _mm_and_pd(hi, o.hi)));}
+  TowMask4d operator|(const TowMask4d& o) const
+  {return(TowMask4d(_mm_or_pd(lo, o.lo), _mm_or_pd(hi, o.hi)));}
+  TowMask4d andNot(const TowMask4d& o) const
+  {return(TowMask4d(_mm_andnot_pd(o.lo, lo), _mm_andnot_pd(o.hi, hi)));}
+  bool any() const {return((_mm_movemask_pd(lo) | _mm_movemask_pd(hi)) != 0);}
+};
+
+struct TowVec4d {
+  __m128d lo, hi;
+  TowVec4d() {}
+  TowVec4d(__m128d l, __m128d h) : lo(l), hi(h) {}
+  TowVec4d(double x) : lo(_mm_set1_pd(x)), hi(_mm_set1_pd(x)) {}
+  static TowVec4d load(const double *p) {return(TowVec4d(_mm_loadu_pd(p), _mm_loadu_pd(p+2)));}
+  void store(double *p) const {_mm_storeu_pd(p, lo); _mm_storeu_pd(p+2, hi);}
+
+  TowVec4d operator-() const
+  {__m128d s = _mm_set1_pd(-0.0); return(TowVec4d(_mm_xor_pd(lo, s), _mm_xor_pd(hi, s)));}
+  TowVec4d operator+(const TowVec4d& o) const
+  {return(TowVec4d(_mm_add_pd(lo, o.lo), _mm_add_pd(hi, o.hi)));}
+  TowVec4d operator-(const TowVec4d& o) const
+  {return(TowVec4d(_mm_sub_pd(lo, o.lo), _mm_sub_pd(hi, o.hi)));}
+  TowVec4d operator*(const TowVec4d& o) const
+  {return(TowVec4d(_mm_mul_pd(lo, o.lo), _mm_mul_pd(hi, o.hi)));}
+  TowVec4d operator/(const TowVec4d& o) const
+  {return(TowVec4d(_mm_div_pd(lo, o.lo), _mm_div_pd(hi, o.hi)));}
+
+  TowMask4d operator>(const TowVec4d& o) const
+  {return(TowMask4d(_mm_cmpgt_pd(lo, o.lo), _mm_cmpgt_pd(hi, o.hi)));}
+  TowMask4d operator<(const TowVec4d& o) const
+  {return(TowMask4d(_mm_cmplt_pd(lo, o.lo), _mm_cmplt_pd(hi, o.hi)));}
+  TowMask4d operator<=(const TowVec4d& o) const
+  {return(TowMask4d(_mm_cmple_pd(lo, o.lo), _mm_cmple_pd(hi, o.hi)));}
+};
+
+inline TowVec4d towSqrt(const TowVec4d& a)
+{
+  return(TowVec4d(_mm_sqrt_pd(a.lo), _mm_sqrt_pd(a.hi)));
+}
+
+inline TowVec4d towMin(const TowVec4d& a, const TowVec4d& b)
+{
+  return(TowVec4d(_mm_min_pd(a.lo, b.lo), _mm_min_pd(a.hi, b.hi)));
+}
+
+inline TowVec4d towMax(const TowVec4d& a, const TowVec4d& b)
+{
+  return(TowVec4d(_mm_max_pd(a.lo, b.lo), _mm_max_pd(a.hi, b.hi)));
+}
+
+inline TowVec4d towSelect(const TowMask4d& m, const TowVec4d& a, const TowVec4d& b)
+{
+  __m128d lo = _mm_or_pd(_mm_and_pd(m.lo, a.lo), _mm_andnot_pd(m.lo, b.lo));
+  __m128d hi = _mm_or_pd(_mm_and_pd(m.hi, a.hi), _mm_andnot_pd(m.hi, b.hi));
+  return(TowVec4d(lo, hi));
+}
+
+inline const char* towSimdPath() {return("sse2");}
+
+#else
+
+//================================================================
+// Scalar fallback
+//================================================================
+
+struct TowMask4d {
+  bool m[4];
+  TowMask4d operator&(const TowMask4d& o) const
+  {TowMask4d r; for(int i=0; i<4; i++) r.m[i] = m[i] && o.m[i]; return(r);}
+  TowMask4d operator|(const TowMask4d& o) const
+  {TowMask4d r; for(int i=0; i<4; i++) r.m[i] = m[i] || o.m[i]; return(r);}
+  TowMask4d andNot(const TowMask4d& o) const
+  {TowMask4d r; for(int i=0; i<4; i++) r.m[i] = m[i] && !o.m[i]; return(r);}
+  bool any() const {return(m[0] || m[1] || m[2] || m[3]);}
+};
+
+struct TowVec4d {
+  double v[4];
+  TowVec4d() {}
+  TowVec4d(double x) {v[0] = v[1] = v[2] = v[3] = x;}
+  static TowVec4d load(const double *p)
+  {TowVec4d r; for(int i=0; i<4; i++) r.v[i] = p[i]; return(r);}
+  void store(double *p) const {for(int i=0; i<4; i++) p[i] = v[i];}
+
+  TowVec4d operator-() const
+  {TowVec4d r; for(int i=0; i<4; i++) r.v[i] = -v[i]; return(r);}
+  TowVec4d operator+(const TowVec4d& o) const
+  {TowVec4d r; for(int i=0; i<4; i++) r.v[i] = v[i] + o.v[i]; return(r);}
+  TowVec4d operator-(const TowVec4d& o) const
+  {TowVec4d r; for(int i=0; i<4; i++) r.v[i] = v[i] - o.v[i]; return(r);}
+  TowVec4d operator*(const TowVec4d& o) const
+  {TowVec4d r; for(int i=0; i<4; i++) r.v[i] = v[i] * o.v[i]; return(r);}
+  TowVec4d operator/(const TowVec4d& o) const
+  {TowVec4d r; for(int i=0; i<4; i++) r.v[i] = v[i] / o.v[i]; return(r);}
+
+  TowMask4d operator>(const TowVec4d& o) const
+  {TowMask4d r; for(int i=0; i<4; i++) r.m[i] = v[i] > o.v[i]; return(r);}
+  TowMask4d operator<(const TowVec4d& o) const
+  {TowMask4d r; for(int i=0; i<4; i++) r.m[i] = v[i] < o.v[i]; return(r);}
+  TowMask4d operator<=(const TowVec4d& o) const
+  {TowMask4d r; for(int i=0; i<4; i++) r.m[i] = v[i] <= o.v[i]; return(r);}
+};
+
+inline TowVec4d towSqrt(const TowVec4d& a)
+{
+  TowVec4d r;
+  for(int i=0; i<4; i++)
+    r.v[i] = std::sqrt(a.v[i]);
+  return(r);
+}
+
+// Same operand order as minpd/maxpd: b is returned on ties and NaN
+inline TowVec4d towMin(const TowVec4d& a, const TowVec4d& b)
+{
+  TowVec4d r;
+  for(int i=0; i<4; i++)
+    r.v[i] = (a.v[i] < b.v[i]) ? a.v[i] : b.v[i];
+  return(r);
+}
+
+inline TowVec4d towMax(const TowVec4d& a, const TowVec4d& b)
+{
+  TowVec4d r;
+  for(int i=0; i<4; i++)
+    r.v[i] = (a.v[i] > b.v[i]) ? a.v[i] : b.v[i];
+  return(r);
+}
+
+inline TowVec4d towSelect(const TowMask4d& m, const TowVec4d& a, const TowVec4d& b)
+{
+  TowVec4d r;
+  for(int i=0; i<4; i++)
+    r.v[i] = m.m[i] ? a.v[i] : b.v[i];
+  return(r);
+}
+
+inline const char* towSimdPath() {return("scalar");}
+
+#endif
+
+inline TowVec4d towHypot(const TowVec4d& x, const TowVec4d& y)
+{
+  return(towSqrt(x*x + y*y));
+}
+
+#endif
@@ -25,6 +25,7 @@ Cable::Cable()
   m_k_spring          = 5.0;
   m_cd                = 0.7;
   m_c_tan             = 2.0;
+  m_integrator        = TOW_INT_EULER;
 
   // State
   m_nav_x             = 0;
@@ -71,10 +72,7 @@ bool Cable::OnNewMail(MOOSMSG_LIST &NewMail)
     // Dynamic parameter sync from pTowing
     else if(key == "TOW_CABLE_LENGTH") {
       m_cable_length = msg.GetDouble();
-      if(m_cable_length < 30.0)
-        m_num_nodes = 3;
-      else
-        m_num_nodes = std::max(3, (int)(m_cable_length / 10.0));
+      m_num_nodes   = towCableNodes(m_cable_length);
       m_rest_length = m_cable_length / (double)(m_num_nodes - 1);
       m_initialized = false;
     }
@@ -86,6 +84,10 @@ bool Cable::OnNewMail(MOOSMSG_LIST &NewMail)
       m_cd = msg.GetDouble();
     else if(key == "TOW_TAN_DAMPING")
       m_c_tan = msg.GetDouble();
+    else if(key == "TOW_INTEGRATOR") {
+      if(!towIntegratorFromString(msg.GetString(), m_integrator))
+        reportRunWarning("Unknown TOW_INTEGRATOR: " + msg.GetString());
+    }
     else if(key != "APPCAST_REQ")
       reportRunWarning("Unhandled Mail: " + key);
    }
@@ -115,8 +117,10 @@ bool Cable::Iterate()
   // to tow body. Re-runs if cable length changes.
   // ============================================================
   if(!m_initialized) {
-    m_nodes.clear();
-    m_nodes.resize(m_num_nodes);
+    m_nx.assign(m_num_nodes, 0);
+    m_ny.assign(m_num_nodes, 0);
+    m_nvx.assign(m_num_nodes, 0);
+    m_nvy.assign(m_num_nodes, 0);
 
     double hdg_rad_init = (90.0 - m_nav_heading) * M_PI / 180.0;
     double anchor_x = m_nav_x - m_attach_offset * cos(hdg_rad_init);
@@ -124,10 +128,8 @@ bool Cable::Iterate()
 
     for(int i = 0; i < m_num_nodes; i++) {
       double t = (double)i / (double)(m_num_nodes - 1);
-      m_nodes[i].x  = anchor_x + t * (m_towed_x - anchor_x);
-      m_nodes[i].y  = anchor_y + t * (m_towed_y - anchor_y);
-      m_nodes[i].vx = 0;
-      m_nodes[i].vy = 0;
+      m_nx[i] = anchor_x + t * (m_towed_x - anchor_x);
+      m_ny[i] = anchor_y + t * (m_towed_y - anchor_y);
     }
     m_initialized = true;
   }
@@ -145,132 +147,25 @@ bool Cable::Iterate()
     dt = 1.0 / GetAppFreq();
 
   // ============================================================
-  // Pin endpoints
-  // ============================================================
-  double hdg_rad = (90.0 - m_nav_heading) * M_PI / 180.0;
-
-  m_nodes[0].x  = m_nav_x - m_attach_offset * cos(hdg_rad);
-  m_nodes[0].y  = m_nav_y - m_attach_offset * sin(hdg_rad);
-  m_nodes[0].vx = 0;
-  m_nodes[0].vy = 0;
-
-  m_nodes[m_num_nodes - 1].x  = m_towed_x;
-  m_nodes[m_num_nodes - 1].y  = m_towed_y;
-  m_nodes[m_num_nodes - 1].vx = 0;
-  m_nodes[m_num_nodes - 1].vy = 0;
-
-  // ============================================================
-  // Interior node dynamics (matches pTowing1/AOF physics)
-  // For each interior node: spring from both neighbors,
-  // quadratic drag, tangential damping, Euler integration.
-  // ============================================================
-  for(int i = 1; i < m_num_nodes - 1; i++)
-  {
-    CableNode &node = m_nodes[i];
-
-    // --- Spring force from PREVIOUS neighbor (i-1) ---
-    double dx_prev   = m_nodes[i-1].x - node.x;
-    double dy_prev   = m_nodes[i-1].y - node.y;
-    double dist_prev = hypot(dx_prev, dy_prev);
-
-    if(dist_prev > 0.01 && dist_prev > m_rest_length && m_k_spring > 0) {
-      double ux = dx_prev / dist_prev;
-      double uy = dy_prev / dist_prev;
-      double overshoot = dist_prev - m_rest_length;
-      node.vx += m_k_spring * overshoot * ux * dt;
-      node.vy += m_k_spring * overshoot * uy * dt;
-    }
-
-    // --- Spring force from NEXT neighbor (i+1) ---
-    double dx_next   = m_nodes[i+1].x - node.x;
-    double dy_next   = m_nodes[i+1].y - node.y;
-    double dist_next = hypot(dx_next, dy_next);
-
-    if(dist_next > 0.01 && dist_next > m_rest_length && m_k_spring > 0) {
-      double ux = dx_next / dist_next;
-      double uy = dy_next / dist_next;
-      double overshoot = dist_next - m_rest_length;
-      node.vx += m_k_spring * overshoot * ux * dt;
-      node.vy += m_k_spring * overshoot * uy * dt;
-    }
-
-    // --- Quadratic drag ---
-    double speed = hypot(node.vx, node.vy);
-    if(speed > 1e-6 && m_cd > 0) {
-      node.vx += -m_cd * node.vx * speed * dt;
-      node.vy += -m_cd * node.vy * speed * dt;
-    }
-
-    // --- Tangential damping ---
-    // Cable direction: vector from node[i-1] to node[i+1]
-    // Normal is perpendicular; damp velocity component along the normal
-    if(m_c_tan > 0) {
-      double cx   = m_nodes[i+1].x - m_nodes[i-1].x;
-      double cy   = m_nodes[i+1].y - m_nodes[i-1].y;
-      double clen = hypot(cx, cy);
-      if(clen > 1e-6) {
-        double ux = cx / clen;  // unit tangent along cable
-        double uy = cy / clen;
-        double nx = -uy;        // unit normal (perpendicular)
-        double ny =  ux;
-        double vn = node.vx * nx + node.vy * ny;
-        node.vx += (-m_c_tan * vn) * nx * dt;
-        node.vy += (-m_c_tan * vn) * ny * dt;
-      }
-    }
-
-    // --- Euler position integration ---
-    node.x += node.vx * dt;
-    node.y += node.vy * dt;
-  }
-
-  // ============================================================
-  // Rigid distance constraints (bidirectional pass)
-  // Forward: clamp interior nodes relative to predecessor
-  // Backward: clamp interior nodes relative to successor
+  // Interior node dynamics with the endpoints pinned to the
+  // anchor and tow body: springs to both neighbors, quadratic
+  // drag, tangential damping, then the rigid distance
+  // constraints (lib_towdyn, the same model the obstacle
+  // behavior simulates)
   // ============================================================
-
-  // Forward pass
-  for(int i = 1; i < m_num_nodes - 1; i++) {
-    double dx   = m_nodes[i-1].x - m_nodes[i].x;
-    double dy   = m_nodes[i-1].y - m_nodes[i].y;
-    double dist = hypot(dx, dy);
-
-    if(dist > m_rest_length && dist > 1e-9) {
-      double sc = m_rest_length / dist;
-      m_nodes[i].x = m_nodes[i-1].x - dx * sc;
-      m_nodes[i].y = m_nodes[i-1].y - dy * sc;
-
-      double urx  = dx / dist;
-      double ury  = dy / dist;
-      double vrad = m_nodes[i].vx * urx + m_nodes[i].vy * ury;
-      if(vrad < 0) {
-        m_nodes[i].vx -= vrad * urx;
-        m_nodes[i].vy -= vrad * ury;
-      }
-    }
-  }
-
-  // Backward pass
-  for(int i = m_num_nodes - 2; i >= 1; i--) {
-    double dx   = m_nodes[i+1].x - m_nodes[i].x;
-    double dy   = m_nodes[i+1].y - m_nodes[i].y;
-    double dist = hypot(dx, dy);
-
-    if(dist > m_rest_length && dist > 1e-9) {
-      double sc = m_rest_length / dist;
-      m_nodes[i].x = m_nodes[i+1].x - dx * sc;
-      m_nodes[i].y = m_nodes[i+1].y - dy * sc;
-
-      double urx  = dx / dist;
-      double ury  = dy / dist;
-      double vrad = m_nodes[i].vx * urx + m_nodes[i].vy * ury;
-      if(vrad < 0) {
-        m_nodes[i].vx -= vrad * urx;
-        m_nodes[i].vy -= vrad * ury;
-      }
-    }
-  }
+  double hdg_rad  = (90.0 - m_nav_heading) * M_PI / 180.0;
+  double anchor_x = m_nav_x - m_attach_offset * cos(hdg_rad);
+  double anchor_y = m_nav_y - m_attach_offset * sin(hdg_rad);
+
+  TowCableParams params;
+  params.k_spring     = m_k_spring;
+  params.cd           = m_cd;
+  params.c_tan        = m_c_tan;
+  params.rest_length  = m_rest_length;
+  params.cable_length = m_cable_length;
+  towAdvanceCable(m_integrator, params, m_num_nodes, anchor_x, anchor_y,
+                  m_towed_x, m_towed_y, dt,
+                  &m_nx[0], &m_ny[0], &m_nvx[0], &m_nvy[0]);
 
   // ============================================================
   // Publish VIEW_SEGLIST and CABLE_NODE_REPORT
@@ -281,8 +176,8 @@ bool Cable::Iterate()
   for(int i = 0; i < m_num_nodes; i++) {
     if(i > 0)
       pts_str += ":";
-    pts_str += doubleToStringX(m_nodes[i].x, 1) + "," +
-               doubleToStringX(m_nodes[i].y, 1);
+    pts_str += doubleToStringX(m_nx[i], 1) + "," +
+               doubleToStringX(m_ny[i], 1);
   }
   pts_str += "}";
   pts_str += ",label=CABLE";
@@ -293,8 +188,8 @@ bool Cable::Iterate()
   // CABLE_NODE_REPORT: all node positions for pTowObstacleMgr
   string report = "nodes=" + intToString(m_num_nodes);
   for(int i = 0; i < m_num_nodes; i++) {
-    report += ",x" + intToString(i) + "=" + doubleToStringX(m_nodes[i].x, 2);
-    report += ",y" + intToString(i) + "=" + doubleToStringX(m_nodes[i].y, 2);
+    report += ",x" + intToString(i) + "=" + doubleToStringX(m_nx[i], 2);
+    report += ",y" + intToString(i) + "=" + doubleToStringX(m_ny[i], 2);
   }
   Notify("CABLE_NODE_REPORT", report);
 
@@ -343,17 +238,15 @@ bool Cable::OnStartUp()
       m_c_tan = stod(value);
       handled = true;
     }
+    else if(param == "integrator")
+      handled = towIntegratorFromString(tolower(value), m_integrator);
 
     if(!handled)
       reportUnhandledConfigWarning(orig);
   }
 
   // Compute node count and rest length
-  if(m_cable_length < 30.0)
-    m_num_nodes = 3;
-  else
-    m_num_nodes = std::max(3, (int)(m_cable_length / 10.0));
-
+  m_num_nodes   = towCableNodes(m_cable_length);
   m_rest_length = m_cable_length / (double)(m_num_nodes - 1);
 
   registerVariables();
@@ -376,6 +269,7 @@ void Cable::registerVariables()
   Register("TOW_SPRING_STIFFNESS", 0);
   Register("TOW_DRAG_COEFF", 0);
   Register("TOW_TAN_DAMPING", 0);
+  Register("TOW_INTEGRATOR", 0);
 }
 
 
@@ -394,6 +288,7 @@ bool Cable::buildReport()
   m_msgs << " k_spring:        " << m_k_spring << endl;
   m_msgs << " cd:              " << m_cd << endl;
   m_msgs << " c_tan:           " << m_c_tan << endl;
+  m_msgs << " integrator:      " << towIntegratorName(m_integrator) << endl;
   m_msgs << " attach_offset:   " << m_attach_offset << " m" << endl;
   m_msgs << " Initialized:     " << (m_initialized ? "true" : "false") << endl;
   m_msgs << endl;
@@ -419,9 +314,9 @@ bool Cable::buildReport()
         label = intToString(i);
 
       actab << label
-            << doubleToStringX(m_nodes[i].x, 2)
-            << doubleToStringX(m_nodes[i].y, 2)
-            << doubleToStringX(hypot(m_nodes[i].vx, m_nodes[i].vy), 3);
+            << doubleToStringX(m_nx[i], 2)
+            << doubleToStringX(m_ny[i], 2)
+            << doubleToStringX(hypot(m_nvx[i], m_nvy[i]), 3);
     }
     m_msgs << actab.getFormattedString();
   }
@@ -11,12 +11,7 @@
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include <vector>
 #include <cmath>
-
-struct CableNode {
-  double x, y, vx, vy;
-  CableNode() : x(0), y(0), vx(0), vy(0) {}
-  CableNode(double _x, double _y) : x(_x), y(_y), vx(0), vy(0) {}
-};
+#include "TowDynamics.h"
 
 class Cable : public AppCastingMOOSApp
 {
@@ -42,6 +37,7 @@ class Cable : public AppCastingMOOSApp
    double m_k_spring;
    double m_cd;
    double m_c_tan;
+   TowIntegrator m_integrator;
 
  private: // State variables
    double m_nav_x;
@@ -53,7 +49,10 @@ class Cable : public AppCastingMOOSApp
    bool   m_initialized;
    int    m_num_nodes;
    double m_rest_length;
-   std::vector<CableNode> m_nodes;
+   std::vector<double> m_nx;    // node positions, anchor first
+   std::vector<double> m_ny;
+   std::vector<double> m_nvx;   // node velocities
+   std::vector<double> m_nvy;
    double m_last_iterate_time;
 };
 
@@ -80,6 +80,7 @@ void showExampleConfigAndExit()
   blk("  k_spring       = 5.0   // spring constant                     ");
   blk("  cd             = 0.7   // quadratic drag coefficient          ");
   blk("  c_tan          = 2.0   // tangential damping coefficient      ");
+  blk("  integrator     = euler // euler, semi_implicit, rk2, rk4      ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
@@ -112,6 +113,7 @@ void showInterfaceAndExit()
   blk("  TOW_SPRING_STIFFNESS = 5.0                                    ");
   blk("  TOW_DRAG_COEFF       = 0.7                                    ");
   blk("  TOW_TAN_DAMPING      = 2.0                                    ");
+  blk("  TOW_INTEGRATOR       = euler                                  ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
@@ -13,6 +13,7 @@
 #include "ACTable.h"
 #include "TowObstacleMgr.h"
 #include "ConvexHullGenerator.h"
+#include "ConvexPolyDist.h"
 #include "XYFormatUtilsPoint.h"
 #include "XYFormatUtilsPoly.h"
 
@@ -83,7 +84,6 @@ TowObstacleMgr::TowObstacleMgr()
   m_towed_y = 0;
 
   m_use_tow_cable = true;
-  m_cable_sample_step = 1.0;
   m_attach_offset = 0.0;
   m_tow_pad = 0.0;
 
@@ -363,8 +363,14 @@ bool TowObstacleMgr::OnStartUp()
       handled = setBooleanOnString(m_use_tow, value);
     else if(param == "use_tow_cable")
       handled = setBooleanOnString(m_use_tow_cable, value);
-    else if(param == "cable_sample_step")
-      handled = setPosDoubleOnString(m_cable_sample_step, value);
+    else if(param == "cable_sample_step") {
+      // Cable ranges are exact segment distances now; still
+      // accepted so existing missions load, with a warning
+      double unused = 0;
+      handled = setPosDoubleOnString(unused, value);
+      if(handled)
+	reportConfigWarning("cable_sample_step is ignored: cable ranges are exact");
+    }
     else if(param == "attach_offset")
       handled = setNonNegDoubleOnString(m_attach_offset, value);
     else if(param == "tow_pad")
@@ -1407,7 +1413,6 @@ bool TowObstacleMgr::buildReport()
   m_msgs << "  tow_only:            " << boolToString(m_tow_only) << endl;
   m_msgs << "  use_tow_cable:       " << boolToString(m_use_tow_cable) << endl;
   m_msgs << "  attach_offset:       " << doubleToStringX(m_attach_offset,2) << endl;
-  m_msgs << "  cable_sample_step:   " << doubleToStringX(m_cable_sample_step,2) << endl;
   m_msgs << "  tow_pad:             " << doubleToStringX(m_tow_pad,2) << endl;
   m_msgs << "  repost_interval:     " << doubleToStringX(m_repost_interval,2) << endl;
   m_msgs << "  abaft_beam_thresh:   " << doubleToStringX(m_abaft_beam_thresh,1) << endl;
@@ -1494,7 +1499,10 @@ double TowObstacleMgr::distPointToPolySystem(const XYPolygon& poly,
                                              double& d_tow,
                                              double& d_cable) const
 {
-  d_nav = poly.dist_to_poly(m_nav_x, m_nav_y);
+  // Prepared edge tables, reused for every query point below
+  ConvexPolyDist pdist(poly);
+
+  d_nav = pdist.dist(m_nav_x, m_nav_y);
 
   d_tow   = 1e9;
   d_cable = 1e9;
@@ -1508,57 +1516,29 @@ double TowObstacleMgr::distPointToPolySystem(const XYPolygon& poly,
   }
 
   // Tow distance
-  d_tow = poly.dist_to_poly(m_towed_x, m_towed_y);
+  d_tow = pdist.dist(m_towed_x, m_towed_y);
 
-  // Cable distance: use actual node positions from pCable if available,
-  // otherwise fall back to straight-line sampling between nav and tow.
+  // Cable distance: exact distance to the segments between the
+  // actual node positions from pCable if available, otherwise to
+  // the straight line from anchor to tow.
   if(m_use_tow_cable) {
     d_cable = 1e9;
 
     if(m_cable_nodes_valid && m_cable_node_x.size() >= 2) {
-      // Use actual cable node positions from pCable
-      for(unsigned int i=0; i<m_cable_node_x.size(); i++) {
-        double di = poly.dist_to_poly(m_cable_node_x[i], m_cable_node_y[i]);
+      for(unsigned int i=0; i+1 < m_cable_node_x.size(); i++) {
+        double di = pdist.segDist(m_cable_node_x[i],   m_cable_node_y[i],
+                                  m_cable_node_x[i+1], m_cable_node_y[i+1]);
         if(di < d_cable)
           d_cable = di;
       }
-      // Also sample between adjacent nodes at cable_sample_step resolution
-      for(unsigned int i=0; i+1 < m_cable_node_x.size(); i++) {
-        double x1 = m_cable_node_x[i],   y1 = m_cable_node_y[i];
-        double x2 = m_cable_node_x[i+1], y2 = m_cable_node_y[i+1];
-        double seg_len = hypot(x2 - x1, y2 - y1);
-        unsigned int samples = 1;
-        if(m_cable_sample_step > 0.1)
-          samples = (unsigned int)ceil(seg_len / m_cable_sample_step);
-        for(unsigned int s=1; s<samples; s++) {
-          double t  = (double)s / (double)samples;
-          double xs = x1 + t*(x2-x1);
-          double ys = y1 + t*(y2-y1);
-          double di = poly.dist_to_poly(xs, ys);
-          if(di < d_cable)
-            d_cable = di;
-        }
-      }
     }
     else {
-      // Fallback: straight line from anchor to tow
       double hdg_rad = (90.0 - m_nav_hdg) * M_PI / 180.0;
       double x1 = m_nav_x - m_attach_offset * cos(hdg_rad);
       double y1 = m_nav_y - m_attach_offset * sin(hdg_rad);
-      double x2 = m_towed_x, y2 = m_towed_y;
-      double seg_len = hypot(x2 - x1, y2 - y1);
-      unsigned int samples = 1;
-      if(m_cable_sample_step > 0.1)
-        samples = (unsigned int)ceil(seg_len / m_cable_sample_step);
-      if(samples < 1) samples = 1;
-      for(unsigned int i=0; i<=samples; i++) {
-        double t  = (double)i / (double)samples;
-        double xs = x1 + t*(x2-x1);
-        double ys = y1 + t*(y2-y1);
-        double di = poly.dist_to_poly(xs, ys);
-        if(di < d_cable)
-          d_cable = di;
-      }
+      double di = pdist.segDist(x1, y1, m_towed_x, m_towed_y);
+      if(di < d_cable)
+        d_cable = di;
     }
   } else {
     d_cable = d_tow;
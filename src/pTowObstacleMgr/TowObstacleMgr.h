@@ -159,7 +159,6 @@ private: // State variables
 
   // Cable distance approximation
   bool   m_use_tow_cable;
-  double m_cable_sample_step;     // meters (e.g., 0.5 or 1.0)
   double m_attach_offset;         // meters aft of NAV for anchor point
 
   // Cable node positions from pCable
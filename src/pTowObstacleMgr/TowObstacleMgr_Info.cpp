@@ -112,7 +112,6 @@ void showExampleConfigAndExit()
   blk("  use_tow          = true     // default is true                ");
   blk("  tow_only         = true     // default is true                ");
   blk("  use_tow_cable    = true     // default is true                ");
-  blk("  cable_sample_step = 1.0     // (meters) default is 1.0        ");
   blk("  attach_offset    = 0.0      // (meters) default is 0.0        ");
   blk("  tow_pad          = 0.0      // (meters) default is 0.0        ");
   blk("  repost_interval  = 0.0      // (secs) default is 0.0 (off)    ");
@@ -41,6 +41,7 @@ Towing::Towing()
   m_spring_stiffness = 5.0; // spring stiffness constant 1/s^2
   m_cd = 0.7;               // lumped drag coefficient 1/m
   m_tan_damping = 2.0; // tangential damping constant 1/s
+  m_integrator = TOW_INT_EULER; // tow body integrator
   m_post_cable = true; // whether to post the cable position for visualization
 }
 
@@ -193,90 +194,21 @@ bool Towing::Iterate()
     double distance = hypot(dx, dy); // Current distance between anchor point and towed body
     m_cable_distance = distance; // pre-clamp distance (useful for detecting overshoot), stored for troubleshooting
 
-    if(distance > 0.01) //avoid division by zero
+    // Spring tension when overstretched, quadratic drag, damping of
+    // sideways motion, then the rigid cable clamp (lib_towdyn, the
+    // same model the obstacle behavior simulates). Within 1 cm of
+    // the anchor the cable direction is undefined and the tow body
+    // is held where it is, as pTowing always has.
+    if(distance > 0.01)
     {
-      double dx_dir = m_anchor_x - m_towed_x;
-      double dy_dir = m_anchor_y - m_towed_y;
-      double d_dir  = hypot(dx_dir, dy_dir);
-      if (d_dir < 1e-6)
-        d_dir = 1.0;
-
-      // unit vector along cable
-      double ux = dx_dir / d_dir;
-      double uy = dy_dir / d_dir;
-      // tangential unit vector
-      double nx = -uy;
-      double ny = ux;
-
-      // Soft tension term: adds an inward acceleration if cable is overstretched.
-      // Note: even with the rigid clamp below, this still affects velocity (dynamics).
-      // Disable this if you want a purely rigid/inextensible cable behavior.
-      if(distance > m_cable_length) 
-      {
-        double overshoot = distance - m_cable_length; //amount stretched beyond cable length
-        double k = m_spring_stiffness; // s^-2 (tuneable spring constant, higher = stiffer spring)
-        m_towed_vx += k * overshoot * ux * dt;
-        m_towed_vy += k * overshoot * uy * dt;
-      }
-
-      // --- Quadratic drag based on the tow speed ---
-      // This simulates the drag force proportional to the square of the speed
-      // Uses the towed body's speed to apply quadratic drag.
-
-      double speed = hypot(m_towed_vx, m_towed_vy);
-      if(speed > 1e-6) 
-      {
-        double CdA_over_m = m_cd; // 1/m  (tunable lumped drag coefficient)
-        m_towed_vx += -CdA_over_m * m_towed_vx * speed * dt;
-        m_towed_vy += -CdA_over_m * m_towed_vy * speed * dt;
-      }
-
-      // Extra tangential damping: damps sideways motion perpendicular to the cable direction (reduces swinging).
-      double vt = m_towed_vx*nx + m_towed_vy*ny;    // sideways
-      double c_tan = m_tan_damping; // 1/s  (tuneable)
-      m_towed_vx += (-c_tan * vt) * nx * dt;
-      m_towed_vy += (-c_tan * vt) * ny * dt;
-
-      // Integrate position
-      m_towed_x += m_towed_vx * dt;
-      m_towed_y += m_towed_vy * dt;
-
-      // --- Rigid cable clamp ---
-      // Forces the towed body to stay within the cable length
-
-      // vector from towed body to anchor
-      double sx = m_anchor_x - m_towed_x;
-      double sy = m_anchor_y - m_towed_y;
-
-      //actual distance between towed body and anchor
-      double dist_a = hypot(sx, sy);
-
-      if(dist_a > m_cable_length) 
-      {
-
-       //ratio to scale back the vector, <1 means towed body is too far
-       double sc = m_cable_length / dist_a;
-
-       // slide the towed body back to the cable length
-       m_towed_x = m_anchor_x - sx * sc;
-       m_towed_y = m_anchor_y - sy * sc;
-
-       // unit vector from towed body to anchor
-       double urx = sx / dist_a;
-       double ury = sy / dist_a;
-
-       // Radial velocity along unit vector (tow -> anchor). Positive = toward anchor, negative = outward.
-       // Note: This uses tow velocity in world frame; a more physical model would use (v_towed - v_anchor).
-       double vrad = m_towed_vx * urx + m_towed_vy * ury;
-      
-       // If vrad < 0, tow is moving outward (away from anchor), which would increase cable length.
-       if(vrad < 0) 
-       {
-        // Remove the outward radial component so velocity is tangential and/or inward only.
-        m_towed_vx -= vrad * urx;
-        m_towed_vy -= vrad * ury;
-       }
-      }
+      TowCableParams params;
+      params.k_spring     = m_spring_stiffness;
+      params.cd           = m_cd;
+      params.c_tan        = m_tan_damping;
+      params.rest_length  = m_cable_length;
+      params.cable_length = m_cable_length;
+      towAdvanceBody(m_integrator, params, m_anchor_x, m_anchor_y, dt,
+                     m_towed_x, m_towed_y, m_towed_vx, m_towed_vy);
     }
   }
 
@@ -404,6 +336,11 @@ bool Towing::OnStartUp()
       handled = true;
     }
 
+    else if(param == "integrator")
+    {
+      handled = towIntegratorFromString(tolower(value), m_integrator);
+    }
+
     else if(param == "post_cable")
     {
       handled = setBooleanOnString(m_post_cable, value);
@@ -418,6 +355,7 @@ bool Towing::OnStartUp()
     Notify("TOW_SPRING_STIFFNESS", m_spring_stiffness);
     Notify("TOW_DRAG_COEFF",      m_cd);
     Notify("TOW_TAN_DAMPING",     m_tan_damping);
+    Notify("TOW_INTEGRATOR",      towIntegratorName(m_integrator));
 
   }
   
@@ -463,6 +401,7 @@ bool Towing::buildReport()
   m_msgs << " TOW_VX: " << m_towed_vx << endl;
   m_msgs << " TOW_VY: " << m_towed_vy << endl;
   m_msgs << " ATTACH_OFFSET: " << m_attach_offset << endl;
+  m_msgs << " INTEGRATOR: " << towIntegratorName(m_integrator) << endl;
 
   return(true);
 }
@@ -10,6 +10,7 @@
 
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "XYSegList.h"
+#include "TowDynamics.h"
 
 class Towing : public AppCastingMOOSApp
 {
@@ -57,6 +58,7 @@ class Towing : public AppCastingMOOSApp
  double m_spring_stiffness; // spring stiffness constant
  double m_cd;               // drag coefficient
  double m_tan_damping; // tangential damping constant
+ TowIntegrator m_integrator; // euler, semi_implicit, rk2 or rk4
  bool m_post_cable;
 };
 
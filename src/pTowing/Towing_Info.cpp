@@ -82,6 +82,8 @@ void showExampleConfigAndExit()
   blk("  spring_stiffness    = 5.0   // (1/s^2)  default is 5.0        ");
   blk("  drag_coefficient    = 0.7   // (1/m)    default is 0.7        ");
   blk("  tangential_damping  = 2.0   // (1/s)    default is 2.0        ");
+  blk("  integrator          = euler // euler, semi_implicit, rk2, rk4 ");
+  blk("                              // default is euler               ");
   blk("  post_cable          = false // default is true                ");
   blk("}                                                               ");
   blk("                                                                ");
@@ -132,6 +134,7 @@ void showInterfaceAndExit()
   blk("  TOW_SPRING_STIFFNESS = 5.0                                    ");
   blk("  TOW_DRAG_COEFF       = 0.7                                    ");
   blk("  TOW_TAN_DAMPING      = 2.0                                    ");
+  blk("  TOW_INTEGRATOR       = euler                                  ");
   blk("                                                                ");
   blk("  VIEW_SEGLIST       = pts={103,-23.8:120.5,-30.2},             ");
   blk("                       label=TOW_LINE,edge_color=gray           ");